@@ -0,0 +1,344 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QThread>
+#include <functional>
+
+#include "stand_in_server.hpp"
+#include "models/animal_filter_dto.hpp"
+#include "services/animal_service.hpp"
+#include "services/auth_service.hpp"
+#include "services/breed_service.hpp"
+#include "services/city_service.hpp"
+#include "services/metrics_registry.hpp"
+#include "services/network_client.hpp"
+#include "services/organization_service.hpp"
+
+// Drives the real NetworkClient and services against the stand-in server and reports latency percentiles per
+// scenario. Every number includes the whole client path: scheduling, HTTP, JSON parsing and DTO construction.
+
+using namespace pawspective;  // NOLINT google-build-using-namespace
+
+namespace {
+
+constexpr int timeoutMs = 60000;
+
+struct Result {
+    QString name;
+    services::HdrHistogram microseconds;
+    quint64 requests = 0;
+    int failures = 0;
+};
+
+bool waitUntil(const std::function<bool()>& done) {
+    const QDeadlineTimer deadline(timeoutMs);
+    while (!done() && !deadline.hasExpired()) {
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents, 10);
+    }
+    return done();
+}
+
+class Benchmark {
+public:
+    Benchmark(bench::StandInServer& server, services::NetworkClient& client, int iterations)
+        : m_server(server),
+          m_iterations(iterations),
+          m_auth(client),
+          m_animals(client),
+          m_organizations(client),
+          m_breeds(client),
+          m_cities(client) {}
+
+    QList<Result> run() {
+        QList<Result> results;
+        results.append(startup());
+        results.append(animalListPages());
+        results.append(animalDetailFanOut(false));
+        results.append(animalDetailFanOut(true));
+        results.append(organizationSearch());
+        return results;
+    }
+
+private:
+    // Runs body once per iteration and records how long each run took until pending() dropped to zero.
+    Result measure(const QString& name, const std::function<void(int)>& body, const std::function<int()>& pending) {
+        Result result{name, {}, 0, 0};
+        const quint64 requestsBefore = m_server.requestCount();
+        for (int i = 0; i < m_iterations; ++i) {
+            QElapsedTimer timer;
+            timer.start();
+            body(i);
+            if (!waitUntil([&pending]() { return pending() <= 0; })) {
+                qWarning().noquote() << name << "timed out";
+                ++result.failures;
+                break;
+            }
+            result.microseconds.record(timer.nsecsElapsed() / 1000);
+        }
+        result.requests = m_server.requestCount() - requestsBefore;
+        return result;
+    }
+
+    Result startup() {
+        int pending = 0;
+        int failures = 0;
+        QObject context;
+        const auto done = [&pending]() { --pending; };
+        const auto failed = [&pending, &failures]() {
+            --pending;
+            ++failures;
+        };
+        QObject::connect(&m_auth, &services::AuthService::loginSuccess, &context, done);
+        QObject::connect(&m_auth, &services::AuthService::loginFailed, &context, failed);
+        QObject::connect(&m_cities, &services::CityService::getCitiesSuccess, &context, done);
+        QObject::connect(&m_cities, &services::CityService::getCitiesFailed, &context, failed);
+        QObject::connect(&m_breeds, &services::BreedService::getBreedsByTypeSuccess, &context, done);
+        QObject::connect(&m_breeds, &services::BreedService::getBreedsByTypeFailed, &context, failed);
+        QObject::connect(&m_animals, &services::AnimalService::getAnimalFiltersSuccess, &context, done);
+        QObject::connect(&m_animals, &services::AnimalService::getAnimalFiltersFailed, &context, failed);
+        QObject::connect(&m_animals, &services::AnimalService::getAnimalsSuccess, &context, done);
+        QObject::connect(&m_animals, &services::AnimalService::getAnimalsFailed, &context, failed);
+
+        Result result = measure(
+            "startup (login, cities, breeds, filters, first page)",
+            [this, &pending](int) {
+                pending = 7;
+                m_auth.login("bench@example.com", "password");
+                m_cities.getCities();
+                for (const auto type : {models::AnimalType::Dog, models::AnimalType::Cat, models::AnimalType::Other}) {
+                    m_breeds.getBreedsByType(type);
+                }
+                m_animals.getAnimalFilters();
+                m_animals.getAnimals(models::AnimalFilterDTO{});
+            },
+            [&pending]() { return pending; }
+        );
+        result.failures += failures;
+        return result;
+    }
+
+    Result animalListPages() {
+        int pending = 0;
+        int failures = 0;
+        QObject context;
+        QObject::connect(&m_animals, &services::AnimalService::getAnimalsSuccess, &context, [&pending]() {
+            --pending;
+        });
+        QObject::connect(&m_animals, &services::AnimalService::getAnimalsFailed, &context, [&]() {
+            --pending;
+            ++failures;
+        });
+
+        Result result = measure(
+            "animal list page (limit 20)",
+            [this, &pending](int iteration) {
+                pending = 1;
+                models::AnimalFilterDTO filter;
+                filter.page = 1 + iteration % qMax(1, m_server.config().animals / 20);
+                filter.limit = 20;
+                m_animals.getAnimals(filter);
+            },
+            [&pending]() { return pending; }
+        );
+        result.failures += failures;
+        return result;
+    }
+
+    Result animalDetailFanOut(bool batching) {
+        static constexpr int fanOut = 20;
+        int pending = 0;
+        int failures = 0;
+        QObject context;
+        QObject::connect(&m_animals, &services::AnimalService::getAnimalSuccess, &context, [&pending]() {
+            --pending;
+        });
+        QObject::connect(&m_animals, &services::AnimalService::getAnimalFailed, &context, [&]() {
+            --pending;
+            ++failures;
+        });
+        m_animals.setBatchingEnabled(batching);
+
+        Result result = measure(
+            QString("animal details x%1 (%2)").arg(fanOut).arg(batching ? "batched" : "one request each"),
+            [this, &pending](int iteration) {
+                pending = fanOut;
+                const int animals = qMax(1, m_server.config().animals);
+                for (int i = 0; i < fanOut; ++i) {
+                    m_animals.getAnimal(1 + (iteration * fanOut + i) % animals);
+                }
+            },
+            [&pending]() { return pending; }
+        );
+        m_animals.setBatchingEnabled(false);
+        result.failures += failures;
+        return result;
+    }
+
+    Result organizationSearch() {
+        int pending = 0;
+        int failures = 0;
+        QObject context;
+        QObject::connect(
+            &m_organizations,
+            &services::OrganizationService::findByNameContainingSuccess,
+            &context,
+            [&pending]() { --pending; }
+        );
+        QObject::connect(&m_organizations, &services::OrganizationService::findByNameContainingFailed, &context, [&]() {
+            --pending;
+            ++failures;
+        });
+
+        Result result = measure(
+            "organization search",
+            [this, &pending](int iteration) {
+                pending = 1;
+                m_organizations.findByNameContaining("Shelter", 1 + iteration % 3);
+            },
+            [&pending]() { return pending; }
+        );
+        result.failures += failures;
+        return result;
+    }
+
+    bench::StandInServer& m_server;
+    int m_iterations;
+    services::AuthService m_auth;
+    services::AnimalService m_animals;
+    services::OrganizationService m_organizations;
+    services::BreedService m_breeds;
+    services::CityService m_cities;
+};
+
+double toMs(qint64 microseconds) { return static_cast<double>(microseconds) / 1000.0; }
+
+QJsonObject toJson(const Result& result) {
+    return {
+        {"name", result.name},
+        {"runs", static_cast<qint64>(result.microseconds.count())},
+        {"p50Ms", toMs(result.microseconds.percentile(0.5))},
+        {"p90Ms", toMs(result.microseconds.percentile(0.9))},
+        {"p99Ms", toMs(result.microseconds.percentile(0.99))},
+        {"maxMs", toMs(result.microseconds.max())},
+        {"requests", static_cast<qint64>(result.requests)},
+        {"failures", result.failures}
+    };
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Client latency benchmark against the stand-in API server");
+    parser.addHelpOption();
+    const QCommandLineOption iterationsOption("iterations", "Runs per scenario (default 50).", "count", "50");
+    const QCommandLineOption latencyOption("latency", "Server latency in ms.", "ms", "20");
+    const QCommandLineOption jitterOption("jitter", "Random extra server latency up to this many ms.", "ms", "5");
+    const QCommandLineOption bandwidthOption("bandwidth", "Bytes per second per connection, 0 = none.", "bps", "0");
+    const QCommandLineOption errorRateOption("error-rate", "Fraction of API requests that fail.", "rate", "0");
+    const QCommandLineOption animalsOption("animals", "Number of animals on the server.", "count", "1000");
+    const QCommandLineOption jsonOption("json", "Also write the results to this file.", "file");
+    parser.addOptions(
+        {iterationsOption, latencyOption, jitterOption, bandwidthOption, errorRateOption, animalsOption, jsonOption}
+    );
+    parser.process(app);
+
+    bench::StandInServer::Config config;
+    config.latencyMs = parser.value(latencyOption).toInt();
+    config.latencyJitterMs = parser.value(jitterOption).toInt();
+    config.bytesPerSecond = parser.value(bandwidthOption).toLongLong();
+    config.errorRate = parser.value(errorRateOption).toDouble();
+    config.animals = parser.value(animalsOption).toInt();
+
+    // The server gets its own thread, so building responses does not count as client time.
+    QThread serverThread;
+    auto* server = new bench::StandInServer(config);
+    server->moveToThread(&serverThread);
+    QObject::connect(&serverThread, &QThread::finished, server, &QObject::deleteLater);
+    serverThread.start();
+    bool listening = false;
+    QMetaObject::invokeMethod(
+        server,
+        [server, &listening]() { listening = server->listen(); },
+        Qt::BlockingQueuedConnection
+    );
+    if (!listening) {
+        qCritical() << "Cannot start the stand-in server";
+        return 1;
+    }
+
+    QTemporaryDir cacheDir;
+    services::NetworkClient client;
+    client.setBaseUrl(server->baseUrl());
+    client.setCacheDirectory(cacheDir.path());
+    client.setSlowRequestThreshold(0);
+
+    const QList<Result> results = Benchmark(*server, client, qMax(1, parser.value(iterationsOption).toInt())).run();
+
+    QTextStream out(stdout);
+    out << QString("latency %1+%2 ms, bandwidth %3 B/s, error rate %4, %5 animals\n\n")
+               .arg(config.latencyMs)
+               .arg(config.latencyJitterMs)
+               .arg(config.bytesPerSecond)
+               .arg(config.errorRate)
+               .arg(config.animals);
+    out << QString("%1 %2 %3 %4 %5 %6 %7 %8\n")
+               .arg("scenario", -56)
+               .arg("runs", 5)
+               .arg("p50 ms", 9)
+               .arg("p90 ms", 9)
+               .arg("p99 ms", 9)
+               .arg("max ms", 9)
+               .arg("req/run", 8)
+               .arg("failed", 7);
+    QJsonArray scenarios;
+    bool failed = false;
+    for (const Result& result : results) {
+        const QJsonObject json = toJson(result);
+        scenarios.append(json);
+        failed = failed || result.failures > 0;
+        const int runs = qMax(1, json["runs"].toInt());
+        out << QString("%1 %2 %3 %4 %5 %6 %7 %8\n")
+                   .arg(result.name, -56)
+                   .arg(runs, 5)
+                   .arg(json["p50Ms"].toDouble(), 9, 'f', 2)
+                   .arg(json["p90Ms"].toDouble(), 9, 'f', 2)
+                   .arg(json["p99Ms"].toDouble(), 9, 'f', 2)
+                   .arg(json["maxMs"].toDouble(), 9, 'f', 2)
+                   .arg(static_cast<double>(result.requests) / runs, 8, 'f', 1)
+                   .arg(result.failures, 7);
+    }
+    out.flush();
+
+    if (parser.isSet(jsonOption)) {
+        QSaveFile file(parser.value(jsonOption));
+        if (file.open(QIODevice::WriteOnly)) {
+            const QJsonObject report{
+                {"config",
+                 QJsonObject{
+                     {"latencyMs", config.latencyMs},
+                     {"jitterMs", config.latencyJitterMs},
+                     {"bytesPerSecond", config.bytesPerSecond},
+                     {"errorRate", config.errorRate},
+                     {"animals", config.animals}
+                 }},
+                {"scenarios", scenarios}
+            };
+            file.write(QJsonDocument(report).toJson());
+            file.commit();
+        }
+    }
+
+    serverThread.quit();
+    serverThread.wait();
+    return failed && config.errorRate == 0 ? 1 : 0;
+}
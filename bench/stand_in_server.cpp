@@ -0,0 +1,596 @@
+#include "stand_in_server.hpp"
+
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPointer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QUrlQuery>
+#include <algorithm>
+
+#include "models/user_dto.hpp"
+
+namespace pawspective::bench {
+
+namespace {
+
+constexpr qsizetype maxHeaderSize = 64 * 1024;
+constexpr int throttleIntervalMs = 10;
+constexpr qint64 userId = 1;
+
+const QStringList animalNames = {"Rex", "Luna", "Milo", "Bella", "Max", "Nala", "Oscar", "Coco", "Simba", "Daisy"};
+
+template <typename Enum>
+Enum pick(QRandomGenerator& random, int count) {
+    return static_cast<Enum>(random.bounded(count));
+}
+
+QByteArray statusText(int status) {
+    switch (status) {
+        case 200:
+            return "OK";
+        case 201:
+            return "Created";
+        case 400:
+            return "Bad Request";
+        case 401:
+            return "Unauthorized";
+        case 404:
+            return "Not Found";
+        case 429:
+            return "Too Many Requests";
+        case 500:
+            return "Internal Server Error";
+        case 503:
+            return "Service Unavailable";
+        default:
+            return "Status";
+    }
+}
+
+QByteArray base64Url(const QByteArray& data) {
+    return data.toBase64(QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals);
+}
+
+std::optional<qint64> idSegment(const QStringList& segments, qsizetype index) {
+    bool ok = false;
+    const qint64 id = segments.value(index).toLongLong(&ok);
+    return ok ? std::optional<qint64>(id) : std::nullopt;
+}
+
+QList<qint64> idList(const QUrlQuery& query, const QString& key) {
+    QList<qint64> ids;
+    for (const QString& value : query.allQueryItemValues(key)) {
+        for (const QString& part : value.split(',', Qt::SkipEmptyParts)) {
+            ids.append(part.toLongLong());
+        }
+    }
+    return ids;
+}
+
+template <typename T>
+QJsonObject page(const QList<T>& items, int pageNumber, int limit) {
+    const qsizetype total = items.size();
+    const qsizetype first = std::min<qsizetype>(total, static_cast<qsizetype>(pageNumber - 1) * limit);
+    QJsonArray array;
+    for (qsizetype i = first; i < std::min<qsizetype>(total, first + limit); ++i) {
+        array.append(items.at(i).toJson());
+    }
+    return {
+        {"items", array},
+        {"page", pageNumber},
+        {"limit", limit},
+        {"total_count", total},
+        {"total_pages", (total + limit - 1) / limit}
+    };
+}
+
+}  // namespace
+
+StandInServer::StandInServer(const Config& config, QObject* parent)
+    : QObject(parent), m_config(config), m_server(new QTcpServer(this)) {
+    connect(m_server, &QTcpServer::newConnection, this, &StandInServer::acceptConnections);
+    generateData();
+}
+
+bool StandInServer::listen(quint16 port) { return m_server->listen(QHostAddress::LocalHost, port); }
+
+quint16 StandInServer::port() const { return m_server->serverPort(); }
+
+QUrl StandInServer::baseUrl() const { return QUrl(QString("http://127.0.0.1:%1/").arg(port())); }
+
+const StandInServer::Config& StandInServer::config() const { return m_config; }
+
+void StandInServer::setConfig(const Config& config) {
+    const bool regenerate = config.seed != m_config.seed || config.animals != m_config.animals ||
+                            config.organizations != m_config.organizations || config.cities != m_config.cities ||
+                            config.breedsPerType != m_config.breedsPerType;
+    m_config = config;
+    if (regenerate) {
+        generateData();
+    }
+}
+
+quint64 StandInServer::requestCount() const { return m_requestCount; }
+
+quint64 StandInServer::injectedErrorCount() const { return m_injectedErrors; }
+
+qint64 StandInServer::bytesSent() const { return m_bytesSent; }
+
+void StandInServer::generateData() {
+    m_random.seed(m_config.seed);
+    m_cities.clear();
+    m_breeds.clear();
+    m_organizations.clear();
+    m_animals.clear();
+    m_idempotentResponses.clear();
+
+    for (int i = 1; i <= qMax(1, m_config.cities); ++i) {
+        m_cities.append({i, QString("City %1").arg(i)});
+    }
+    for (const auto type : {models::AnimalType::Dog, models::AnimalType::Cat, models::AnimalType::Other}) {
+        for (int i = 1; i <= qMax(1, m_config.breedsPerType); ++i) {
+            const auto id = static_cast<qint64>(m_breeds.size() + 1);
+            m_breeds.append({id, type, QString("%1 breed %2").arg(models::toApiString(type)).arg(i)});
+        }
+    }
+    for (int i = 1; i <= qMax(1, m_config.organizations); ++i) {
+        models::OrganizationDTO organization;
+        organization.id = i;
+        organization.name = QString("Shelter %1").arg(i);
+        organization.description = QString("Animal shelter number %1, open every day.").arg(i);
+        organization.city = m_cities.at(m_random.bounded(static_cast<int>(m_cities.size())));
+        m_organizations.append(organization);
+    }
+    for (int i = 1; i <= qMax(1, m_config.animals); ++i) {
+        models::AnimalDTO animal;
+        animal.id = i;
+        animal.organizationId = m_organizations.at(m_random.bounded(static_cast<int>(m_organizations.size()))).id;
+        const QString& name = animalNames.at(m_random.bounded(static_cast<int>(animalNames.size())));
+        animal.name = QString("%1 %2").arg(name).arg(i);
+        animal.breed = m_breeds.at(m_random.bounded(static_cast<int>(m_breeds.size())));
+        animal.size = pick<models::AnimalSize>(m_random, 3);
+        animal.gender = pick<models::AnimalGender>(m_random, 3);
+        animal.careLevel = pick<models::CareLevel>(m_random, 4);
+        animal.color = pick<models::AnimalColor>(m_random, 12);
+        animal.goodWith = pick<models::GoodWith>(m_random, 4);
+        animal.age = m_random.bounded(20);
+        animal.status = pick<models::AnimalStatus>(m_random, 3);
+        if (m_random.bounded(4) != 0) {
+            animal.description = QString("%1 is a friendly %2 looking for a home. ")
+                                     .arg(animal.name, animal.breed.name)
+                                     .repeated(1 + m_random.bounded(4));
+        }
+        m_animals.append(animal);
+    }
+}
+
+void StandInServer::acceptConnections() {
+    while (QTcpSocket* socket = m_server->nextPendingConnection()) {
+        m_connections.insert(socket, {});
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { readRequests(socket); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_connections.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void StandInServer::readRequests(QTcpSocket* socket) {
+    const auto connection = m_connections.find(socket);
+    if (connection == m_connections.end()) {
+        return;
+    }
+    connection->buffer += socket->readAll();
+    // One request at a time per connection, like QNetworkAccessManager sends them.
+    if (connection->busy) {
+        return;
+    }
+
+    const qsizetype headerEnd = connection->buffer.indexOf("\r\n\r\n");
+    if (headerEnd < 0) {
+        if (connection->buffer.size() > maxHeaderSize) {
+            socket->abort();
+        }
+        return;
+    }
+    const QList<QByteArray> lines = connection->buffer.left(headerEnd).split('\n');
+    const QList<QByteArray> requestLine = lines.value(0).trimmed().split(' ');
+    Request request;
+    for (qsizetype i = 1; i < lines.size(); ++i) {
+        const qsizetype colon = lines.at(i).indexOf(':');
+        if (colon > 0) {
+            request.headers.insert(lines.at(i).left(colon).trimmed().toLower(), lines.at(i).mid(colon + 1).trimmed());
+        }
+    }
+    const qint64 contentLength = request.headers.value("content-length").toLongLong();
+    if (connection->buffer.size() < headerEnd + 4 + contentLength) {
+        return;
+    }
+    request.method = requestLine.value(0);
+    request.url = QUrl::fromEncoded(requestLine.value(1));
+    request.body = connection->buffer.mid(headerEnd + 4, contentLength);
+    connection->buffer.remove(0, headerEnd + 4 + contentLength);
+    connection->busy = true;
+
+    const bool keepAlive = request.headers.value("connection").toLower() != "close";
+    const Response response = handle(request);
+    QTimer::singleShot(nextLatencyMs(), socket, [this, socket, response, keepAlive]() {
+        writeResponse(socket, response, keepAlive);
+    });
+}
+
+void StandInServer::writeResponse(QTcpSocket* socket, const Response& response, bool keepAlive) {
+    QByteArray head = "HTTP/1.1 " + QByteArray::number(response.status) + ' ' + statusText(response.status) + "\r\n";
+    head += "Content-Type: application/json\r\nCache-Control: no-store\r\n";
+    for (const auto& [name, value] : response.headers) {
+        head += name + ": " + value + "\r\n";
+    }
+    head += "Content-Length: " + QByteArray::number(response.body.size()) + "\r\n";
+    head += keepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+    m_bytesSent += head.size() + response.body.size();
+
+    if (m_config.bytesPerSecond <= 0) {
+        socket->write(head + response.body);
+        finishResponse(socket, keepAlive);
+        return;
+    }
+
+    // Throttled: the body goes out in slices every few milliseconds.
+    socket->write(head);
+    const qint64 slice = qMax<qint64>(1, m_config.bytesPerSecond * throttleIntervalMs / 1000);
+    auto* timer = new QTimer(socket);
+    auto offset = std::make_shared<qint64>(0);
+    connect(timer, &QTimer::timeout, socket, [this, socket, timer, offset, slice, body = response.body, keepAlive]() {
+        socket->write(body.mid(*offset, slice));
+        *offset += slice;
+        if (*offset >= body.size()) {
+            timer->deleteLater();
+            finishResponse(socket, keepAlive);
+        }
+    });
+    timer->start(throttleIntervalMs);
+}
+
+void StandInServer::finishResponse(QTcpSocket* socket, bool keepAlive) {
+    if (!keepAlive) {
+        socket->disconnectFromHost();
+        return;
+    }
+    if (const auto connection = m_connections.find(socket); connection != m_connections.end()) {
+        connection->busy = false;
+        if (!connection->buffer.isEmpty()) {
+            readRequests(socket);
+        }
+    }
+}
+
+int StandInServer::nextLatencyMs() {
+    const int jitter = m_config.latencyJitterMs > 0 ? m_random.bounded(m_config.latencyJitterMs + 1) : 0;
+    return qMax(0, m_config.latencyMs) + jitter;
+}
+
+StandInServer::Response StandInServer::handle(const Request& request) {
+    ++m_requestCount;
+    const QString path = request.url.path();
+    Response response;
+
+    const QByteArray idempotencyKey = request.headers.value("idempotency-key");
+    if (!idempotencyKey.isEmpty() && m_idempotentResponses.contains(idempotencyKey)) {
+        response = m_idempotentResponses.value(idempotencyKey);
+    } else if (!path.startsWith("/auth/") && m_config.errorRate > 0 &&
+               m_random.generateDouble() < m_config.errorRate) {
+        ++m_injectedErrors;
+        response = error(m_config.errorStatus, "INJECTED", "Injected failure");
+    } else if (m_config.requireAuth && !path.startsWith("/auth/login") && !path.startsWith("/auth/refresh") &&
+               !isAuthorized(request)) {
+        response = error(401, "ACCESS_TOKEN_EXPIRED", "Access token expired");
+    } else {
+        response = route(request);
+        if (!idempotencyKey.isEmpty() && response.status < 500) {
+            m_idempotentResponses.insert(idempotencyKey, response);
+        }
+    }
+
+    emit requestServed(request.method, path, response.status);
+    return response;
+}
+
+StandInServer::Response StandInServer::route(const Request& request) {
+    const QStringList segments = request.url.path().split('/', Qt::SkipEmptyParts);
+    const QByteArray& method = request.method;
+    const QString root = segments.value(0);
+
+    if (root == "auth") {
+        const QString action = segments.value(1);
+        if (method == "POST" && (action == "login" || action == "refresh")) {
+            return login();
+        }
+        if (method == "POST" && action == "logout") {
+            return json(200, QJsonObject());
+        }
+        if (method == "GET" && action == "me") {
+            return currentUser();
+        }
+    } else if (root == "animals") {
+        if (segments.size() == 1) {
+            if (method == "GET") {
+                return listAnimals(request.url, std::nullopt);
+            }
+            if (method == "POST") {
+                return saveAnimal(std::nullopt, request.body);
+            }
+        } else if (segments.size() == 2 && segments.at(1) == "filters" && method == "GET") {
+            return animalFilters();
+        } else if (const auto id = idSegment(segments, 1); id && segments.size() == 2) {
+            if (method == "GET") {
+                return animal(*id);
+            }
+            if (method == "PUT" || method == "PATCH") {
+                return saveAnimal(id, request.body);
+            }
+        }
+    } else if (root == "orgs") {
+        const auto id = idSegment(segments, 1);
+        if (segments.size() == 1 && method == "GET") {
+            return listOrganizations(request.url);
+        }
+        if (id && segments.size() == 2 && method == "GET") {
+            return organization(*id);
+        }
+        if (id && segments.size() == 2 && (method == "PUT" || method == "PATCH")) {
+            return saveOrganization(*id, request.body);
+        }
+        if (id && segments.size() == 3 && segments.at(2) == "animals" && method == "GET") {
+            return listAnimals(request.url, id);
+        }
+    } else if (root == "breeds" && segments.size() == 1 && method == "GET") {
+        return breeds(request.url);
+    } else if (root == "city" && segments.size() == 1 && method == "GET") {
+        return cities();
+    }
+    return error(404, "NOT_FOUND", QString("No route for %1 %2").arg(method, request.url.path()));
+}
+
+StandInServer::Response StandInServer::login() {
+    return json(
+        200,
+        QJsonObject{
+            {"access_token", QString::fromLatin1(issueToken("access"))},
+            {"refresh_token", QString::fromLatin1(issueToken("refresh"))},
+            {"token_type", "Bearer"}
+        }
+    );
+}
+
+StandInServer::Response StandInServer::currentUser() const {
+    models::UserDTO user;
+    user.id = userId;
+    user.email = "bench@example.com";
+    user.firstName = "Bench";
+    user.lastName = "User";
+    user.organizationId = m_organizations.constFirst().id;
+    return json(200, user.toJson());
+}
+
+StandInServer::Response StandInServer::listAnimals(const QUrl& url, std::optional<qint64> organizationId) const {
+    const QUrlQuery query(url);
+    if (query.hasQueryItem("ids")) {
+        QJsonArray found;
+        for (qint64 id : idList(query, "ids")) {
+            if (id >= 1 && id <= m_animals.size()) {
+                found.append(m_animals.at(id - 1).toJson());
+            }
+        }
+        return json(200, found);
+    }
+
+    const auto matches = [&query](const QString& key, const QString& value) {
+        const QStringList wanted = query.allQueryItemValues(key);
+        return wanted.isEmpty() || wanted.contains(value);
+    };
+    const QList<qint64> breedIds = idList(query, "breeds");
+    const QList<qint64> cityIds = idList(query, "city_ids");
+    bool hasAgeLte = false;
+    bool hasAgeGte = false;
+    const int ageLte = query.queryItemValue("age_lte").toInt(&hasAgeLte);
+    const int ageGte = query.queryItemValue("age_gte").toInt(&hasAgeGte);
+
+    QList<models::AnimalDTO> selected;
+    for (const auto& animal : m_animals) {
+        const qint64 cityId = m_organizations.at(animal.organizationId - 1).city.id;
+        if ((organizationId && animal.organizationId != *organizationId) ||
+            (!breedIds.isEmpty() && !breedIds.contains(animal.breed.id)) ||
+            (!cityIds.isEmpty() && !cityIds.contains(cityId)) ||
+            !matches("animal_types", models::toApiString(animal.breed.animalType)) ||
+            !matches("sizes", models::toApiString(animal.size)) ||
+            !matches("genders", models::toApiString(animal.gender)) ||
+            !matches("care_levels", models::toApiString(animal.careLevel)) ||
+            !matches("colors", models::toApiString(animal.color)) ||
+            !matches("good_withs", models::toApiString(animal.goodWith)) || (hasAgeLte && animal.age > ageLte) ||
+            (hasAgeGte && animal.age < ageGte)) {
+            continue;
+        }
+        selected.append(animal);
+    }
+    const int pageNumber = qMax(1, query.queryItemValue("page").toInt());
+    const int limit = std::clamp(query.hasQueryItem("limit") ? query.queryItemValue("limit").toInt() : 10, 1, 100);
+    return json(200, page(selected, pageNumber, limit));
+}
+
+StandInServer::Response StandInServer::animal(qint64 id) const {
+    if (id < 1 || id > m_animals.size()) {
+        return error(404, "ANIMAL_NOT_FOUND", QString("Animal %1 not found").arg(id));
+    }
+    return json(200, m_animals.at(id - 1).toJson());
+}
+
+StandInServer::Response StandInServer::animalFilters() const {
+    const auto ids = [](const auto& items) {
+        QJsonArray array;
+        for (const auto& item : items) {
+            array.append(item.id);
+        }
+        return array;
+    };
+    const auto names = [](int count, auto enumValue) {
+        QJsonArray array;
+        for (int i = 0; i < count; ++i) {
+            array.append(models::toApiString(static_cast<decltype(enumValue)>(i)));
+        }
+        return array;
+    };
+    return json(
+        200,
+        QJsonObject{
+            {"breeds", ids(m_breeds)},
+            {"cityIds", ids(m_cities)},
+            {"animalTypes", names(3, models::AnimalType{})},
+            {"sizes", names(3, models::AnimalSize{})},
+            {"genders", names(3, models::AnimalGender{})},
+            {"careLevels", names(4, models::CareLevel{})},
+            {"colors", names(12, models::AnimalColor{})},
+            {"goodWiths", names(4, models::GoodWith{})},
+            {"age_lte", 20},
+            {"age_gte", 0}
+        }
+    );
+}
+
+StandInServer::Response StandInServer::saveAnimal(std::optional<qint64> id, const QByteArray& body) {
+    const QJsonObject fields = QJsonDocument::fromJson(body).object();
+    if (id && (*id < 1 || *id > m_animals.size())) {
+        return error(404, "ANIMAL_NOT_FOUND", QString("Animal %1 not found").arg(*id));
+    }
+    const bool isNew = !id.has_value();
+    if (isNew) {
+        models::AnimalDTO created = m_animals.value(0);
+        created.id = m_animals.size() + 1;
+        if (const qint64 organizationId = fields["organization_id"].toInteger();
+            organizationId >= 1 && organizationId <= m_organizations.size()) {
+            created.organizationId = organizationId;
+        }
+        m_animals.append(created);
+        id = created.id;
+    }
+
+    models::AnimalDTO& animal = m_animals[*id - 1];
+    animal.name = fields["name"].toString(animal.name);
+    animal.age = fields["age"].toInt(animal.age);
+    if (const qint64 breedId = fields["breed_id"].toInteger(); breedId >= 1 && breedId <= m_breeds.size()) {
+        animal.breed = m_breeds.at(breedId - 1);
+    }
+    if (fields.contains("description")) {
+        animal.description = fields["description"].toString();
+    }
+    return json(isNew ? 201 : 200, animal.toJson());
+}
+
+StandInServer::Response StandInServer::listOrganizations(const QUrl& url) const {
+    const QUrlQuery query(url);
+    if (query.hasQueryItem("ids")) {
+        QJsonArray found;
+        for (qint64 id : idList(query, "ids")) {
+            if (id >= 1 && id <= m_organizations.size()) {
+                found.append(m_organizations.at(id - 1).toJson());
+            }
+        }
+        return json(200, found);
+    }
+
+    const QString name = query.queryItemValue("name", QUrl::FullyDecoded);
+    QList<models::OrganizationDTO> selected;
+    std::copy_if(
+        m_organizations.cbegin(),
+        m_organizations.cend(),
+        std::back_inserter(selected),
+        [&name](const models::OrganizationDTO& organization) {
+            return organization.name.contains(name, Qt::CaseInsensitive);
+        }
+    );
+    const int pageNumber = qMax(1, query.queryItemValue("page").toInt());
+    const int limit = std::clamp(query.hasQueryItem("limit") ? query.queryItemValue("limit").toInt() : 10, 1, 100);
+    return json(200, page(selected, pageNumber, limit));
+}
+
+StandInServer::Response StandInServer::organization(qint64 id) const {
+    if (id < 1 || id > m_organizations.size()) {
+        return error(404, "ORGANIZATION_NOT_FOUND", QString("Organization %1 not found").arg(id));
+    }
+    return json(200, m_organizations.at(id - 1).toJson());
+}
+
+StandInServer::Response StandInServer::saveOrganization(qint64 id, const QByteArray& body) {
+    if (id < 1 || id > m_organizations.size()) {
+        return error(404, "ORGANIZATION_NOT_FOUND", QString("Organization %1 not found").arg(id));
+    }
+    const QJsonObject fields = QJsonDocument::fromJson(body).object();
+    models::OrganizationDTO& organization = m_organizations[id - 1];
+    organization.name = fields["name"].toString(organization.name);
+    if (fields.contains("description")) {
+        organization.description = fields["description"].toString();
+    }
+    if (const qint64 cityId = fields["city_id"].toInteger(); cityId >= 1 && cityId <= m_cities.size()) {
+        organization.city = m_cities.at(cityId - 1);
+    }
+    return json(200, organization.toJson());
+}
+
+StandInServer::Response StandInServer::breeds(const QUrl& url) const {
+    const QString type = QUrlQuery(url).queryItemValue("type");
+    QJsonArray array;
+    for (const auto& breed : m_breeds) {
+        if (type.isEmpty() || models::toApiString(breed.animalType) == type) {
+            array.append(breed.toJson());
+        }
+    }
+    return json(200, array);
+}
+
+StandInServer::Response StandInServer::cities() const {
+    QJsonArray array;
+    for (const auto& city : m_cities) {
+        array.append(city.toJson());
+    }
+    return json(200, array);
+}
+
+bool StandInServer::isAuthorized(const Request& request) const {
+    const QByteArray authorization = request.headers.value("authorization");
+    if (!authorization.startsWith("Bearer ")) {
+        return false;
+    }
+    const QByteArray payload = authorization.mid(7).split('.').value(1);
+    const QJsonObject claims =
+        QJsonDocument::fromJson(QByteArray::fromBase64(payload, QByteArray::Base64UrlEncoding)).object();
+    return claims["typ"].toString() == "access" && claims["exp"].toInteger() > QDateTime::currentSecsSinceEpoch();
+}
+
+QByteArray StandInServer::issueToken(const char* kind) const {
+    // Unsigned JWTs: the client only reads the claims.
+    const QJsonObject header{{"alg", "none"}, {"typ", "JWT"}};
+    const QJsonObject claims{
+        {"sub", QString::number(userId)},
+        {"typ", QString::fromLatin1(kind)},
+        {"exp", QDateTime::currentSecsSinceEpoch() + m_config.tokenLifetimeSeconds}
+    };
+    return base64Url(QJsonDocument(header).toJson(QJsonDocument::Compact)) + '.' +
+           base64Url(QJsonDocument(claims).toJson(QJsonDocument::Compact)) + ".stand-in";
+}
+
+StandInServer::Response StandInServer::json(int status, const QJsonValue& body) {
+    const QJsonDocument doc = body.isArray() ? QJsonDocument(body.toArray()) : QJsonDocument(body.toObject());
+    return {status, doc.toJson(QJsonDocument::Compact), {}};
+}
+
+StandInServer::Response StandInServer::error(int status, const QString& code, const QString& message) {
+    Response response = json(status, QJsonObject{{"error", QJsonObject{{"code", code}, {"message", message}}}});
+    if (status == 429) {
+        response.headers.append({"Retry-After", "1"});
+    }
+    return response;
+}
+
+}  // namespace pawspective::bench
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonValue>
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QRandomGenerator>
+#include <QTcpServer>
+#include <QUrl>
+#include <atomic>
+#include <optional>
+
+#include "models/animal_dto.hpp"
+#include "models/breed_dto.hpp"
+#include "models/city_dto.hpp"
+#include "models/organization_dto.hpp"
+
+namespace pawspective::bench {
+
+// A small HTTP/1.1 server that implements the parts of the API the client talks to, on generated data. Latency,
+// bandwidth, failures and the size of the data set are configurable, so the real NetworkClient and services can be
+// measured against a server whose behaviour is known. Covered: /auth/*, /animals, /animals/{id}, /animals/filters,
+// /orgs, /orgs/{id}, /orgs/{id}/animals, /breeds and /city.
+class StandInServer : public QObject {
+    Q_OBJECT
+public:
+    struct Config {
+        int latencyMs = 0;          // before the first response byte
+        int latencyJitterMs = 0;    // uniformly distributed on top of latencyMs
+        qint64 bytesPerSecond = 0;  // response throughput per connection; 0 is unlimited
+        double errorRate = 0;       // fraction of requests outside /auth answered with errorStatus
+        int errorStatus = 503;
+        int animals = 1000;
+        int organizations = 50;
+        int cities = 20;
+        int breedsPerType = 15;
+        int tokenLifetimeSeconds = 3600;
+        bool requireAuth = false;  // reject requests outside /auth without a valid, unexpired token
+        quint32 seed = 1;
+    };
+
+    struct Request {
+        QByteArray method;
+        QUrl url;
+        QHash<QByteArray, QByteArray> headers;  // lower-case names
+        QByteArray body;
+    };
+
+    struct Response {
+        int status = 200;
+        QByteArray body;
+        QList<QPair<QByteArray, QByteArray>> headers;
+    };
+
+    explicit StandInServer(const Config& config = {}, QObject* parent = nullptr);
+
+    // Binds to 127.0.0.1; 0 picks a free port.
+    bool listen(quint16 port = 0);
+    quint16 port() const;
+    QUrl baseUrl() const;
+
+    const Config& config() const;
+    // Latency, bandwidth and error settings apply to the next request; a new seed or size regenerates the data.
+    void setConfig(const Config& config);
+
+    quint64 requestCount() const;
+    quint64 injectedErrorCount() const;
+    qint64 bytesSent() const;
+
+    // Answers a request without going through the socket; the HTTP layer calls this for every request it parses.
+    Response handle(const Request& request);
+
+signals:
+    void requestServed(const QByteArray& method, const QString& path, int status);
+
+private:
+    struct Connection {
+        QByteArray buffer;
+        bool busy = false;
+    };
+
+    void generateData();
+    void acceptConnections();
+    void readRequests(QTcpSocket* socket);
+    void writeResponse(QTcpSocket* socket, const Response& response, bool keepAlive);
+    void finishResponse(QTcpSocket* socket, bool keepAlive);
+    int nextLatencyMs();
+
+    Response route(const Request& request);
+    Response login();
+    Response currentUser() const;
+    Response listAnimals(const QUrl& url, std::optional<qint64> organizationId) const;
+    Response animal(qint64 id) const;
+    Response animalFilters() const;
+    Response saveAnimal(std::optional<qint64> id, const QByteArray& body);
+    Response listOrganizations(const QUrl& url) const;
+    Response organization(qint64 id) const;
+    Response saveOrganization(qint64 id, const QByteArray& body);
+    Response breeds(const QUrl& url) const;
+    Response cities() const;
+    bool isAuthorized(const Request& request) const;
+    QByteArray issueToken(const char* kind) const;
+
+    static Response json(int status, const QJsonValue& body);
+    static Response error(int status, const QString& code, const QString& message);
+
+    Config m_config;
+    QTcpServer* m_server;
+    QHash<QTcpSocket*, Connection> m_connections;
+    QRandomGenerator m_random;
+    std::atomic<quint64> m_requestCount = 0;
+    std::atomic<quint64> m_injectedErrors = 0;
+    std::atomic<qint64> m_bytesSent = 0;
+
+    QList<models::CityDTO> m_cities;
+    QList<models::BreedDTO> m_breeds;
+    QList<models::OrganizationDTO> m_organizations;
+    QList<models::AnimalDTO> m_animals;
+    QHash<QByteArray, Response> m_idempotentResponses;
+};
+
+}  // namespace pawspective::bench
@@ -0,0 +1,56 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+
+#include "stand_in_server.hpp"
+
+// Runs the stand-in API on its own, e.g. to point the client at it with PAWSPECTIVE_API_URL.
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Stand-in pawspective API server with configurable latency and failures");
+    parser.addHelpOption();
+    const QCommandLineOption portOption("port", "Port on 127.0.0.1 (default 8080).", "port", "8080");
+    const QCommandLineOption latencyOption("latency", "Milliseconds before each response.", "ms", "0");
+    const QCommandLineOption jitterOption("jitter", "Random extra latency up to this many ms.", "ms", "0");
+    const QCommandLineOption bandwidthOption("bandwidth", "Bytes per second per connection, 0 = none.", "bps", "0");
+    const QCommandLineOption errorRateOption("error-rate", "Fraction of API requests that fail.", "rate", "0");
+    const QCommandLineOption errorStatusOption("error-status", "HTTP status of injected failures.", "status", "503");
+    const QCommandLineOption animalsOption("animals", "Number of animals.", "count", "1000");
+    const QCommandLineOption organizationsOption("organizations", "Number of organizations.", "count", "50");
+    const QCommandLineOption tokenLifetimeOption("token-lifetime", "Access token lifetime in seconds.", "s", "3600");
+    const QCommandLineOption requireAuthOption("require-auth", "Reject API requests without a valid token.");
+    parser.addOptions(
+        {portOption,
+         latencyOption,
+         jitterOption,
+         bandwidthOption,
+         errorRateOption,
+         errorStatusOption,
+         animalsOption,
+         organizationsOption,
+         tokenLifetimeOption,
+         requireAuthOption}
+    );
+    parser.process(app);
+
+    pawspective::bench::StandInServer::Config config;
+    config.latencyMs = parser.value(latencyOption).toInt();
+    config.latencyJitterMs = parser.value(jitterOption).toInt();
+    config.bytesPerSecond = parser.value(bandwidthOption).toLongLong();
+    config.errorRate = parser.value(errorRateOption).toDouble();
+    config.errorStatus = parser.value(errorStatusOption).toInt();
+    config.animals = parser.value(animalsOption).toInt();
+    config.organizations = parser.value(organizationsOption).toInt();
+    config.tokenLifetimeSeconds = parser.value(tokenLifetimeOption).toInt();
+    config.requireAuth = parser.isSet(requireAuthOption);
+
+    pawspective::bench::StandInServer server(config);
+    if (!server.listen(static_cast<quint16>(parser.value(portOption).toUInt()))) {
+        qCritical() << "Cannot listen on port" << parser.value(portOption);
+        return 1;
+    }
+    qInfo().noquote() << "Serving" << config.animals << "animals on" << server.baseUrl().toString();
+    return QCoreApplication::exec();
+}
@@ -8,6 +8,9 @@
 
 #include "animal_enums.hpp"
 #include "breed_dto.hpp"
+#include "shared_dto.hpp"
+#include "utils/decode_error.hpp"
+#include "utils/json_reader.hpp"
 
 namespace pawspective::models {
 
@@ -27,6 +30,9 @@ struct AnimalDTO {
 
     QJsonObject toJson() const;
     static AnimalDTO fromJson(const QJsonObject& json);
+    static AnimalDTO fromJson(utils::json::JsonReader& reader);
+    static utils::json::Decoded<AnimalDTO> tryFromJson(const QJsonObject& json);
+    static utils::json::Decoded<AnimalDTO> tryFromJson(utils::json::JsonReader& reader);
 };
 
 struct AnimalListDTO {
@@ -35,10 +41,22 @@ struct AnimalListDTO {
     int limit{};
     qint64 totalCount{};
     qint64 totalPages{};
+    // Items that failed to decode, with their paths; they are left out of items instead of failing the page.
+    QList<utils::json::DecodeError> rejectedItems;
 
+    QJsonObject toJson() const;
     static AnimalListDTO fromJson(const QJsonObject& json);
+    // Decodes the page straight from the response bytes, without building a QJsonDocument.
+    static AnimalListDTO fromJson(utils::json::JsonReader& reader);
+    static utils::json::Decoded<AnimalListDTO> tryFromJson(const QJsonObject& json);
+    static utils::json::Decoded<AnimalListDTO> tryFromJson(utils::json::JsonReader& reader);
 };
 
+using SharedAnimal = Shared<AnimalDTO>;
+using SharedAnimalList = Shared<AnimalListDTO>;
+
 }  // namespace pawspective::models
 
 Q_DECLARE_METATYPE(pawspective::models::AnimalListDTO)
+Q_DECLARE_METATYPE(pawspective::models::SharedAnimal)
+Q_DECLARE_METATYPE(pawspective::models::SharedAnimalList)
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <QString>
+#include <array>
 #include <cstdint>
+#include <string_view>
+
+#include "utils/enum_table.hpp"
 
 namespace pawspective::models {
 
@@ -32,6 +36,9 @@ enum class AnimalStatus : std::uint8_t { Available, Adopted, Unavailable };
 
 enum class AnimalType : std::uint8_t { Dog, Cat, Other };
 
+// The functions below are thin wrappers over the EnumTable specialisations at the end of this header; use
+// utils::enumFromInput for values typed by users or picked in filters.
+
 QString toApiString(AnimalSize value);
 QString toApiString(AnimalGender value);
 QString toApiString(CareLevel value);
@@ -49,3 +56,118 @@ AnimalStatus animalStatusFromApi(const QString& value);
 AnimalType animalTypeFromApi(const QString& value);
 
 }  // namespace pawspective::models
+
+namespace pawspective::utils {
+
+template <>
+struct EnumTable<models::AnimalSize> {
+    using E = models::AnimalSize;
+    static constexpr std::string_view name = "AnimalSize";
+    static constexpr std::array<EnumEntry<E>, 3> entries{{
+        {E::Small, "small", "Small"},
+        {E::Medium, "medium", "Medium"},
+        {E::Large, "large", "Large"},
+    }};
+    static constexpr std::array<EnumAlias<E>, 3> aliases{{
+        {"xlarge", E::Large},
+        {"x_large", E::Large},
+        {"extra_large", E::Large},
+    }};
+};
+
+template <>
+struct EnumTable<models::AnimalGender> {
+    using E = models::AnimalGender;
+    static constexpr std::string_view name = "AnimalGender";
+    static constexpr std::array<EnumEntry<E>, 3> entries{{
+        {E::Male, "male", "Male"},
+        {E::Female, "female", "Female"},
+        {E::Unknown, "unknown", "Unknown"},
+    }};
+    static constexpr std::array<EnumAlias<E>, 0> aliases{};
+};
+
+template <>
+struct EnumTable<models::CareLevel> {
+    using E = models::CareLevel;
+    static constexpr std::string_view name = "CareLevel";
+    static constexpr std::array<EnumEntry<E>, 4> entries{{
+        {E::Easy, "easy", "Easy"},
+        {E::Moderate, "moderate", "Moderate"},
+        {E::Difficult, "difficult", "Difficult"},
+        {E::SpecialNeeds, "special_needs", "Special Needs"},
+    }};
+    static constexpr std::array<EnumAlias<E>, 3> aliases{{
+        {"low", E::Easy},
+        {"medium", E::Moderate},
+        {"high", E::Difficult},
+    }};
+};
+
+template <>
+struct EnumTable<models::GoodWith> {
+    using E = models::GoodWith;
+    static constexpr std::string_view name = "GoodWith";
+    static constexpr std::array<EnumEntry<E>, 4> entries{{
+        {E::Dogs, "dogs", "Dogs"},
+        {E::Cats, "cats", "Cats"},
+        {E::Children, "children", "Children"},
+        {E::Elderly, "elderly", "Elderly"},
+    }};
+    static constexpr std::array<EnumAlias<E>, 1> aliases{{
+        {"kids", E::Children},
+    }};
+};
+
+template <>
+struct EnumTable<models::AnimalColor> {
+    using E = models::AnimalColor;
+    static constexpr std::string_view name = "AnimalColor";
+    static constexpr std::array<EnumEntry<E>, 12> entries{{
+        {E::Black, "black", "Black"},
+        {E::White, "white", "White"},
+        {E::Brown, "brown", "Brown"},
+        {E::Grey, "grey", "Grey"},
+        {E::Orange, "orange", "Orange"},
+        {E::Cream, "cream", "Cream"},
+        {E::Tan, "tan", "Tan"},
+        {E::Golden, "golden", "Golden"},
+        {E::Spotted, "spotted", "Spotted"},
+        {E::Striped, "striped", "Striped"},
+        {E::Brindle, "brindle", "Brindle"},
+        {E::Mixed, "mixed", "Mixed"},
+    }};
+    static constexpr std::array<EnumAlias<E>, 2> aliases{{
+        {"gray", E::Grey},
+        {"ginger", E::Orange},
+    }};
+};
+
+template <>
+struct EnumTable<models::AnimalStatus> {
+    using E = models::AnimalStatus;
+    static constexpr std::string_view name = "AnimalStatus";
+    static constexpr std::array<EnumEntry<E>, 3> entries{{
+        {E::Available, "available", "Available"},
+        {E::Adopted, "adopted", "Adopted"},
+        {E::Unavailable, "unavailable", "Unavailable"},
+    }};
+    static constexpr std::array<EnumAlias<E>, 0> aliases{};
+};
+
+template <>
+struct EnumTable<models::AnimalType> {
+    using E = models::AnimalType;
+    static constexpr std::string_view name = "AnimalType";
+    static constexpr std::array<EnumEntry<E>, 3> entries{{
+        {E::Dog, "dog", "Dog"},
+        {E::Cat, "cat", "Cat"},
+        {E::Other, "other", "Other"},
+    }};
+    static constexpr std::array<EnumAlias<E>, 2> aliases{{
+        {"rabbit", E::Other},
+        {"bird", E::Other},
+    }};
+};
+
+}  // namespace pawspective::utils
@@ -3,6 +3,8 @@
 #include <QJsonObject>
 #include <QString>
 #include "animal_enums.hpp"
+#include "utils/decode_error.hpp"
+#include "utils/json_reader.hpp"
 
 namespace pawspective::models {
 
@@ -13,6 +15,9 @@ struct BreedDTO {
 
     QJsonObject toJson() const;
     static BreedDTO fromJson(const QJsonObject& json);
+    static BreedDTO fromJson(utils::json::JsonReader& reader);
+    static utils::json::Decoded<BreedDTO> tryFromJson(const QJsonObject& json);
+    static utils::json::Decoded<BreedDTO> tryFromJson(utils::json::JsonReader& reader);
 };
 
 }  // namespace pawspective::models
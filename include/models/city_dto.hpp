@@ -3,6 +3,9 @@
 #include <QJsonObject>
 #include <QString>
 
+#include "utils/decode_error.hpp"
+#include "utils/json_reader.hpp"
+
 namespace pawspective::models {
 
 struct CityDTO {
@@ -11,6 +14,9 @@ struct CityDTO {
 
     QJsonObject toJson() const;
     static CityDTO fromJson(const QJsonObject& json);
+    static CityDTO fromJson(utils::json::JsonReader& reader);
+    static utils::json::Decoded<CityDTO> tryFromJson(const QJsonObject& json);
+    static utils::json::Decoded<CityDTO> tryFromJson(utils::json::JsonReader& reader);
 };
 
 }  // namespace pawspective::models
@@ -6,6 +6,9 @@
 #include <QString>
 #include <optional>
 #include "city_dto.hpp"
+#include "shared_dto.hpp"
+#include "utils/decode_error.hpp"
+#include "utils/json_reader.hpp"
 
 namespace pawspective::models {
 
@@ -18,6 +21,9 @@ struct OrganizationDTO {
 
     QJsonObject toJson() const;
     static OrganizationDTO fromJson(const QJsonObject& json);
+    static OrganizationDTO fromJson(utils::json::JsonReader& reader);
+    static utils::json::Decoded<OrganizationDTO> tryFromJson(const QJsonObject& json);
+    static utils::json::Decoded<OrganizationDTO> tryFromJson(utils::json::JsonReader& reader);
 };
 
 struct OrganizationListDTO {
@@ -26,10 +32,22 @@ struct OrganizationListDTO {
     int limit{};
     qint64 totalCount{};
     qint64 totalPages{};
+    // Items that failed to decode, with their paths; they are left out of items instead of failing the page.
+    QList<utils::json::DecodeError> rejectedItems;
 
+    QJsonObject toJson() const;
     static OrganizationListDTO fromJson(const QJsonObject& json);
+    // Decodes the page straight from the response bytes, without building a QJsonDocument.
+    static OrganizationListDTO fromJson(utils::json::JsonReader& reader);
+    static utils::json::Decoded<OrganizationListDTO> tryFromJson(const QJsonObject& json);
+    static utils::json::Decoded<OrganizationListDTO> tryFromJson(utils::json::JsonReader& reader);
 };
 
+using SharedOrganization = Shared<OrganizationDTO>;
+using SharedOrganizationList = Shared<OrganizationListDTO>;
+
 }  // namespace pawspective::models
 
-Q_DECLARE_METATYPE(pawspective::models::OrganizationListDTO)
\ No newline at end of file
+Q_DECLARE_METATYPE(pawspective::models::OrganizationListDTO)
+Q_DECLARE_METATYPE(pawspective::models::SharedOrganization)
+Q_DECLARE_METATYPE(pawspective::models::SharedOrganizationList)
\ No newline at end of file
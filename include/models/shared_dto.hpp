@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QExplicitlySharedDataPointer>
+#include <QSharedData>
+#include <utility>
+
+namespace pawspective::models {
+
+// Immutable, implicitly shared handle to a decoded DTO. Copying one costs a single reference-count increment, so a
+// page can be emitted to any number of receivers, queued across threads and kept by view models without copying its
+// members. The DTO cannot be changed through the handle; take a copy of *handle to edit it.
+//
+// A default-constructed handle is null and reads as a default-constructed DTO.
+template <typename Dto>
+class Shared {
+public:
+    Shared() = default;
+    explicit Shared(Dto value) : m_node(new Node(std::move(value))) {}
+
+    const Dto& operator*() const { return m_node ? m_node->value : empty(); }
+    const Dto* operator->() const { return &**this; }
+
+    bool isNull() const { return !m_node; }
+
+private:
+    struct Node : QSharedData {
+        explicit Node(Dto v) : value(std::move(v)) {}
+        const Dto value;
+    };
+
+    static const Dto& empty() {
+        static const Dto instance{};
+        return instance;
+    }
+
+    // Explicitly shared, so a copy never detaches: the node is never written after construction.
+    QExplicitlySharedDataPointer<Node> m_node;
+};
+
+}  // namespace pawspective::models
@@ -5,6 +5,8 @@
 #include <QVariant>
 #include <optional>
 
+#include "utils/decode_error.hpp"
+
 namespace pawspective::models {
 
 struct UserDTO {
@@ -32,8 +34,7 @@ public:
 
     QJsonObject toJson() const;
     static UserDTO fromJson(const QJsonObject& json);
-
-    static QString readString(const QJsonObject& json, const QString& key);
+    static utils::json::Decoded<UserDTO> tryFromJson(const QJsonObject& json);
 };
 
 }  // namespace pawspective::models
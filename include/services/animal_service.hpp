@@ -9,52 +9,104 @@
 #include "models/animal_filter_dto.hpp"
 #include "models/animal_register_dto.hpp"
 #include "models/animal_update_dto.hpp"
+#include "services/batch_loader.hpp"
 #include "services/errors.hpp"
 #include "services/i_network_client.hpp"
 
 namespace pawspective::services {
 
+class MutationQueue;
+
 class AnimalService : public QObject {
     Q_OBJECT
 public:
     explicit AnimalService(INetworkClient& networkClient, QObject* parent = nullptr);
 
-    void getAnimals(const models::AnimalFilterDTO& filter);
-    void getAnimal(qint64 id);
-    void createAnimal(const models::AnimalRegisterDTO& dto);
-    void updateAnimal(qint64 id, const models::AnimalUpdateDTO& dto);
-    void getAnimalFilters();
-    void getAnimalsByOrganization(qint64 organizationId, int page = 1, int limit = 10);
+    // When set, createAnimal and updateAnimal go through the durable queue and survive being offline. Queued
+    // mutations keep the caller's priority but ignore its cancellation token and supersede key: once logged, a
+    // mutation is sent even if the screen that made it is gone, and every queued edit is applied in order.
+    void setMutationQueue(MutationQueue* mutationQueue);
+    // When enabled, getAnimal calls made within one event-loop turn are fetched with one /animals?ids= request.
+    void setBatchingEnabled(bool enabled);
+
+    void getAnimals(const models::AnimalFilterDTO& filter, const RequestOptions& options = {});
+    void getAnimal(qint64 id, const RequestOptions& options = RequestOptions{RequestPriority::Interactive});
+    void createAnimal(
+        const models::AnimalRegisterDTO& dto,
+        const RequestOptions& options = RequestOptions{RequestPriority::Interactive}
+    );
+    void updateAnimal(
+        qint64 id,
+        const models::AnimalUpdateDTO& dto,
+        const RequestOptions& options = RequestOptions{RequestPriority::Interactive}
+    );
+    void getAnimalFilters(const RequestOptions& options = RequestOptions{RequestPriority::Background});
+    void getAnimalsByOrganization(
+        qint64 organizationId,
+        int page = 1,
+        int limit = 10,
+        const RequestOptions& options = {}
+    );
 
 signals:
-    void getAnimalsSuccess(const models::AnimalListDTO& result);
-    void getAnimalSuccess(const models::AnimalDTO& animal);
-    void createAnimalSuccess(const models::AnimalDTO& animal);
-    void updateAnimalSuccess(const models::AnimalDTO& animal);
+    void getAnimalsSuccess(const models::SharedAnimalList& result);
+    void getAnimalSuccess(const models::SharedAnimal& animal);
+    void createAnimalSuccess(const models::SharedAnimal& animal);
+    void updateAnimalSuccess(const models::SharedAnimal& animal);
+    // The mutation could not be sent yet; it is stored and the result arrives through MutationQueue.
+    void createAnimalQueued();
+    void updateAnimalQueued();
+    // A mutation reported as queued was refused by the server later on; the stored change is gone.
+    void createAnimalRejected(QSharedPointer<services::BaseError> error);
+    void updateAnimalRejected(QSharedPointer<services::BaseError> error);
     void getAnimalFiltersSuccess(const models::AnimalFilterDTO& filters);
-    void getAnimalsByOrganizationSuccess(const models::AnimalListDTO& result);
+    void getAnimalsByOrganizationSuccess(const models::SharedAnimalList& result);
 
     void getAnimalsFailed(QSharedPointer<services::BaseError> error);
-    void getAnimalFailed(QSharedPointer<services::BaseError> error);
+    // Carries the id that was asked for: with batching, one lookup answers the callers of several screens.
+    void getAnimalFailed(QSharedPointer<services::BaseError> error, qint64 id);
     void createAnimalFailed(QSharedPointer<services::BaseError> error);
     void updateAnimalFailed(QSharedPointer<services::BaseError> error);
     void getAnimalFiltersFailed(QSharedPointer<services::BaseError> error);
     void getAnimalsByOrganizationFailed(QSharedPointer<services::BaseError> error);
 
 private:
-    void handleError(QNetworkReply& reply, std::function<void(QSharedPointer<BaseError>)> onError);
+    void fetchAnimal(qint64 id, const RequestOptions& options, const BatchLoader::DoneHandler& done);
+    void fetchAnimals(
+        const QList<qint64>& ids,
+        const RequestOptions& options,
+        const BatchLoader::DoneHandler& unsupported
+    );
+    void handleError(const NetworkResponse& response, std::function<void(QSharedPointer<BaseError>)> onError);
     void handleSuccess(
-        QNetworkReply& reply,
+        const NetworkResponse& response,
         std::function<void(const QJsonObject&)> onSuccess,
         std::function<void(QSharedPointer<BaseError>)> onError
     );
     void handleSuccessArray(
-        QNetworkReply& reply,
+        const NetworkResponse& response,
         std::function<void(const QJsonArray&)> onSuccess,
         std::function<void(QSharedPointer<BaseError>)> onError
     );
+    // Streams one object from the body into Dto; a field that does not decode is reported with its path.
+    template <typename Dto>
+    void handleDtoSuccess(
+        const NetworkResponse& response,
+        std::function<void(const models::Shared<Dto>&)> onSuccess,
+        std::function<void(QSharedPointer<BaseError>)> onError
+    );
+    // Streams a list page from the body into Dto; used for the large paged responses.
+    template <typename Dto>
+    void handleListSuccess(
+        const NetworkResponse& response,
+        std::function<void(const models::Shared<Dto>&)> onSuccess,
+        std::function<void(QSharedPointer<BaseError>)> onError
+    );
 
     INetworkClient& m_networkClient;
+    MutationQueue* m_mutationQueue = nullptr;
+    BatchLoader m_animalLoader;
+    bool m_batchingEnabled = false;
 };
 
 }  // namespace pawspective::services
@@ -2,6 +2,7 @@
 #include <QNetworkAccessManager>
 #include <QObject>
 #include <QString>
+#include <QTimer>
 #include <cstdint>
 #include <functional>
 #include <optional>
@@ -21,9 +22,11 @@ public:
     void logout();
     void refreshToken(const QString& refreshToken);
     void getCurrentUser();
+    void prewarmConnection();
 
     // Token management
     bool isAuthenticated() const;
+    void setRefreshMargin(int seconds);
 
 signals:
     void loginSuccess(
@@ -43,14 +46,26 @@ signals:
 
     // NOLINTNEXTLINE(readability-redundant-access-specifiers)
 private:
-    void handleError(QNetworkReply& reply, std::function<void(QSharedPointer<BaseError>)> onError);
+    void handleError(const NetworkResponse& response, std::function<void(QSharedPointer<BaseError>)> onError);
     void handleSuccess(
-        QNetworkReply& reply,
+        const NetworkResponse& response,
         std::function<void(const QJsonObject&)> onSuccess,
         std::function<void(QSharedPointer<BaseError>)> onError
     );
+    struct TokenClaims {
+        std::optional<qint64> expiresAt;
+        std::optional<uint64_t> userId;
+    };
+
+    static TokenClaims decodeClaims(const QString& token);
+
     void handleUnauthorizedAccess();
     void clearSession();
+    void applyTokens(const QString& accessToken, const QString& refreshToken);
+    void scheduleRefresh();
+    void refreshAhead();
+    // Ends the session only when the server rejected the refresh token; otherwise releases the hold and retries.
+    void failRefresh(QSharedPointer<BaseError> error, bool rejected);
 
     std::tuple<QString, QString, QString> parseTokenResponse(const QJsonObject& obj);
 
@@ -58,6 +73,14 @@ private:
     QString m_accessToken;
     QString m_refreshToken;
     std::optional<std::uint64_t> m_userId;
+    TokenClaims m_claims;
+    QTimer m_refreshTimer;
+    static constexpr int minRefreshRetryMs = 5000;
+    static constexpr int maxRefreshRetryMs = 60000;
+
+    int m_refreshMarginSeconds = 60;
+    // Delay before the next attempt after a failed refresh; 0 while the last refresh succeeded.
+    int m_refreshRetryMs = 0;
     bool m_isRefreshing = false;
 };
 
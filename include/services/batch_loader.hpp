@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QQueue>
+#include <QUrl>
+#include <functional>
+
+#include "services/cancellation_token.hpp"
+#include "services/i_network_client.hpp"
+
+namespace pawspective::services {
+
+// Collects the per-id lookups made within one event-loop turn and fetches them with a single multi-id request.
+// When the backend turns out not to have the batch endpoint, the ids are fetched one by one instead, with a bounded
+// number of requests in flight. A caller's cancellation token and supersede key drop its id while it is still waiting
+// for the batch, and apply in full to the single lookup made for it.
+class BatchLoader {
+public:
+    using DoneHandler = std::function<void()>;
+    // Fetches all ids at once; calls unsupported() instead of reporting anything if there is no batch endpoint.
+    using FetchMany = std::function<void(const QList<qint64>&, const RequestOptions&, DoneHandler unsupported)>;
+    // Fetches one id and calls done() once the outcome has been reported.
+    using FetchOne = std::function<void(qint64, const RequestOptions&, DoneHandler done)>;
+    // One item of a multi-id answer, with the id it was requested under and its index in the answer.
+    using ItemHandler = std::function<void(qint64 id, const QJsonObject& item, qsizetype index)>;
+
+    BatchLoader(QObject* context, FetchMany fetchMany, FetchOne fetchOne);
+
+    void load(qint64 id, const RequestOptions& options);
+
+    void setMaxParallel(int maxParallel);
+    bool isBatchSupported() const;
+
+    // Status codes with which a backend without the batch endpoint answers a multi-id request.
+    static bool isMissingEndpoint(int statusCode);
+    // path?ids=1,2,3
+    static QUrl idsUrl(const QString& path, const QList<qint64>& ids);
+    // Hands every answered id to onItem exactly once and returns the ids the answer left out, so each requested id
+    // gets one outcome. The id is read before the item is decoded; an item whose id cannot be read, or that was not
+    // asked for, is skipped with a warning.
+    static QList<qint64> deliverItems(const QJsonArray& items, const QList<qint64>& ids, const ItemHandler& onItem);
+
+private:
+    struct Caller {
+        qint64 id;
+        RequestOptions options;
+    };
+
+    struct Single {
+        qint64 id;
+        RequestOptions options;
+        CancellationToken callerToken;
+        int callerSubscription = -1;
+    };
+
+    void dispatch();
+    void enqueueSingles(const QList<Caller>& callers);
+    void startSingles();
+
+    // One caller per id: the only caller's own options, or just the most urgent priority when several share the id.
+    static QList<Caller> perId(const QList<Caller>& callers);
+
+    QObject* m_context;
+    FetchMany m_fetchMany;
+    FetchOne m_fetchOne;
+
+    QList<Caller> m_callers;
+    bool m_scheduled = false;
+    bool m_batchSupported = true;
+
+    QQueue<Single> m_singles;
+    // Singles carry a token of their own, which the loader cancels to supersede them and watches to free their slot.
+    QHash<QString, CancellationToken> m_supersedeTokens;
+    int m_singlesInFlight = 0;
+    int m_maxParallel = 4;
+};
+
+}  // namespace pawspective::services
@@ -16,16 +16,19 @@ class BreedService : public QObject {
 public:
     explicit BreedService(INetworkClient& networkClient, QObject* parent = nullptr);
 
-    void getBreedsByType(models::AnimalType type);
+    void getBreedsByType(
+        models::AnimalType type,
+        const RequestOptions& options = RequestOptions{RequestPriority::Background}
+    );
 
 signals:
     void getBreedsByTypeSuccess(const QList<models::BreedDTO>& breeds);
     void getBreedsByTypeFailed(QSharedPointer<services::BaseError> error);
 
 private:
-    void handleError(QNetworkReply& reply, std::function<void(QSharedPointer<BaseError>)> onError);
+    void handleError(const NetworkResponse& response, std::function<void(QSharedPointer<BaseError>)> onError);
     void handleSuccess(
-        QNetworkReply& reply,
+        const NetworkResponse& response,
         std::function<void(const QJsonArray&)> onSuccess,
         std::function<void(QSharedPointer<BaseError>)> onError
     );
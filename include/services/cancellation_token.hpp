@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QHash>
+#include <QSharedPointer>
+#include <functional>
+
+namespace pawspective::services {
+
+// Shared cancellation flag handed to INetworkClient through RequestOptions. Copies observe the same state, so a
+// caller keeps one token, passes it to any number of requests and cancels them all at once. A default-constructed
+// token is null and can never be cancelled.
+class CancellationToken {
+public:
+    using Handler = std::function<void()>;
+
+    CancellationToken() = default;
+    static CancellationToken create();
+
+    bool isValid() const;
+    bool isCancelled() const;
+    void cancel() const;
+
+    int subscribe(Handler handler) const;
+    void unsubscribe(int id) const;
+
+private:
+    struct State {
+        bool cancelled = false;
+        int nextId = 0;
+        QHash<int, Handler> handlers;
+    };
+
+    QSharedPointer<State> m_state;
+};
+
+}  // namespace pawspective::services
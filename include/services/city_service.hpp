@@ -15,16 +15,16 @@ class CityService : public QObject {
 public:
     explicit CityService(INetworkClient& networkClient, QObject* parent = nullptr);
 
-    void getCities();
+    void getCities(const RequestOptions& options = RequestOptions{RequestPriority::Background});
 
 signals:
     void getCitiesSuccess(const QList<models::CityDTO>& cities);
     void getCitiesFailed(QSharedPointer<services::BaseError> error);
 
 private:
-    void handleError(QNetworkReply& reply, std::function<void(QSharedPointer<BaseError>)> onError);
+    void handleError(const NetworkResponse& response, std::function<void(QSharedPointer<BaseError>)> onError);
     void handleSuccess(
-        QNetworkReply& reply,
+        const NetworkResponse& response,
         std::function<void(const QJsonArray&)> onSuccess,
         std::function<void(QSharedPointer<BaseError>)> onError
     );
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QJsonObject>
+#include <QList>
+#include <QNetworkReply>
+#include <QPair>
+#include <QString>
+#include <QUrl>
+#include <optional>
+
+namespace pawspective::services {
+
+using HttpHeaders = QList<QPair<QByteArray, QByteArray>>;
+
+// One request attempt with its response, as stored in a HAR 1.2 file.
+struct HarEntry {
+    QDateTime startedAt;
+    QByteArray method;
+    QUrl url;
+    HttpHeaders requestHeaders;
+    QByteArray requestBody;
+    int status = 0;
+    HttpHeaders responseHeaders;
+    QByteArray responseBody;
+    // Transport failures have no HTTP status; they are kept in the non-standard _error fields.
+    QNetworkReply::NetworkError error = QNetworkReply::NoError;
+    QString errorString;
+    double blockedMs = 0;  // queued in the client
+    double waitMs = 0;     // sent until the first response byte
+    double receiveMs = 0;  // first until the last response byte
+
+    // What the server and the network took, i.e. the latency a replay reproduces.
+    double latencyMs() const { return waitMs + receiveMs; }
+
+    QJsonObject toJson() const;
+    static HarEntry fromJson(const QJsonObject& json);
+};
+
+// An HTTP Archive: NetworkClient appends to it while recording, HarReplayClient serves it back. The file opens in
+// browser dev tools and other HAR viewers.
+class HarRecording {
+public:
+    void append(HarEntry entry);
+    void clear();
+    const QList<HarEntry>& entries() const;
+
+    QJsonObject toJson() const;
+    bool save(const QString& path) const;
+    // Brings the file at path up to date for a recording still in progress. Only the entries appended since the
+    // last flush are written, so a long session costs no more per flush than a short one. If the file was not
+    // left by the previous flush, it is rewritten in full.
+    bool flush(const QString& path);
+    static std::optional<HarRecording> load(const QString& path);
+
+    // Credentials are never written to a recording: neither in headers nor as JSON body fields, at any depth.
+    static bool isSensitiveHeader(const QByteArray& name);
+    static bool isSensitiveField(const QString& name);
+
+private:
+    QList<HarEntry> m_entries;
+    qsizetype m_flushed = 0;  // entries already in the file written by flush()
+};
+
+}  // namespace pawspective::services
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+#include <QUrl>
+
+#include "services/har_recording.hpp"
+#include "services/i_network_client.hpp"
+
+namespace pawspective::services {
+
+// Serves a HAR recording through INetworkClient, so services run against what a real session saw without a server.
+// Requests are matched on method and absolute URL; repeated requests get the recorded answers in order, and once
+// those run out the last one again. Each answer arrives after the recorded latency times the latency scale.
+class HarReplayClient : public QObject, public INetworkClient {
+    Q_OBJECT
+public:
+    explicit HarReplayClient(const HarRecording& recording, QObject* parent = nullptr);
+
+    using INetworkClient::deleteResource;
+    using INetworkClient::get;
+    using INetworkClient::patch;
+    using INetworkClient::post;
+    using INetworkClient::put;
+
+    void get(
+        const QUrl& endpoint,
+        CallbackHandler onSuccess,
+        CallbackHandler onError,
+        const RequestOptions& options
+    ) override;
+    void post(
+        const QUrl& endpoint,
+        const QByteArray& data,
+        CallbackHandler onSuccess,
+        CallbackHandler onError,
+        const RequestOptions& options
+    ) override;
+    void put(
+        const QUrl& endpoint,
+        const QByteArray& data,
+        CallbackHandler onSuccess,
+        CallbackHandler onError,
+        const RequestOptions& options
+    ) override;
+    void patch(
+        const QUrl& endpoint,
+        const QByteArray& data,
+        CallbackHandler onSuccess,
+        CallbackHandler onError,
+        const RequestOptions& options
+    ) override;
+    void deleteResource(
+        const QUrl& endpoint,
+        CallbackHandler onSuccess,
+        CallbackHandler onError,
+        const RequestOptions& options
+    ) override;
+
+    // Relative endpoints are resolved against this before matching; use the base URL of the recorded session.
+    void setBaseUrl(const QUrl& url);
+    // 1 reproduces the recorded latencies, 0.5 halves them, 0 answers on the next event loop iteration.
+    void setLatencyScale(double scale);
+
+    // Requests that had no recorded answer, as "METHOD url".
+    const QStringList& unmatched() const;
+
+signals:
+    void requestReplayed(const QUrl& url, int statusCode, int delayMs);
+
+private:
+    void replay(
+        const QByteArray& method,
+        const QUrl& endpoint,
+        CallbackHandler onSuccess,
+        CallbackHandler onError,
+        const RequestOptions& options
+    );
+    static QString keyFor(const QByteArray& method, const QUrl& url);
+
+    QHash<QString, QList<HarEntry>> m_entries;
+    QHash<QString, qsizetype> m_served;
+    QHash<QString, CancellationToken> m_supersedeTokens;
+    QStringList m_unmatched;
+    QUrl m_baseUrl = QUrl("http://localhost:8080/");
+    double m_latencyScale = 1;
+};
+
+}  // namespace pawspective::services
@@ -1,39 +1,100 @@
 #pragma once
 
 #include <QByteArray>
+#include <QString>
 #include <QUrl>
+#include <cstdint>
 #include <functional>
 
-class QNetworkReply;
+#include "services/cancellation_token.hpp"
+#include "services/network_response.hpp"
 
 namespace pawspective::services {
 
+// Ordered from most to least urgent; the scheduler always prefers the lower value.
+enum class RequestPriority : uint8_t { Interactive, Visible, Prefetch, Background };
+
+// Applied to idempotent methods (GET, PUT, DELETE) and to requests that carry an idempotency key.
+struct RetryPolicy {
+    int maxAttempts = 3;  // including the first one; 1 disables retries
+    int baseDelayMs = 250;
+    int maxDelayMs = 4000;
+    // A Retry-After longer than this fails the request instead of waiting.
+    int maxRetryAfterMs = 30000;
+};
+
+struct RequestOptions {
+    RequestPriority priority = RequestPriority::Visible;
+    // Once cancelled, the callbacks of this request are never invoked.
+    CancellationToken cancellationToken;
+    // A new request with the same non-empty key cancels the previous one.
+    QString supersedeKey;
+    RetryPolicy retry;
+    // Upper bound for the response body in bytes; 0 uses the client-wide limit.
+    qint64 maxResponseSize = 0;
+    // False for calls that do not carry the access token (login, refresh); they are never held during a refresh.
+    bool requiresAuth = true;
+    // Sent as Idempotency-Key so the server can recognise a replayed mutation.
+    QByteArray idempotencyKey;
+};
+
+// Unless its cancellation token fires or it is superseded, every request ends in exactly one of its callbacks, also
+// when it is dropped while held for a token refresh.
 class INetworkClient {
 public:
-    using CallbackHandler = std::function<void(QNetworkReply&)>;
+    using CallbackHandler = std::function<void(const NetworkResponse&)>;
 
     virtual ~INetworkClient() = default;
 
-    virtual void get(const QUrl& endpoint, CallbackHandler onSuccess, CallbackHandler onError) = 0;
+    virtual void get(
+        const QUrl& endpoint,
+        CallbackHandler onSuccess,
+        CallbackHandler onError,
+        const RequestOptions& options
+    ) = 0;
     virtual void post(
         const QUrl& endpoint,
         const QByteArray& data,
         CallbackHandler onSuccess,
-        CallbackHandler onError
+        CallbackHandler onError,
+        const RequestOptions& options
     ) = 0;
     virtual void put(
         const QUrl& endpoint,
         const QByteArray& data,
         CallbackHandler onSuccess,
-        CallbackHandler onError
+        CallbackHandler onError,
+        const RequestOptions& options
     ) = 0;
     virtual void patch(
         const QUrl& endpoint,
         const QByteArray& data,
         CallbackHandler onSuccess,
-        CallbackHandler onError
+        CallbackHandler onError,
+        const RequestOptions& options
+    ) = 0;
+    virtual void deleteResource(
+        const QUrl& endpoint,
+        CallbackHandler onSuccess,
+        CallbackHandler onError,
+        const RequestOptions& options
     ) = 0;
-    virtual void deleteResource(const QUrl& endpoint, CallbackHandler onSuccess, CallbackHandler onError) = 0;
+
+    void get(const QUrl& endpoint, CallbackHandler onSuccess, CallbackHandler onError) {
+        get(endpoint, std::move(onSuccess), std::move(onError), RequestOptions{});
+    }
+    void post(const QUrl& endpoint, const QByteArray& data, CallbackHandler onSuccess, CallbackHandler onError) {
+        post(endpoint, data, std::move(onSuccess), std::move(onError), RequestOptions{});
+    }
+    void put(const QUrl& endpoint, const QByteArray& data, CallbackHandler onSuccess, CallbackHandler onError) {
+        put(endpoint, data, std::move(onSuccess), std::move(onError), RequestOptions{});
+    }
+    void patch(const QUrl& endpoint, const QByteArray& data, CallbackHandler onSuccess, CallbackHandler onError) {
+        patch(endpoint, data, std::move(onSuccess), std::move(onError), RequestOptions{});
+    }
+    void deleteResource(const QUrl& endpoint, CallbackHandler onSuccess, CallbackHandler onError) {
+        deleteResource(endpoint, std::move(onSuccess), std::move(onError), RequestOptions{});
+    }
 };
 
 }  // namespace pawspective::services
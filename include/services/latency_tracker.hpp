@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <array>
+
+namespace pawspective::services {
+
+struct TimeoutPolicy {
+    double percentile = 0.99;
+    double multiplier = 3.0;
+    int floorMs = 1000;
+    int ceilingMs = 30000;
+    // Until an endpoint has this many samples it gets defaultMs.
+    int minSamples = 20;
+    int defaultMs = 5000;
+};
+
+// Rolling latency histograms keyed by endpoint template. Each endpoint keeps its last windowSize samples; the
+// histogram is updated incrementally as samples enter and leave the window.
+class LatencyTracker {
+public:
+    static constexpr std::size_t bucketCount = 22;
+    static constexpr std::array<int, bucketCount> bucketBounds{
+        10,   20,   30,   50,   75,   100,  150,   200,   300,   500,   750,
+        1000, 1500, 2000, 3000, 5000, 7500, 10000, 15000, 20000, 30000, 60000,
+    };
+    static constexpr int windowSize = 256;
+
+    struct Histogram {
+        // counts[i] holds samples up to bucketBounds[i]; the last entry holds everything slower.
+        std::array<int, bucketCount + 1> counts{};
+        int samples = 0;
+    };
+
+    LatencyTracker();
+
+    void record(const QString& endpoint, int milliseconds);
+    void clear();
+
+    QList<QString> endpoints() const;
+    Histogram histogram(const QString& endpoint) const;
+    int percentile(const QString& endpoint, double fraction) const;
+    int timeoutFor(const QString& endpoint, const TimeoutPolicy& policy) const;
+
+private:
+    struct Window {
+        Histogram histogram;
+        QList<int> samples;
+        qsizetype next = 0;
+    };
+
+    static std::size_t bucketOf(int milliseconds);
+
+    QHash<QString, Window> m_windows;
+};
+
+}  // namespace pawspective::services
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+#include <atomic>
+#include <vector>
+
+namespace pawspective::services {
+
+// Log-linear histogram in the style of HdrHistogram: every power of two is split into subBuckets equal parts, so any
+// recorded value is off by at most 1/subBuckets (12.5%) at every magnitude, from microseconds to minutes, in a few
+// hundred counters.
+class HdrHistogram {
+public:
+    static constexpr int subBuckets = 8;
+
+    void record(qint64 value);
+
+    quint64 count() const { return m_count; }
+    qint64 sum() const { return m_sum; }
+    qint64 max() const { return m_max; }
+    // Upper bound of the bucket holding the given fraction of the values.
+    qint64 percentile(double fraction) const;
+    // Number of values that fell into buckets ending at or below bound.
+    quint64 countAtOrBelow(qint64 bound) const;
+
+private:
+    static qsizetype bucketOf(qint64 value);
+    static qint64 upperBoundOf(qsizetype bucket);
+
+    std::vector<quint64> m_buckets;
+    quint64 m_count = 0;
+    qint64 m_sum = 0;
+    qint64 m_max = 0;
+};
+
+// Process-wide counters and duration histograms rendered in the Prometheus text format. NetworkClient and
+// BaseViewModel record into it, so every service and view model is covered without code of its own. Nothing is
+// recorded until it is enabled.
+class MetricsRegistry {
+public:
+    using Labels = QList<QPair<QString, QString>>;
+
+    static MetricsRegistry& global();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    void describe(const QString& name, const QString& help);
+    void increment(const QString& name, const Labels& labels = {}, double by = 1);
+    // Durations are kept in microseconds and exported in seconds.
+    void observeMs(const QString& name, const Labels& labels, double milliseconds);
+
+    double counter(const QString& name, const Labels& labels = {}) const;
+    HdrHistogram histogram(const QString& name, const Labels& labels = {}) const;
+
+    QByteArray toPrometheus() const;
+    void clear();
+
+private:
+    static QString labelString(const Labels& labels);
+
+    mutable QMutex m_mutex;
+    std::atomic_bool m_enabled = false;
+    QMap<QString, QString> m_help;
+    QMap<QString, QMap<QString, double>> m_counters;
+    QMap<QString, QMap<QString, HdrHistogram>> m_histograms;
+};
+
+}  // namespace pawspective::services
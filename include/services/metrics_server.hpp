@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QTcpServer>
+#include <QTimer>
+
+#include "services/metrics_registry.hpp"
+
+namespace pawspective::services {
+
+// Serves the registry as Prometheus text on GET /metrics. It only ever binds to the loopback interface. It can also
+// write the same text to a file at a fixed interval, for machines that nothing scrapes.
+class MetricsServer : public QObject {
+    Q_OBJECT
+public:
+    explicit MetricsServer(MetricsRegistry& registry, QObject* parent = nullptr);
+
+    bool listen(quint16 port);
+    quint16 port() const;
+
+    void setDumpFile(const QString& path, int intervalMs);
+    bool dump() const;
+
+private:
+    void handleConnection();
+
+    MetricsRegistry& m_registry;
+    QTcpServer m_server;
+    QTimer m_dumpTimer;
+    QString m_dumpFile;
+};
+
+}  // namespace pawspective::services
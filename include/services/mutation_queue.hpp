@@ -0,0 +1,104 @@
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QUrl>
+#include <functional>
+#include <optional>
+
+#include "services/i_network_client.hpp"
+
+namespace pawspective::services {
+
+// Write-ahead queue for mutations. Every mutation is appended to a log on disk before it is sent, gets a
+// client-generated idempotency key, and is sent strictly in order, one at a time. A transient failure keeps it at the
+// head of the queue until connectivity returns; the log survives restarts, so nothing entered offline is lost.
+// Each user has their own log, so nothing one user entered is ever replayed with another user's token.
+class MutationQueue : public QObject {
+    Q_OBJECT
+public:
+    using CallbackHandler = INetworkClient::CallbackHandler;
+    using QueuedHandler = std::function<void()>;
+
+    struct Mutation {
+        QString idempotencyKey;
+        QString kind;
+        QByteArray method;
+        QUrl endpoint;
+        QByteArray body;
+        RequestPriority priority = RequestPriority::Interactive;
+    };
+
+    explicit MutationQueue(INetworkClient& networkClient, QObject* parent = nullptr);
+
+    // Loads what an earlier run left behind; restored mutations are sent on the next resume() or enqueue(). An empty
+    // path keeps the queue in memory only. A send still in flight from the previous log is abandoned; it stays in
+    // that log and is replayed with the same key when the log is loaded again.
+    void setStorageFile(const QString& path);
+    // Switches to the user's log under AppDataLocation, or to an in-memory queue without a user.
+    void setUserId(std::optional<uint64_t> userId);
+
+    QString enqueue(
+        const QString& kind,
+        const QByteArray& method,
+        const QUrl& endpoint,
+        const QByteArray& body,
+        CallbackHandler onSuccess,
+        CallbackHandler onError,
+        QueuedHandler onQueued,
+        RequestPriority priority = RequestPriority::Interactive
+    );
+
+    QList<Mutation> pending() const;
+    qsizetype pendingCount() const;
+
+public slots:
+    // Sends the head of the queue now instead of waiting for the backoff timer or a reachability change.
+    void resume();
+
+signals:
+    void pendingCountChanged();
+    // Outcome of a mutation whose caller has already moved on: it was restored from disk or reported as queued.
+    void mutationCompleted(const QString& kind, const QString& idempotencyKey, const NetworkResponse& response);
+    void mutationFailed(const QString& kind, const QString& idempotencyKey, const NetworkResponse& response);
+
+private:
+    struct Entry {
+        Mutation mutation;
+        CallbackHandler onSuccess;
+        CallbackHandler onError;
+        QueuedHandler onQueued;
+    };
+
+    static bool isTransient(const NetworkResponse& response);
+    static RequestPriority priorityFrom(const QJsonValue& value);
+
+    void sendHead();
+    void reportQueued();
+    void handleSuccess(const NetworkResponse& response);
+    void handleError(const NetworkResponse& response);
+    void completeHead();
+
+    void load();
+    void appendRecord(const QJsonObject& record);
+    void compact();
+
+    static constexpr int minRetryDelayMs = 2000;
+    static constexpr int maxRetryDelayMs = 60000;
+
+    INetworkClient& m_networkClient;
+    QList<Entry> m_entries;
+    QString m_storageFile;
+    QTimer m_retryTimer;
+    int m_retryDelayMs = minRetryDelayMs;
+    bool m_sending = false;
+    // Bumped when a send is abandoned, so that its late callbacks are ignored.
+    quint64 m_sendGeneration = 0;
+};
+
+}  // namespace pawspective::services
@@ -1,10 +1,24 @@
 #pragma once
 
+#include <QElapsedTimer>
+#include <QDeadlineTimer>
+#include <QHash>
 #include <QNetworkAccessManager>
+#include <QNetworkDiskCache>
+#include <QPointer>
 #include <QQueue>
+#include <QSet>
+#include <QSslConfiguration>
+#include <QTimer>
 #include <functional>
+#include <memory>
 
+#include "services/har_recording.hpp"
 #include "services/i_network_client.hpp"
+#include "services/latency_tracker.hpp"
+#include "services/request_scheduler.hpp"
+#include "services/request_timing.hpp"
+#include "services/retry_limiter.hpp"
 
 namespace pawspective::services {
 
@@ -16,43 +30,142 @@ public:
     using CallbackHandler = INetworkClient::CallbackHandler;
     using TokenProvider = std::function<QString()>;
 
-    explicit NetworkClient(QObject* parent = nullptr);
+    struct RetryStats {
+        quint64 retried = 0;
+        quint64 exhausted = 0;
+        quint64 throttled = 0;
+    };
+
+    // Sent counts request bodies, received counts response bodies; "raw" is the size before compression.
+    struct TransferStats {
+        quint64 requests = 0;
+        quint64 bytesSent = 0;
+        quint64 bytesSentRaw = 0;
+        quint64 bytesReceived = 0;
+        quint64 bytesReceivedRaw = 0;
+    };
 
-    void get(const QUrl& endpoint, CallbackHandler onSuccess, CallbackHandler onError) override;
+    // The HTTP cache lives in cacheDirectory, or under CacheLocation when it is empty.
+    explicit NetworkClient(QObject* parent = nullptr, const QString& cacheDirectory = QString());
+    ~NetworkClient() override;
+
+    using INetworkClient::deleteResource;
+    using INetworkClient::get;
+    using INetworkClient::patch;
+    using INetworkClient::post;
+    using INetworkClient::put;
+
+    void get(
+        const QUrl& endpoint,
+        CallbackHandler onSuccess,
+        CallbackHandler onError,
+        const RequestOptions& options
+    ) override;
     void post(
         const QUrl& endpoint,
         const QByteArray& data,
         CallbackHandler onSuccess,
-        CallbackHandler onError
+        CallbackHandler onError,
+        const RequestOptions& options
+    ) override;
+    void put(
+        const QUrl& endpoint,
+        const QByteArray& data,
+        CallbackHandler onSuccess,
+        CallbackHandler onError,
+        const RequestOptions& options
     ) override;
-    void put(const QUrl& endpoint, const QByteArray& data, CallbackHandler onSuccess, CallbackHandler onError) override;
     void patch(
         const QUrl& endpoint,
         const QByteArray& data,
         CallbackHandler onSuccess,
-        CallbackHandler onError
+        CallbackHandler onError,
+        const RequestOptions& options
+    ) override;
+    void deleteResource(
+        const QUrl& endpoint,
+        CallbackHandler onSuccess,
+        CallbackHandler onError,
+        const RequestOptions& options
     ) override;
-    void deleteResource(const QUrl& endpoint, CallbackHandler onSuccess, CallbackHandler onError) override;
 
     void setTokenProvider(TokenProvider provider);
     void setUserId(std::optional<uint64_t> userId);
     std::optional<uint64_t> getUserId() const;
 
+    void setMaxResponseSize(qint64 bytes);
+    void setRequestCompressionThreshold(qsizetype bytes);
+    void setTimeoutPolicy(const TimeoutPolicy& policy);
+
+    void setBaseUrl(const QUrl& url);
+    const QUrl& baseUrl() const;
+    void prewarm();
+    void setTlsSessionFile(const QString& path);
+
+    void setCacheDirectory(const QString& path);
+    void clearCache();
+
+    RequestScheduler& scheduler();
+    RetryLimiter& retryLimiter();
+    const RetryStats& retryStats() const;
+    const QHash<QString, TransferStats>& transferStats() const;
+    const LatencyTracker& latency() const;
+    RequestTimeline& timeline();
+    // Requests that take longer than this end to end are logged with their timing breakdown; 0 disables the log.
+    void setSlowRequestThreshold(int ms);
+    int slowRequestThreshold() const;
+
+    // Records every attempt with headers, bodies and timings to a HAR file, for HarReplayClient. The file is rewritten
+    // at most a second after each new entry and when recording stops; credentials are redacted.
+    void startHarRecording(const QString& path);
+    void stopHarRecording();
+    bool isHarRecording() const;
+
 signals:
     void unauthorizedAccess();
     void invalidTokenDetected();
+    void requestRetried(const QUrl& url, int attempt, int delayMs);
+    void requestTimed(const services::RequestTiming& timing);
 
 public slots:
+    void holdRequests();
     void retryPendingRequests();
     void clearPendingRequests();
 
 private:
+    struct Subscriber {
+        CallbackHandler onSuccess;
+        CallbackHandler onError;
+        QList<CancellationToken> tokens;
+
+        bool isCancelled() const;
+    };
+
     struct PendingRequest {
         HttpMethod method;
         QUrl endpoint;
         QByteArray data;
-        CallbackHandler onSuccess;
-        CallbackHandler onError;
+        QList<Subscriber> subscribers;
+        RequestOptions options;
+        QDeadlineTimer deadline;
+    };
+
+    struct InFlightRequest {
+        HttpMethod method;
+        QUrl endpoint;
+        QByteArray data;
+        RequestOptions options;
+        QString coalescingKey;
+        QList<Subscriber> subscribers;
+        QList<QPair<CancellationToken, int>> subscriptions;
+        QPointer<QNetworkReply> reply;
+        int attempt = 1;
+        QByteArray body;
+        bool oversized = false;
+        QElapsedTimer elapsed;
+        QElapsedTimer queued;
+        QSharedPointer<RequestTiming> timing;
+        quint64 traceFlow = 0;
     };
 
     void sendRequest(
@@ -60,18 +173,88 @@ private:
         const QUrl& endpoint,
         const QByteArray& data,
         CallbackHandler onSuccess,
-        CallbackHandler onError
+        CallbackHandler onError,
+        const RequestOptions& options
+    );
+    void enqueueRequest(
+        HttpMethod method,
+        const QUrl& endpoint,
+        const QByteArray& data,
+        Subscriber subscriber,
+        const RequestOptions& options,
+        int attempt
+    );
+    void queuePending(
+        HttpMethod method,
+        const QUrl& endpoint,
+        const QByteArray& data,
+        Subscriber subscriber,
+        const RequestOptions& options
+    );
+    void failPending(const PendingRequest& request, const QString& reason);
+    void replayPending();
+    void addSubscriber(quint64 id, Subscriber subscriber);
+    void startRequest(quint64 id);
+    void reserveBody(quint64 id);
+    void readBody(quint64 id);
+    qint64 maxResponseSizeFor(const InFlightRequest& request) const;
+    void abandonIfCancelled(quint64 id);
+    InFlightRequest takeRequest(quint64 id);
+    std::optional<int> retryDelay(const QNetworkReply& reply, const InFlightRequest& request);
+    void scheduleRetry(const InFlightRequest& request, const QList<Subscriber>& subscribers, int delayMs);
+    void handleReply(
+        const NetworkResponse& response,
+        const InFlightRequest& request,
+        const QList<Subscriber>& subscribers
     );
     QNetworkRequest createRequest(const QUrl& endpoint) const;
+    QString coalescingKeyFor(const QUrl& endpoint) const;
+    void storeSessionTicket(const QNetworkReply& reply);
+    QByteArray encodeRequestBody(const QUrl& url, const QByteArray& data, QNetworkRequest& request) const;
+    void recordReceived(const QNetworkReply& reply, const QByteArray& body);
+    void recordTiming(const RequestTiming& timing);
+    void recordMetrics(const RequestTiming& timing);
+    void recordHarEntry(const QNetworkReply& reply, const InFlightRequest& request);
+    // While recording only new entries are appended; stopping rewrites the file in full.
+    void flushHarRecording();
+    void saveHarRecording();
+
+    static constexpr qint64 maxCacheSize = 32LL * 1024 * 1024;
+    static constexpr qsizetype maxPendingRequests = 64;
+    static constexpr int pendingRequestTtlMs = 30000;
+    static constexpr int replayBatchSize = 4;
+    static constexpr int replayIntervalMs = 100;
+    static constexpr int harFlushDelayMs = 1000;
 
     QNetworkAccessManager m_manager;
-    int m_timeout = 5000;
+    QNetworkDiskCache* m_cache = nullptr;
+    qint64 m_maxResponseSize = 16LL * 1024 * 1024;
     QList<PendingRequest> m_pendingRequests;
+    QTimer m_replayTimer;
+    QHash<quint64, InFlightRequest> m_requests;
+    QHash<QString, quint64> m_inFlightGets;
+    QHash<QString, CancellationToken> m_supersedeTokens;
+    quint64 m_nextRequestId = 0;
+    RequestScheduler m_scheduler;
+    RetryLimiter m_retryLimiter;
+    RetryStats m_retryStats;
+    QHash<QString, TransferStats> m_transferStats;
+    LatencyTracker m_latency;
+    RequestTimeline m_timeline;
+    int m_slowRequestThresholdMs = 1000;
+    std::unique_ptr<HarRecording> m_harRecording;
+    QString m_harFile;
+    QTimer m_harFlushTimer;
+    TimeoutPolicy m_timeoutPolicy;
+    QSet<QString> m_deflateRequestHosts;
+    qsizetype m_requestCompressionThreshold = 4096;
     std::optional<uint64_t> m_userId;
     bool m_isRefreshing = false;
     TokenProvider m_tokenProvider;
 
-    const QUrl m_baseUrl = QUrl("http://localhost:8080/");
+    QUrl m_baseUrl = QUrl("http://localhost:8080/");
+    QSslConfiguration m_sslConfiguration;
+    QString m_tlsSessionFile;
 };
 
 }  // namespace pawspective::services
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QNetworkReply>
+#include <QSharedPointer>
+#include <QString>
+#include <QUrl>
+
+#include "services/request_timing.hpp"
+#include "utils/decode_error.hpp"
+#include "utils/json_reader.hpp"
+
+namespace pawspective::services {
+
+// A finished reply as handed to INetworkClient callbacks. The body is the buffer the reply was streamed into;
+// QByteArray is implicitly shared, so passing the response around never copies the payload.
+struct NetworkResponse {
+    QUrl url;
+    int statusCode = 0;
+    QNetworkReply::NetworkError error = QNetworkReply::NoError;
+    QString errorString;
+    QByteArray body;
+    int retryCount = 0;
+    // Set by NetworkClient; null for responses that did not come off the wire.
+    QSharedPointer<RequestTiming> timing;
+
+    // Parses the body and books the time spent on it to the request's timing.
+    QJsonDocument parseJson(QJsonParseError* error = nullptr) const {
+        QElapsedTimer timer;
+        timer.start();
+        QJsonDocument doc = QJsonDocument::fromJson(body, error);
+        addParseTime(timer);
+        return doc;
+    }
+
+    // Decodes the body straight into Dto::tryFromJson(JsonReader&), without a QJsonDocument in between, and books
+    // the time like parseJson(). Malformed JSON and fields that do not decode are both returned as a DecodeError.
+    template <typename Dto>
+    utils::json::Decoded<Dto> decodeJson() const {
+        QElapsedTimer timer;
+        timer.start();
+        utils::json::Decoded<Dto> decoded;
+        try {
+            utils::json::JsonReader reader(body);
+            decoded = Dto::tryFromJson(reader);
+            if (decoded) {
+                reader.finish();
+            }
+        } catch (const utils::json::JsonParseError& e) {
+            decoded = std::unexpected(utils::json::DecodeError{{}, QString::fromUtf8(e.what())});
+        }
+        addParseTime(timer);
+        return decoded;
+    }
+
+    void addParseTime(const QElapsedTimer& timer) const {
+        if (timing) {
+            timing->parseMs = qMax(0.0, timing->parseMs) + static_cast<double>(timer.nsecsElapsed()) / 1e6;
+        }
+    }
+};
+
+}  // namespace pawspective::services
@@ -9,46 +9,85 @@
 #include "models/organization_dto.hpp"
 #include "models/organization_register_dto.hpp"
 #include "models/organization_update_dto.hpp"
+#include "services/batch_loader.hpp"
 #include "services/errors.hpp"
 #include "services/i_network_client.hpp"
 
 namespace pawspective::services {
 
+class MutationQueue;
+
 class OrganizationService : public QObject {
     Q_OBJECT
 public:
     explicit OrganizationService(INetworkClient& networkClient, QObject* parent = nullptr);
 
-    void getOrganization(qint64 id);
-    void createOrganization(const models::OrganizationRegisterDTO& dto);
-    void updateOrganization(qint64 id, const models::OrganizationUpdateDTO& dto);
-    void findByNameContaining(const QString& name, int page = 1);
+    // When set, updateOrganization goes through the durable queue and survives being offline. The caller's priority
+    // is kept; its cancellation token and supersede key are ignored, since a logged edit is always sent, in order.
+    void setMutationQueue(MutationQueue* mutationQueue);
+    // When enabled, getOrganization calls made within one event-loop turn are fetched with one /orgs?ids= request.
+    void setBatchingEnabled(bool enabled);
+
+    void getOrganization(qint64 id, const RequestOptions& options = {});
+    void createOrganization(
+        const models::OrganizationRegisterDTO& dto,
+        const RequestOptions& options = RequestOptions{RequestPriority::Interactive}
+    );
+    void updateOrganization(
+        qint64 id,
+        const models::OrganizationUpdateDTO& dto,
+        const RequestOptions& options = RequestOptions{RequestPriority::Interactive}
+    );
+    void findByNameContaining(const QString& name, int page = 1, const RequestOptions& options = {});
 
 signals:
-    void getOrganizationSuccess(const models::OrganizationDTO& organization);
-    void createOrganizationSuccess(const models::OrganizationDTO& organization);
-    void updateOrganizationSuccess(const models::OrganizationDTO& organization);
-    void findByNameContainingSuccess(const models::OrganizationListDTO& result);
+    void getOrganizationSuccess(const models::SharedOrganization& organization);
+    void createOrganizationSuccess(const models::SharedOrganization& organization);
+    void updateOrganizationSuccess(const models::SharedOrganization& organization);
+    void findByNameContainingSuccess(const models::SharedOrganizationList& result);
+    // The update could not be sent yet; it is stored and the result arrives through MutationQueue.
+    void updateOrganizationQueued();
+    // An update reported as queued was refused by the server later on; the stored change is gone.
+    void updateOrganizationRejected(QSharedPointer<services::BaseError> error);
 
-    void getOrganizationFailed(QSharedPointer<services::BaseError> error);
+    // Carries the id that was asked for, so a screen can ignore lookups made for another one.
+    void getOrganizationFailed(QSharedPointer<services::BaseError> error, qint64 id);
     void createOrganizationFailed(QSharedPointer<services::BaseError> error);
     void updateOrganizationFailed(QSharedPointer<services::BaseError> error);
     void findByNameContainingFailed(QSharedPointer<services::BaseError> error);
 
 private:
-    void handleError(QNetworkReply& reply, std::function<void(QSharedPointer<BaseError>)> onError);
-    void handleSuccess(
-        QNetworkReply& reply,
-        std::function<void(const QJsonObject&)> onSuccess,
-        std::function<void(QSharedPointer<BaseError>)> onError
+    void fetchOrganization(qint64 id, const RequestOptions& options, const BatchLoader::DoneHandler& done);
+    void fetchOrganizations(
+        const QList<qint64>& ids,
+        const RequestOptions& options,
+        const BatchLoader::DoneHandler& unsupported
     );
+    void handleError(const NetworkResponse& response, std::function<void(QSharedPointer<BaseError>)> onError);
     void handleSuccessArray(
-        QNetworkReply& reply,
+        const NetworkResponse& response,
         std::function<void(const QJsonArray&)> onSuccess,
         std::function<void(QSharedPointer<BaseError>)> onError
     );
+    // Streams one object from the body into Dto; a field that does not decode is reported with its path.
+    template <typename Dto>
+    void handleDtoSuccess(
+        const NetworkResponse& response,
+        std::function<void(const models::Shared<Dto>&)> onSuccess,
+        std::function<void(QSharedPointer<BaseError>)> onError
+    );
+    // Streams a list page from the body into Dto; used for the large paged responses.
+    template <typename Dto>
+    void handleListSuccess(
+        const NetworkResponse& response,
+        std::function<void(const models::Shared<Dto>&)> onSuccess,
+        std::function<void(QSharedPointer<BaseError>)> onError
+    );
 
     INetworkClient& m_networkClient;
+    MutationQueue* m_mutationQueue = nullptr;
+    BatchLoader m_organizationLoader;
+    bool m_batchingEnabled = false;
 };
 
 }  // namespace pawspective::services
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QQueue>
+#include <array>
+#include <functional>
+#include <optional>
+
+#include "services/i_network_client.hpp"
+
+namespace pawspective::services {
+
+// Admits requests to the wire by priority class. Each class has its own concurrency cap, and everything except
+// Interactive additionally shares a global cap so background work can never occupy every connection. A queued
+// request that has waited longer than the starvation threshold is admitted ahead of more urgent classes.
+class RequestScheduler {
+public:
+    using Job = std::function<void()>;
+
+    RequestScheduler();
+
+    void enqueue(RequestPriority priority, Job start);
+    void release(RequestPriority priority);
+    void clear();
+
+    void setLimit(RequestPriority priority, int limit);
+    void setSharedLimit(int limit);
+    void setStarvationThreshold(int milliseconds);
+
+    int running(RequestPriority priority) const;
+    int queued(RequestPriority priority) const;
+
+private:
+    static constexpr std::size_t classCount = 4;
+
+    struct QueuedJob {
+        Job start;
+        QElapsedTimer waiting;
+    };
+
+    static std::size_t indexOf(RequestPriority priority);
+
+    void dispatch();
+    bool hasCapacity(std::size_t index) const;
+    std::optional<std::size_t> nextClass() const;
+
+    std::array<QQueue<QueuedJob>, classCount> m_queues;
+    std::array<int, classCount> m_running{};
+    std::array<int, classCount> m_limits{4, 4, 2, 1};
+    int m_sharedLimit = 6;
+    int m_sharedRunning = 0;
+    int m_starvationThreshold = 2000;
+    bool m_dispatching = false;
+};
+
+}  // namespace pawspective::services
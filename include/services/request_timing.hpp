@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QDateTime>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+namespace pawspective::services {
+
+// Where the time of one request attempt went. Durations are in milliseconds; -1 marks a phase that did not happen,
+// e.g. no response byte before a timeout or no callback for a cancelled request.
+struct RequestTiming {
+    quint64 id = 0;
+    QString method;
+    QString url;
+    QString endpoint;  // path with numeric segments folded into {id}, used to group requests
+    QDateTime startedAt;
+    int attempt = 1;
+    int statusCode = 0;
+    qint64 bytesReceived = 0;
+    bool fromCache = false;
+    double queueMs = 0;         // queued until admitted by the scheduler
+    double firstByteMs = -1;    // sent until the response headers arrived
+    double transferMs = 0;      // headers until the last body byte
+    double parseMs = -1;        // JSON parsing in the service
+    double applyMs = -1;        // rest of the callback: building DTOs and the view model applying them
+
+    double totalMs() const;
+    QJsonObject toJson() const;
+};
+
+// Keeps the most recent timings; once full, each new entry overwrites the oldest one.
+class RequestTimeline {
+public:
+    explicit RequestTimeline(qsizetype capacity = 256);
+
+    void append(const RequestTiming& timing);
+    void clear();
+
+    // Oldest first.
+    QList<RequestTiming> entries() const;
+    QList<RequestTiming> slowerThan(double thresholdMs) const;
+
+    qsizetype capacity() const;
+    void setCapacity(qsizetype capacity);
+
+    // All entries plus the ones at or above the threshold as a separate slow list; 0 leaves that list empty.
+    QJsonObject toJson(double slowThresholdMs) const;
+
+private:
+    QList<RequestTiming> m_entries;
+    qsizetype m_next = 0;
+    qsizetype m_capacity;
+};
+
+}  // namespace pawspective::services
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+
+#include "services/i_network_client.hpp"
+
+namespace pawspective::services {
+
+// Decides whether a failed request may be retried and how long to wait. Retries are drawn from two token buckets:
+// a global budget that grows with the number of first attempts, so retries stay a small fraction of the traffic,
+// and one bucket per endpoint, so a degraded backend is not hammered by every caller at once.
+class RetryLimiter {
+public:
+    RetryLimiter();
+
+    void recordRequest();
+    bool tryAcquire(const QString& endpoint);
+
+    void setBudget(double retriesPerRequest, double maxTokens);
+    void setEndpointBucket(double capacity, double refillPerSecond);
+
+    static int backoffDelay(const RetryPolicy& policy, int attempt);
+
+private:
+    struct Bucket {
+        double tokens = 0;
+        QElapsedTimer refilled;
+    };
+
+    double m_retriesPerRequest = 0.2;
+    double m_maxBudget = 10;
+    double m_budget = m_maxBudget;
+    double m_endpointCapacity = 3;
+    double m_endpointRefillPerSecond = 0.5;
+    QHash<QString, Bucket> m_endpoints;
+};
+
+}  // namespace pawspective::services
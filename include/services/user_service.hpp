@@ -31,8 +31,8 @@ signals:
     // void canCreateOrganizationResult(bool canCreate);
     // void userOrganizationsReceived(const QList<models::OrganizationDTO>& organizations);
 private:
-    void handleError(QNetworkReply& reply);
-    void handleSuccess(QNetworkReply& reply, std::function<void(const QJsonObject&)> onSuccess);
+    void handleError(const NetworkResponse& response);
+    void handleSuccess(const NetworkResponse& response, std::function<void(const QJsonObject&)> onSuccess);
 
     NetworkClient& m_networkClient;
 };
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <QLatin1StringView>
+#include <QString>
+#include <expected>
+
+namespace pawspective::utils::json {
+
+// Why a value could not be decoded into a DTO. The path locates the value in the document, e.g.
+// "items[3].breed.name"; the message is the one the throwing fromJson() overloads report.
+struct DecodeError {
+    QString path;
+    QString message;
+
+    // The error as it appears from one level up: within key of an object, or at index of an array.
+    DecodeError within(QLatin1StringView key) &&;
+    DecodeError within(qsizetype index) &&;
+
+    // "items[3].breed.name: Invalid or missing name field"
+    QString toString() const;
+};
+
+template <typename T>
+using Decoded = std::expected<T, DecodeError>;
+
+using DecodeStatus = std::expected<void, DecodeError>;
+
+}  // namespace pawspective::utils::json
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <QString>
+#include <QStringView>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+// String conversions for enums driven by one constexpr table per enum.
+//
+// A table is a specialisation of EnumTable<E> with
+//   - name:    the enum name used in error messages,
+//   - entries: one EnumEntry per enumerator, in declaration order (checked at compile time),
+//   - aliases: extra spellings accepted from user input, e.g. "gray" for Grey (may be empty).
+//
+// Parsing binary-searches a name index sorted at compile time; serialising indexes the table and hands out QStrings
+// built once per process.
+
+namespace pawspective::utils {
+
+template <typename E>
+struct EnumEntry {
+    E value;
+    std::string_view api;      // wire format, e.g. "special_needs"
+    std::string_view display;  // shown in the UI, e.g. "Special Needs"
+};
+
+template <typename E>
+struct EnumAlias {
+    std::string_view name;
+    E value;
+};
+
+template <typename E>
+struct EnumTable;
+
+namespace detail {
+
+template <typename E>
+struct NamedValue {
+    std::string_view name;
+    E value{};
+};
+
+template <typename E>
+consteval bool entriesFollowDeclarationOrder() {
+    const auto& entries = EnumTable<E>::entries;
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        if (static_cast<std::size_t>(entries[i].value) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename E, bool withAliases>
+consteval auto buildNameIndex() {
+    constexpr auto& entries = EnumTable<E>::entries;
+    constexpr std::size_t aliasCount = withAliases ? EnumTable<E>::aliases.size() : 0;
+
+    std::array<NamedValue<E>, entries.size() + aliasCount> index{};
+    std::size_t next = 0;
+    for (const auto& entry : entries) {
+        index[next++] = {entry.api, entry.value};
+    }
+    if constexpr (withAliases) {
+        for (const auto& alias : EnumTable<E>::aliases) {
+            index[next++] = {alias.name, alias.value};
+        }
+    }
+    std::sort(index.begin(), index.end(), [](const auto& a, const auto& b) { return a.name < b.name; });
+    return index;
+}
+
+template <typename E, bool withAliases>
+consteval bool namesAreUnique() {
+    constexpr auto index = buildNameIndex<E, withAliases>();
+    return std::adjacent_find(index.begin(), index.end(), [](const auto& a, const auto& b) {
+               return a.name == b.name;
+           }) == index.end();
+}
+
+template <typename E, bool withAliases>
+inline constexpr auto nameIndex = buildNameIndex<E, withAliases>();
+
+template <typename E, bool withAliases>
+constexpr std::optional<E> findByName(std::string_view name) {
+    static_assert(entriesFollowDeclarationOrder<E>(), "EnumTable entries must follow the enum declaration order");
+    static_assert(namesAreUnique<E, withAliases>(), "EnumTable names and aliases must be unique");
+
+    const auto& index = nameIndex<E, withAliases>;
+    const auto it = std::lower_bound(index.begin(), index.end(), name, [](const auto& entry, std::string_view key) {
+        return entry.name < key;
+    });
+    if (it != index.end() && it->name == name) {
+        return it->value;
+    }
+    return std::nullopt;
+}
+
+// Table names are short ASCII; anything else cannot match, so the key is built in a stack buffer. With fold, the
+// text is trimmed and lower-cased and '-' and ' ' become '_', so "Special Needs" finds "special_needs".
+inline constexpr std::size_t maxKeyLength = 32;
+
+inline std::optional<std::string_view> asciiKey(
+    QStringView text,
+    std::array<char, maxKeyLength>& buffer,
+    bool fold
+) {
+    if (fold) {
+        text = text.trimmed();
+    }
+    if (text.size() > qsizetype(buffer.size())) {
+        return std::nullopt;
+    }
+    for (qsizetype i = 0; i < text.size(); ++i) {
+        const char16_t c = text[i].unicode();
+        if (c >= 0x80) {
+            return std::nullopt;
+        }
+        char ascii = static_cast<char>(c);
+        if (fold) {
+            if (ascii >= 'A' && ascii <= 'Z') {
+                ascii = static_cast<char>(ascii - 'A' + 'a');
+            } else if (ascii == '-' || ascii == ' ') {
+                ascii = '_';
+            }
+        }
+        buffer[i] = ascii;
+    }
+    return std::string_view(buffer.data(), text.size());
+}
+
+template <typename E>
+constexpr std::size_t checkedIndex(E value) {
+    const auto index = static_cast<std::size_t>(value);
+    if (index >= EnumTable<E>::entries.size()) {
+        throw std::invalid_argument(std::format("Invalid {} enum value", EnumTable<E>::name));
+    }
+    return index;
+}
+
+}  // namespace detail
+
+// Exact wire name, e.g. AnimalSize::Large -> "large".
+template <typename E>
+constexpr std::string_view apiName(E value) {
+    return EnumTable<E>::entries[detail::checkedIndex(value)].api;
+}
+
+// The wire name as a QString that shares one per-process copy, so callers do not allocate.
+template <typename E>
+const QString& apiString(E value) {
+    static const auto strings = [] {
+        std::array<QString, EnumTable<E>::entries.size()> result;
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            const std::string_view api = EnumTable<E>::entries[i].api;
+            result[i] = QLatin1StringView(api.data(), qsizetype(api.size()));
+        }
+        return result;
+    }();
+    return strings[detail::checkedIndex(value)];
+}
+
+template <typename E>
+const QString& displayName(E value) {
+    static const auto strings = [] {
+        std::array<QString, EnumTable<E>::entries.size()> result;
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            const std::string_view display = EnumTable<E>::entries[i].display;
+            result[i] = QString::fromUtf8(display.data(), qsizetype(display.size()));
+        }
+        return result;
+    }();
+    return strings[detail::checkedIndex(value)];
+}
+
+// Exact wire names only, as received from the API.
+template <typename E>
+std::optional<E> enumFromApi(QStringView text) {
+    std::array<char, detail::maxKeyLength> buffer{};
+    const auto key = detail::asciiKey(text, buffer, false);
+    return key ? detail::findByName<E, false>(*key) : std::nullopt;
+}
+
+// Lenient parse for values typed by users or coming from filter widgets: case, surrounding spaces and '-'/' '
+// versus '_' do not matter, and aliases are accepted.
+template <typename E>
+std::optional<E> enumFromInput(QStringView text) {
+    std::array<char, detail::maxKeyLength> buffer{};
+    const auto key = detail::asciiKey(text, buffer, true);
+    return key ? detail::findByName<E, true>(*key) : std::nullopt;
+}
+
+}  // namespace pawspective::utils
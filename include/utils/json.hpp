@@ -2,8 +2,26 @@
 
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QJsonValue>
+#include <QList>
 #include <QString>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <expected>
+#include <format>
+#include <limits>
+#include <optional>
+#include <stdexcept>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "utils/decode_error.hpp"
+#include "utils/enum_table.hpp"
+#include "utils/json_reader.hpp"
+#include "utils/string_pool.hpp"
 
 namespace pawspective::utils::json {
 
@@ -16,14 +34,17 @@ std::optional<QString> getOptionalString(const QJsonObject& json, std::string_vi
 std::optional<qint64> getOptionalInt64(const QJsonObject& json, std::string_view key);
 std::optional<qint32> getOptionalInt32(const QJsonObject& json, std::string_view key);
 
+// Keys are ASCII, so a Latin-1 view lets QJsonObject compare them without building a QString.
+inline QLatin1StringView latin1Key(std::string_view key) { return {key.data(), qsizetype(key.size())}; }
+
 template <typename EnumType, typename FromApiFunc>
 std::optional<EnumType> getOptionalEnum(const QJsonObject& json, std::string_view key, FromApiFunc fromApi) {
-    QString qkey = QString::fromUtf8(key.data(), key.size());
-    if (!json.contains(qkey) || json[qkey].isNull()) {
+    const QJsonValue value = json.value(latin1Key(key));
+    if (value.isUndefined() || value.isNull()) {
         return std::nullopt;
     }
-    if (json[qkey].isString()) {
-        return fromApi(json[qkey].toString());
+    if (value.isString()) {
+        return fromApi(value.toString());
     }
     throw std::invalid_argument(std::format("Invalid {} field", key));
 }
@@ -34,15 +55,16 @@ std::optional<QVector<EnumType>> getOptionalEnumArray(
     std::string_view key,
     FromApiFunc fromApi
 ) {
-    QString qkey = QString::fromUtf8(key.data(), key.size());
-    if (!json.contains(qkey)) {
+    const QJsonValue value = json.value(latin1Key(key));
+    if (value.isUndefined()) {
         return std::nullopt;
     }
-    if (!json[qkey].isArray()) {
+    if (!value.isArray()) {
         throw std::invalid_argument(std::format("Invalid {} field: expected array", key));
     }
-    QJsonArray array = json[qkey].toArray();
+    const QJsonArray array = value.toArray();
     QVector<EnumType> result;
+    result.reserve(array.size());
     for (const auto& item : array) {
         if (item.isString()) {
             result.append(fromApi(item.toString()));
@@ -52,5 +74,493 @@ std::optional<QVector<EnumType>> getOptionalEnumArray(
     }
     return result;
 }
+// ---------------------------------------------------------------------------
+// Field descriptors
+//
+// A DTO lists its fields once as a constexpr tuple of descriptors and implements fromJson/toJson with decode() and
+// encode():
+//
+//     constexpr auto cityFields = std::tuple{
+//         json::required("id", &CityDTO::id),
+//         json::interned(json::required("name", &CityDTO::name)),
+//     };
+//
+// Every field costs one QJsonObject lookup. A missing or null required field fails with "Invalid or missing <key>
+// field"; a value of the wrong type fails with "Invalid <key> field" for optional fields, and an unknown enum name
+// with "Invalid <Enum>: <value>". A std::optional member is reset when the key is absent or null and omitted by
+// encode() when empty; any other optional member keeps its default value.
+//
+// tryDecode() reports the first failure as a DecodeError without throwing; decode() throws it as
+// std::invalid_argument. Both also accept a JsonReader, in which case the DTO is filled straight from the bytes
+// with the same rules. Nested DTOs are streamed if they provide tryFromJson(JsonReader&) and go through a
+// QJsonObject otherwise. Malformed JSON still throws JsonParseError from the reader, since nothing after it can be
+// read.
+//
+// Codecs read one value and consume it even when they fail, so a caller can carry on with the next one. A value of
+// the wrong type is reported as an empty DecodeError; decodeField() fills in the message for the field.
+
+DecodeError invalidField(QLatin1StringView key, bool required);
+[[noreturn]] void throwDecodeError(const DecodeError& error);
+
+inline DecodeStatus wrongType() { return std::unexpected(DecodeError{}); }
+
+inline DecodeStatus wrongType(JsonReader& reader) {
+    reader.skipValue();
+    return wrongType();
+}
+
+// QJsonValue converts a number that is not integral, or does not fit, to the default value; asking with two different
+// defaults tells that apart from a real one. 12.0 is integral, 12.5 is not.
+inline std::optional<qint64> integralValue(const QJsonValue& value) {
+    const qint64 result = value.toInteger(0);
+    if (result == 0 && value.toInteger(1) != 0) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+inline std::optional<qint32> integralValue32(const QJsonValue& value) {
+    const std::optional<qint64> result = integralValue(value);
+    if (!result || *result < std::numeric_limits<qint32>::min() || *result > std::numeric_limits<qint32>::max()) {
+        return std::nullopt;
+    }
+    return static_cast<qint32>(*result);
+}
+
+template <typename T>
+struct Codec;
+
+template <>
+struct Codec<qint64> {
+    static DecodeStatus read(const QJsonValue& value, qint64& out) {
+        const std::optional<qint64> number = value.isDouble() ? integralValue(value) : std::nullopt;
+        if (!number) {
+            return wrongType();
+        }
+        out = *number;
+        return {};
+    }
+    static DecodeStatus read(JsonReader& reader, qint64& out) {
+        if (reader.peek() != QJsonValue::Double) {
+            return wrongType(reader);
+        }
+        return read(reader.readNumber(), out);
+    }
+    static QJsonValue write(qint64 value) { return value; }
+};
+
+template <>
+struct Codec<qint32> {
+    static DecodeStatus read(const QJsonValue& value, qint32& out) {
+        const std::optional<qint32> number = value.isDouble() ? integralValue32(value) : std::nullopt;
+        if (!number) {
+            return wrongType();
+        }
+        out = *number;
+        return {};
+    }
+    static DecodeStatus read(JsonReader& reader, qint32& out) {
+        if (reader.peek() != QJsonValue::Double) {
+            return wrongType(reader);
+        }
+        return read(reader.readNumber(), out);
+    }
+    static QJsonValue write(qint32 value) { return value; }
+};
+
+template <>
+struct Codec<QString> {
+    static DecodeStatus read(const QJsonValue& value, QString& out) {
+        if (!value.isString()) {
+            return wrongType();
+        }
+        out = value.toString();
+        return {};
+    }
+    static DecodeStatus read(JsonReader& reader, QString& out) {
+        if (reader.peek() != QJsonValue::String) {
+            return wrongType(reader);
+        }
+        out = reader.readString();
+        return {};
+    }
+    static QJsonValue write(const QString& value) { return value; }
+};
+
+// An enum with an EnumTable, serialised as its API name, e.g. AnimalSize::Medium <-> "medium".
+template <typename E>
+    requires std::is_enum_v<E>
+struct Codec<E> {
+    static DecodeStatus fromName(const QString& name, E& out) {
+        if (const auto value = enumFromApi<E>(name)) {
+            out = *value;
+            return {};
+        }
+        return std::unexpected(DecodeError{
+            {},
+            QString("Invalid %1: %2").arg(QLatin1StringView(EnumTable<E>::name.data(), EnumTable<E>::name.size()), name)
+        });
+    }
+    static DecodeStatus read(const QJsonValue& value, E& out) {
+        if (!value.isString()) {
+            return wrongType();
+        }
+        return fromName(value.toString(), out);
+    }
+    static DecodeStatus read(JsonReader& reader, E& out) {
+        if (reader.peek() != QJsonValue::String) {
+            return wrongType(reader);
+        }
+        return fromName(reader.readString(), out);
+    }
+    static QJsonValue write(E value) { return apiString(value); }
+};
+
+template <typename T>
+concept JsonObjectDto = requires(const QJsonObject& json, const T& dto) {
+    { T::tryFromJson(json) } -> std::same_as<Decoded<T>>;
+    { dto.toJson() } -> std::same_as<QJsonObject>;
+};
+
+template <typename T>
+concept StreamingDto = requires(JsonReader& reader) {
+    { T::tryFromJson(reader) } -> std::same_as<Decoded<T>>;
+};
+
+template <JsonObjectDto T>
+struct Codec<T> {
+    static DecodeStatus assign(Decoded<T>&& decoded, T& out) {
+        if (!decoded) {
+            return std::unexpected(std::move(decoded.error()));
+        }
+        out = std::move(*decoded);
+        return {};
+    }
+    static DecodeStatus read(const QJsonValue& value, T& out) {
+        if (!value.isObject()) {
+            return wrongType();
+        }
+        return assign(T::tryFromJson(value.toObject()), out);
+    }
+    static DecodeStatus read(JsonReader& reader, T& out) {
+        if (reader.peek() != QJsonValue::Object) {
+            return wrongType(reader);
+        }
+        if constexpr (StreamingDto<T>) {
+            return assign(T::tryFromJson(reader), out);
+        } else {
+            return assign(T::tryFromJson(reader.readValue().toObject()), out);
+        }
+    }
+    static QJsonValue write(const T& value) { return value.toJson(); }
+};
+
+// Decodes the array items into out. onInvalid(error) decides what happens to an item that fails: returning true
+// drops it and carries on, returning false stops with that error. The array is consumed either way.
+template <typename T, typename OnInvalid>
+DecodeStatus readItems(const QJsonValue& value, QList<T>& out, OnInvalid onInvalid) {
+    if (!value.isArray()) {
+        return wrongType();
+    }
+    const QJsonArray array = value.toArray();
+    out.clear();
+    out.reserve(array.size());
+    for (qsizetype i = 0; i < array.size(); ++i) {
+        if (auto status = Codec<T>::read(array[i], out.emplace_back()); !status) {
+            out.removeLast();
+            DecodeError error = std::move(status.error()).within(i);
+            if (!onInvalid(error)) {
+                return std::unexpected(std::move(error));
+            }
+        }
+    }
+    return {};
+}
+
+template <typename T, typename OnInvalid>
+DecodeStatus readItems(JsonReader& reader, QList<T>& out, OnInvalid onInvalid) {
+    if (reader.peek() != QJsonValue::Array) {
+        return wrongType(reader);
+    }
+    out.clear();
+    DecodeStatus result;
+    reader.beginArray();
+    for (qsizetype i = 0; reader.nextElement(); ++i) {
+        if (!result) {
+            reader.skipValue();
+            continue;
+        }
+        if (auto status = Codec<T>::read(reader, out.emplace_back()); !status) {
+            out.removeLast();
+            DecodeError error = std::move(status.error()).within(i);
+            if (!onInvalid(error)) {
+                result = std::unexpected(std::move(error));
+            }
+        }
+    }
+    return result;
+}
+
+template <typename T>
+struct Codec<QList<T>> {
+    static DecodeStatus read(const QJsonValue& value, QList<T>& out) {
+        return readItems(value, out, [](const DecodeError&) { return false; });
+    }
+    static DecodeStatus read(JsonReader& reader, QList<T>& out) {
+        return readItems(reader, out, [](const DecodeError&) { return false; });
+    }
+    static QJsonValue write(const QList<T>& value) {
+        QJsonArray array;
+        for (const auto& item : value) {
+            array.append(Codec<T>::write(item));
+        }
+        return array;
+    }
+};
+
+template <typename T>
+struct OptionalTraits {
+    using Value = T;
+    static constexpr bool isOptional = false;
+};
+
+template <typename T>
+struct OptionalTraits<std::optional<T>> {
+    using Value = T;
+    static constexpr bool isOptional = true;
+};
+
+template <typename Dto, typename Member>
+struct Field {
+    using DtoType = Dto;
+    using MemberType = Member;
+    using Value = typename OptionalTraits<Member>::Value;
+
+    QLatin1StringView key;
+    Member Dto::*member;
+    bool required;
+
+    DecodeStatus read(const QJsonValue& value, Value& out, Dto&) const { return Codec<Value>::read(value, out); }
+    DecodeStatus read(JsonReader& reader, Value& out, Dto&) const { return Codec<Value>::read(reader, out); }
+    QJsonValue write(const Value& value) const { return Codec<Value>::write(value); }
+};
+
+// A string field whose values repeat across DTOs (breed, city and organization names); decoded values come from
+// StringPool::global(), so equal names share one buffer.
+template <typename Dto, typename Member>
+struct InternedField : Field<Dto, Member> {
+    static_assert(std::is_same_v<typename Field<Dto, Member>::Value, QString>, "Only string fields can be interned");
+
+    DecodeStatus read(const QJsonValue& value, QString& out, Dto&) const {
+        if (!value.isString()) {
+            return wrongType();
+        }
+        out = StringPool::global().intern(value.toString());
+        return {};
+    }
+    DecodeStatus read(JsonReader& reader, QString& out, Dto&) const {
+        if (reader.peek() != QJsonValue::String) {
+            return wrongType(reader);
+        }
+        out = StringPool::global().intern(reader.readString());
+        return {};
+    }
+};
+
+// A list field whose invalid items are dropped instead of failing the whole DTO. Each dropped item is recorded in
+// the rejected member with its path, e.g. "items[3].age", so a page with one bad animal still shows the others.
+template <typename Dto, typename Member>
+struct SkipInvalidItemsField : Field<Dto, Member> {
+    QList<DecodeError> Dto::*rejected;
+
+    DecodeStatus read(const QJsonValue& value, typename Field<Dto, Member>::Value& out, Dto& dto) const {
+        return readItems(value, out, [&](DecodeError error) { return reject(dto, std::move(error)); });
+    }
+    DecodeStatus read(JsonReader& reader, typename Field<Dto, Member>::Value& out, Dto& dto) const {
+        return readItems(reader, out, [&](DecodeError error) { return reject(dto, std::move(error)); });
+    }
+
+    bool reject(Dto& dto, DecodeError error) const {
+        if (error.message.isEmpty()) {
+            error.message = invalidField(this->key, false).message;
+        }
+        (dto.*rejected).append(std::move(error).within(this->key));
+        return true;
+    }
+};
+
+template <std::size_t N, typename Dto, typename Member>
+constexpr Field<Dto, Member> required(const char (&key)[N], Member Dto::*member) {
+    return {QLatin1StringView(key, N - 1), member, true};
+}
+
+template <std::size_t N, typename Dto, typename Member>
+constexpr Field<Dto, Member> optional(const char (&key)[N], Member Dto::*member) {
+    return {QLatin1StringView(key, N - 1), member, false};
+}
+
+template <typename Dto, typename Member>
+constexpr InternedField<Dto, Member> interned(Field<Dto, Member> field) {
+    return {field};
+}
+
+template <typename Dto, typename Member>
+constexpr SkipInvalidItemsField<Dto, Member> skipInvalidItems(
+    Field<Dto, Member> field,
+    QList<DecodeError> Dto::*rejected
+) {
+    return {field, rejected};
+}
+
+template <typename Descriptor>
+DecodeStatus fieldFailed(const Descriptor& field, DecodeStatus status) {
+    DecodeError error = std::move(status.error());
+    if (error.message.isEmpty()) {
+        error.message = invalidField(field.key, field.required).message;
+    }
+    return std::unexpected(std::move(error).within(field.key));
+}
+
+template <typename Descriptor>
+DecodeStatus decodeField(const QJsonObject& json, typename Descriptor::DtoType& dto, const Descriptor& field) {
+    using Traits = OptionalTraits<typename Descriptor::MemberType>;
+
+    const QJsonValue value = json.value(field.key);
+    auto& target = dto.*field.member;
+    if (value.isUndefined() || value.isNull()) {
+        if (field.required) {
+            return std::unexpected(invalidField(field.key, true));
+        }
+        if constexpr (Traits::isOptional) {
+            target.reset();
+        }
+        return {};
+    }
+
+    DecodeStatus status;
+    if constexpr (Traits::isOptional) {
+        status = field.read(value, target.emplace(), dto);
+    } else {
+        status = field.read(value, target, dto);
+    }
+    return status ? status : fieldFailed(field, std::move(status));
+}
+
+template <typename Descriptor>
+DecodeStatus decodeField(JsonReader& reader, typename Descriptor::DtoType& dto, const Descriptor& field) {
+    using Traits = OptionalTraits<typename Descriptor::MemberType>;
+
+    auto& target = dto.*field.member;
+    if (reader.peek() == QJsonValue::Null) {
+        reader.readNull();
+        if (field.required) {
+            return std::unexpected(invalidField(field.key, true));
+        }
+        if constexpr (Traits::isOptional) {
+            target.reset();
+        }
+        return {};
+    }
+
+    DecodeStatus status;
+    if constexpr (Traits::isOptional) {
+        status = field.read(reader, target.emplace(), dto);
+    } else {
+        status = field.read(reader, target, dto);
+    }
+    return status ? status : fieldFailed(field, std::move(status));
+}
+
+inline bool keyEquals(QByteArrayView key, QLatin1StringView name) {
+    return key.size() == name.size() && std::char_traits<char>::compare(key.data(), name.data(), key.size()) == 0;
+}
+
+template <typename Descriptor>
+void encodeField(QJsonObject& json, const typename Descriptor::DtoType& dto, const Descriptor& field) {
+    const auto& source = dto.*field.member;
+    if constexpr (OptionalTraits<typename Descriptor::MemberType>::isOptional) {
+        if (source.has_value()) {
+            json.insert(field.key, field.write(*source));
+        }
+    } else {
+        json.insert(field.key, field.write(source));
+    }
+}
+
+template <typename Dto, typename... Descriptors>
+Decoded<Dto> tryDecode(const QJsonObject& json, const std::tuple<Descriptors...>& fields) {
+    Dto dto;
+    DecodeStatus status;
+    std::apply([&](const auto&... field) { ((status = decodeField(json, dto, field)) && ...); }, fields);
+    if (!status) {
+        return std::unexpected(std::move(status.error()));
+    }
+    return dto;
+}
+
+// Reads the whole object even after a field failed, so the reader is left after it.
+template <typename Dto, typename... Descriptors>
+Decoded<Dto> tryDecode(JsonReader& reader, const std::tuple<Descriptors...>& fields) {
+    using Indices = std::index_sequence_for<Descriptors...>;
+
+    Dto dto;
+    DecodeStatus status;
+    std::array<bool, sizeof...(Descriptors)> seen{};
+
+    reader.beginObject();
+    while (const auto key = reader.nextKey()) {
+        if (!status) {
+            reader.skipValue();
+            continue;
+        }
+        const auto decodeIfNamed = [&]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+            if (!keyEquals(*key, std::get<I>(fields).key)) {
+                return false;
+            }
+            status = decodeField(reader, dto, std::get<I>(fields));
+            seen[I] = true;
+            return true;
+        };
+        const bool matched = [&]<std::size_t... I>(std::index_sequence<I...>) {
+            return (decodeIfNamed(std::integral_constant<std::size_t, I>{}) || ...);
+        }(Indices{});
+        if (!matched) {
+            reader.skipValue();
+        }
+    }
+    if (!status) {
+        return std::unexpected(std::move(status.error()));
+    }
+
+    std::optional<QLatin1StringView> missing;
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        const auto check = [&](const auto& field, bool present) {
+            if (field.required && !present && !missing) {
+                missing = field.key;
+            }
+        };
+        (check(std::get<I>(fields), seen[I]), ...);
+    }(Indices{});
+    if (missing) {
+        return std::unexpected(invalidField(*missing, true));
+    }
+    return dto;
+}
+
+template <typename Dto, typename Source, typename... Descriptors>
+Dto decode(Source& source, const std::tuple<Descriptors...>& fields) {
+    Decoded<Dto> decoded = tryDecode<Dto>(source, fields);
+    if (!decoded) {
+        throwDecodeError(decoded.error());
+    }
+    return std::move(*decoded);
+}
+
+template <typename Dto, typename... Descriptors>
+QJsonObject encode(const Dto& dto, const std::tuple<Descriptors...>& fields) {
+    QJsonObject json;
+    std::apply([&](const auto&... field) { (encodeField(json, dto, field), ...); }, fields);
+    return json;
+}
 
 }  // namespace pawspective::utils::json
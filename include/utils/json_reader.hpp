@@ -0,0 +1,81 @@
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QJsonValue>
+#include <QString>
+#include <optional>
+#include <stdexcept>
+
+namespace pawspective::utils::json {
+
+// Thrown for malformed input; the message matches the one services build from QJsonParseError.
+class JsonParseError : public std::runtime_error {
+public:
+    JsonParseError(qsizetype offset, const QString& message);
+
+    qsizetype offset() const { return m_offset; }
+
+private:
+    qsizetype m_offset;
+};
+
+// Pull parser over a UTF-8 buffer. Values are consumed in document order straight from the bytes, so a list
+// response can be decoded into DTOs without a QJsonDocument in between. The buffer must outlive the reader.
+//
+//     reader.beginObject();
+//     while (auto key = reader.nextKey()) {
+//         if (*key == "items") { ... } else { reader.skipValue(); }
+//     }
+//     reader.finish();
+class JsonReader {
+public:
+    explicit JsonReader(QByteArrayView data);
+
+    // Type of the next value without consuming it; Undefined once a complete document has been read.
+    QJsonValue::Type peek();
+
+    void beginObject();
+    // The next key of the current object, or nullopt once its closing brace has been consumed. The view is valid
+    // until the next call on the reader.
+    std::optional<QByteArrayView> nextKey();
+
+    void beginArray();
+    // True if the current array has another element, false once its closing bracket has been consumed.
+    bool nextElement();
+
+    QString readString();
+    // A qint64 value for integer literals that fit, a double otherwise.
+    QJsonValue readNumber();
+    bool readBool();
+    void readNull();
+    // Builds a QJsonValue for the next value; the fallback for data without a streaming decoder.
+    QJsonValue readValue();
+    void skipValue();
+
+    // Throws unless only whitespace is left.
+    void finish();
+
+    qsizetype offset() const { return m_pos; }
+
+private:
+    static constexpr int maxDepth = 1024;
+
+    [[noreturn]] void fail(const QString& message) const;
+    char skipWhitespace();
+    void expect(char c);
+    void expectLiteral(QByteArrayView literal);
+    void enterContainer();
+    QByteArrayView readRawString(QByteArray& scratch);
+    void readEscape(QByteArray& out);
+
+    QByteArrayView m_data;
+    qsizetype m_pos = 0;
+    int m_depth = 0;
+    // Set right after an opening bracket, where no comma is expected before the first entry.
+    bool m_atContainerStart = false;
+    QByteArray m_keyScratch;
+    QByteArray m_stringScratch;
+};
+
+}  // namespace pawspective::utils::json
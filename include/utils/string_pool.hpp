@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QStringView>
+
+namespace pawspective::utils {
+
+// Interning pool for short strings that repeat across decoded DTOs, such as breed, city and organization names. A
+// page of animals carries a handful of distinct names many times over; interned, every copy shares the buffer held
+// by the pool instead of owning one of its own.
+//
+// The pool is bounded: strings longer than maxLength are never interned, and once maxEntries are held, trim() runs
+// and a string that still does not fit is returned as is. trim() drops the entries no DTO refers to any more, so it
+// is called wherever decoded data is let go (NetworkClient::clearCache(), view model cleanup). A full pool trims
+// itself again only after a quarter of maxEntries further lookups, so a pool of strings still in use is not scanned
+// on every miss.
+class StringPool {
+public:
+    static constexpr qsizetype defaultMaxEntries = 4096;
+    static constexpr qsizetype defaultMaxLength = 64;
+
+    explicit StringPool(qsizetype maxEntries = defaultMaxEntries, qsizetype maxLength = defaultMaxLength);
+
+    static StringPool& global();
+
+    // A string equal to value that shares its buffer with every other interned copy.
+    QString intern(const QString& value);
+    QString intern(QStringView value);
+
+    // Drops the entries only the pool still holds and returns how many were dropped.
+    qsizetype trim();
+    void clear();
+
+    qsizetype size() const;
+
+private:
+    bool tryIntern(QStringView value, QString& out);
+    // Expects m_mutex to be held.
+    void dropUnused();
+
+    mutable QMutex m_mutex;
+    QSet<QString> m_strings;
+    qsizetype m_maxEntries;
+    qsizetype m_maxLength;
+    // Inserts and misses left before a full pool scans itself again.
+    qsizetype m_lookupsUntilTrim = 0;
+};
+
+}  // namespace pawspective::utils
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+// Scoped spans and flow ids written as Chrome trace events (chrome://tracing, ui.perfetto.dev).
+//
+// Spans are compiled in only when the build defines PAWSPECTIVE_TRACING (cmake -DPAWSPECTIVE_TRACING=ON); otherwise
+// every PAWS_TRACE_* macro expands to nothing. A tracing build records only after trace::start(), so until then a
+// span costs one relaxed atomic load.
+//
+// A flow links spans across asynchronous hops: the span that calls PAWS_TRACE_FLOW_BEGIN starts one, and every span
+// opened while that flow is current (see FlowScope) is drawn as the next step. NetworkClient carries the current
+// flow from the request to its callbacks, so a chain started in a view model runs through the HTTP request, the
+// service parse and the view model update to the frame that shows the result.
+
+namespace pawspective::utils::trace {
+
+namespace detail {
+extern std::atomic_bool enabled;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+}
+
+inline bool isEnabled() { return detail::enabled.load(std::memory_order_relaxed); }
+
+// Starts recording; stop() writes everything recorded so far to path.
+void start(const QString& path);
+bool stop();
+
+quint64 currentFlow();
+
+// Wall-clock span on the calling thread, emitted as a complete ("X") event when the scope ends.
+class Scope {
+public:
+    explicit Scope(const char* name, const char* category = "app", bool beginsFlow = false);
+    Scope(QByteArray name, const char* category);
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    QByteArray m_name;
+    const char* m_category;
+    qint64 m_startNs = -1;
+    quint64 m_flow = 0;
+    bool m_beginsFlow = false;
+    quint64 m_previousFlow = 0;
+};
+
+// Makes flow the current one for the calling thread while in scope.
+class FlowScope {
+public:
+    explicit FlowScope(quint64 flow);
+    ~FlowScope();
+
+    FlowScope(const FlowScope&) = delete;
+    FlowScope& operator=(const FlowScope&) = delete;
+
+private:
+    quint64 m_previous;
+};
+
+// Span that ended just now after durationNs, for work that was not bracketed by one scope (a network transfer).
+void complete(const QByteArray& name, const char* category, qint64 durationNs);
+
+// The current flow ends in the next frame reported through frameRendered().
+void awaitFrame();
+void frameRendered();
+
+}  // namespace pawspective::utils::trace
+
+#define PAWS_TRACE_CONCAT_INNER(a, b) a##b
+#define PAWS_TRACE_CONCAT(a, b) PAWS_TRACE_CONCAT_INNER(a, b)
+
+#ifdef PAWSPECTIVE_TRACING
+#define PAWS_TRACE_SCOPE(name) ::pawspective::utils::trace::Scope PAWS_TRACE_CONCAT(pawsTraceScope, __LINE__)(name)
+#define PAWS_TRACE_SCOPE_DYNAMIC(name, category)                                                                       \
+    ::pawspective::utils::trace::Scope PAWS_TRACE_CONCAT(pawsTraceScope, __LINE__)(                                    \
+        ::pawspective::utils::trace::isEnabled() ? QByteArray(name) : QByteArray(),                                    \
+        category                                                                                                       \
+    )
+#define PAWS_TRACE_FLOW_BEGIN(name)                                                                                    \
+    ::pawspective::utils::trace::Scope PAWS_TRACE_CONCAT(pawsTraceScope, __LINE__)(name, "app", true)
+#define PAWS_TRACE_CURRENT_FLOW() ::pawspective::utils::trace::currentFlow()
+#define PAWS_TRACE_FLOW_SCOPE(flow)                                                                                    \
+    ::pawspective::utils::trace::FlowScope PAWS_TRACE_CONCAT(pawsTraceFlow, __LINE__)(flow)
+#define PAWS_TRACE_AWAIT_FRAME() ::pawspective::utils::trace::awaitFrame()
+#define PAWS_TRACE_COMPLETE(name, category, durationNs)                                                                \
+    do {                                                                                                               \
+        if (::pawspective::utils::trace::isEnabled()) {                                                                \
+            ::pawspective::utils::trace::complete(name, category, durationNs);                                         \
+        }                                                                                                              \
+    } while (false)
+#else
+#define PAWS_TRACE_SCOPE(name)
+#define PAWS_TRACE_SCOPE_DYNAMIC(name, category)
+#define PAWS_TRACE_FLOW_BEGIN(name)
+#define PAWS_TRACE_CURRENT_FLOW() quint64(0)
+#define PAWS_TRACE_FLOW_SCOPE(flow)
+#define PAWS_TRACE_AWAIT_FRAME()
+#define PAWS_TRACE_COMPLETE(name, category, durationNs)
+#endif
@@ -53,7 +53,10 @@ public:
 
     Q_INVOKABLE void loadAnimal(qint64 id);
     void initialize() override {}
-    void cleanup() override {}
+    void cleanup() override {
+        BaseViewModel::cleanup();
+        setIsBusy(false);
+    }
 
 signals:
     void nameChanged();
@@ -79,6 +82,7 @@ private:
     services::AnimalService& m_animalService;
     services::OrganizationService& m_organizationService;
 
+    qint64 m_animalId = 0;
     QString m_name;
     QString m_animalType;
     QString m_breedName;
@@ -149,9 +149,9 @@ private:
 
     // NOLINTNEXTLINE(readability-redundant-access-specifiers)
 private slots:
-    void handleGetAnimalsSuccess(const models::AnimalListDTO& result);
+    void handleGetAnimalsSuccess(const models::SharedAnimalList& result);
     void handleGetAnimalsFailed(QSharedPointer<services::BaseError> error);
-    void handleGetAnimalsByOrganizationSuccess(const models::AnimalListDTO& result);
+    void handleGetAnimalsByOrganizationSuccess(const models::SharedAnimalList& result);
     void handleGetAnimalsByOrganizationFailed(QSharedPointer<services::BaseError> error);
     void handleGetAnimalFiltersSuccess(const models::AnimalFilterDTO& filters);
     void handleGetAnimalFiltersFailed(QSharedPointer<services::BaseError> error);
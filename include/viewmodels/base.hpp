@@ -1,9 +1,11 @@
 #pragma once
 
+#include <QElapsedTimer>
 #include <QObject>
 #include <QString>
 #include <functional>
 #include "services/errors.hpp"
+#include "services/i_network_client.hpp"
 
 namespace pawspective::viewmodels {
 /**
@@ -80,6 +82,7 @@ public:
      * Called when destroying the view/screen.
      * Must be implemented in derived classes.
      * Used for disconnecting signals, clearing cache, and releasing resources.
+     * Overrides should call BaseViewModel::cleanup(), which drops the requests still in flight.
      *
      * @note This is an invokable method and can be called from QML
      */
@@ -125,11 +128,50 @@ protected:
 
     QString formatValidationError(QSharedPointer<services::BaseError> error);
 
+    /**
+     * @brief Report a change stored while offline that the server refused later on
+     *
+     * @param what What was lost, e.g. "Animal changes made while offline were not saved"
+     * @param error Error the server answered with
+     *
+     * @see queuedChangeRejected
+     */
+    void emitQueuedChangeRejected(const QString& what, QSharedPointer<services::BaseError> error);
+
+    /**
+     * @brief Build request options bound to this ViewModel's lifetime
+     *
+     * Requests issued with these options are dropped by cancelPendingRequests() and cleanup():
+     * their success and error handlers are never invoked.
+     *
+     * @param priority Scheduling class of the request
+     * @param supersedeKey Non-empty key under which a newer request cancels the previous one,
+     *                     scoped to this ViewModel class
+     * @return Options to pass to a service call
+     */
+    services::RequestOptions requestOptions(
+        services::RequestPriority priority = services::RequestPriority::Visible,
+        const QString& supersedeKey = {}
+    ) const;
+
+    /**
+     * @brief Cancel every request issued with requestOptions() so far
+     *
+     * Later requests are unaffected.
+     */
+    void cancelPendingRequests();
+
+private:
+    services::CancellationToken m_requestToken = services::CancellationToken::create();
+    QElapsedTimer m_busyTimer;  // runs while isBusy is true, feeds the busy-time metric
+
 public slots:
     /**
      * @brief Set loading state
      *
      * Sets isBusy flag and generates change signal if necessary.
+     * The time between setting and clearing the flag is recorded as
+     * pawspective_viewmodel_busy_seconds, labelled with the ViewModel class.
      * Can be called from QML.
      *
      * @param value true to start loading, false to finish
@@ -155,5 +197,12 @@ signals:
      * @param message Textual error description
      */
     void errorOccurred(ErrorType type, const QString& message);
+
+    /**
+     * @brief Signal for a change stored while offline and reported as saved that the server refused
+     *
+     * @param message Textual description of what was lost and why
+     */
+    void queuedChangeRejected(const QString& message);
 };
 }  // namespace pawspective::viewmodels
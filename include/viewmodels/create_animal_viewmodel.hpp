@@ -202,6 +202,7 @@ private:
     void onBreedsLoadFailed(QSharedPointer<services::BaseError> error);
     void onAnimalCreated();
     void onError(QSharedPointer<services::BaseError> error);
+    void onQueuedCreateRejected(QSharedPointer<services::BaseError> error);
     void loadBreedsForType(models::AnimalType type);
     void updateBreedsList(const QList<models::BreedDTO>& breeds);
     bool validateRequiredFields();
@@ -26,7 +26,8 @@ public:
 
     Q_INVOKABLE void login();
 
-    void initialize() override {}
+    // The user is about to log in, so the connection is opened while they type.
+    void initialize() override { m_authService.prewarmConnection(); }
     void cleanup() override {
         setEmail({});
         setPassword({});
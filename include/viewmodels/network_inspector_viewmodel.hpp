@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QVariantList>
+
+#include "services/network_client.hpp"
+
+namespace pawspective::viewmodels {
+
+// Backs the hidden network inspector panel: the recent request timings of NetworkClient, newest first.
+class NetworkInspectorViewModel : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(bool active READ active WRITE setActive NOTIFY activeChanged)
+    Q_PROPERTY(QVariantList requests READ requests NOTIFY requestsChanged)
+    Q_PROPERTY(int slowThresholdMs READ slowThresholdMs WRITE setSlowThresholdMs NOTIFY slowThresholdMsChanged)
+
+public:
+    explicit NetworkInspectorViewModel(services::NetworkClient& networkClient, QObject* parent = nullptr);
+
+    bool active() const { return m_active; }
+    void setActive(bool active);
+
+    const QVariantList& requests() const { return m_requests; }
+
+    int slowThresholdMs() const;
+    void setSlowThresholdMs(int ms);
+
+    Q_INVOKABLE void refresh();
+    Q_INVOKABLE void clear();
+    // Writes all recorded timings plus the slow-request log to a JSON file and returns its path, or an empty string.
+    Q_INVOKABLE QString dumpJson();
+
+signals:
+    void activeChanged();
+    void requestsChanged();
+    void slowThresholdMsChanged();
+
+private:
+    services::NetworkClient& m_networkClient;
+    QVariantList m_requests;
+    // The list is only rebuilt while the panel is open.
+    bool m_active = false;
+};
+
+}  // namespace pawspective::viewmodels
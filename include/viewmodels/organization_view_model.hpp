@@ -70,11 +70,11 @@ signals:
 private slots:
     void handleGetCurrentUserSuccess(const models::UserDTO& user);
     void handleGetCurrentUserFailed(QSharedPointer<services::BaseError> error);
-    void handleGetOrganizationSuccess(const models::OrganizationDTO& organization);
-    void handleGetOrganizationFailed(QSharedPointer<services::BaseError> error);
-    void handleCreateOrganizationSuccess(const models::OrganizationDTO& organization);
+    void handleGetOrganizationSuccess(const models::SharedOrganization& organization);
+    void handleGetOrganizationFailed(QSharedPointer<services::BaseError> error, qint64 id);
+    void handleCreateOrganizationSuccess(const models::SharedOrganization& organization);
     void handleCreateOrganizationFailed(QSharedPointer<services::BaseError> error);
-    void handleUpdateOrganizationSuccess(const models::OrganizationDTO& organization);
+    void handleUpdateOrganizationSuccess(const models::SharedOrganization& organization);
     void handleUpdateOrganizationFailed(QSharedPointer<services::BaseError> error);
     void handleRefreshFailed(QSharedPointer<services::BaseError> error);
     void handleSessionEnded();
@@ -90,8 +90,10 @@ private:
     services::AuthService& m_authService;
     services::OrganizationService& m_organizationService;
 
-    models::OrganizationDTO m_organizationData;
+    models::SharedOrganization m_organizationData;
     qint64 m_currentOrganizationId = 0;
+    // The organization asked for by the last load; lookups made by other screens are ignored.
+    qint64 m_requestedOrganizationId = 0;
     bool m_hasOrganization = false;
     bool m_canUpdateOrganization = false;
     bool m_showDescription = false;
@@ -100,14 +102,14 @@ private:
     bool tryLoadCurrentOrganization();
     void resetOrganizationState();
     void applyOrganizationLoaded(
-        const models::OrganizationDTO& organization,
+        const models::SharedOrganization& organization,
         bool hasOrganizationValue,
         std::optional<bool> canUpdateOrganizationValue = std::nullopt
     );
     void handleNetworkFailure(QSharedPointer<services::BaseError> error, bool emitLoadFailedSignal);
 
     void loadOrganizationById(qint64 organizationId);
-    void updateOrganizationData(const models::OrganizationDTO& organization);
+    void updateOrganizationData(const models::SharedOrganization& organization);
     void clearOrganizationData();
 };
 
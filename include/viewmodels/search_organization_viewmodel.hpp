@@ -49,7 +49,7 @@ signals:
     void paginationChanged();
 
 private slots:
-    void handleSearchSuccess(const models::OrganizationListDTO& result);
+    void handleSearchSuccess(const models::SharedOrganizationList& result);
     void handleSearchFailed(QSharedPointer<services::BaseError> error);
 
     // NOLINTNEXTLINE(readability-redundant-access-specifiers)
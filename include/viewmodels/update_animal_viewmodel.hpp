@@ -44,8 +44,8 @@ public:
         QObject* parent = nullptr
     );
 
-    QString name() const { return m_changes.name.value_or(m_originalData.name); }
-    QString description() const { return m_changes.description.value_or(m_originalData.description.value_or("")); }
+    QString name() const { return m_changes.name.value_or(m_originalData->name); }
+    QString description() const { return m_changes.description.value_or(m_originalData->description.value_or("")); }
     QString animalType() const;
     qint64 breedId() const;
     QString size() const;
@@ -115,10 +115,12 @@ signals:
     void saveFailed(const QString& errorMessage);
 
 private slots:
-    void handleGetSuccess(const models::AnimalDTO& animal);
-    void handleGetFailed(QSharedPointer<services::BaseError> error);
-    void handleUpdateSuccess(const models::AnimalDTO& animal);
+    void handleGetSuccess(const models::SharedAnimal& animal);
+    void handleGetFailed(QSharedPointer<services::BaseError> error, qint64 id);
+    void handleUpdateSuccess(const models::SharedAnimal& animal);
+    void handleUpdateQueued();
     void handleUpdateFailed(QSharedPointer<services::BaseError> error);
+    void handleQueuedUpdateRejected(QSharedPointer<services::BaseError> error);
     void handleFiltersLoaded(const models::AnimalFilterDTO& filters);
     void handleFiltersFailed(QSharedPointer<services::BaseError> error);
     void handleBreedsLoaded(const QList<models::BreedDTO>& breeds);
@@ -167,7 +169,7 @@ private:
     services::BreedService& m_breedService;
     qint64 m_animalId = 0;
 
-    models::AnimalDTO m_originalData;
+    models::SharedAnimal m_originalData;
     models::AnimalUpdateDTO m_changes;
     models::AnimalFilterDTO m_filterDto;
 
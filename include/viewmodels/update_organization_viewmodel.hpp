@@ -58,12 +58,14 @@ signals:
     void saveFailed(const QString& errorMessage);
 
 private slots:
-    void handleGetSuccess(const models::OrganizationDTO& organization);
-    void handleUpdateSuccess(const models::OrganizationDTO& organization);
+    void handleGetSuccess(const models::SharedOrganization& organization);
+    void handleUpdateSuccess(const models::SharedOrganization& organization);
+    void handleUpdateQueued();
     void handleCitiesSuccess(const QList<models::CityDTO>& cities);
     void handleGetCurrentUserSuccess(const models::UserDTO& user);
-    void handleGetFailed(QSharedPointer<services::BaseError> error);
+    void handleGetFailed(QSharedPointer<services::BaseError> error, qint64 id);
     void handleUpdateFailed(QSharedPointer<services::BaseError> error);
+    void handleQueuedUpdateRejected(QSharedPointer<services::BaseError> error);
     void handleCitiesFailed(QSharedPointer<services::BaseError> error);
     void handleGetCurrentUserFailed(QSharedPointer<services::BaseError> error);
 
@@ -77,7 +79,9 @@ private:
     services::CityService& m_cityService;
     services::AuthService& m_authService;
 
-    models::OrganizationDTO m_originalData;
+    models::SharedOrganization m_originalData;
+    // The user's organization as last requested; lookups made by other screens are ignored.
+    qint64 m_organizationId = 0;
     models::OrganizationUpdateDTO m_changes;
     QVariantList m_cities;
     bool m_isDirty;
@@ -111,6 +111,13 @@ def test(preset="debug"):
     build(preset)
     run_command(["ctest", "--test-dir", f"build-{preset}", "--output-on-failure", "-V", "--timeout", "120"])
 
+def bench(preset="release"):
+    """Build the stand-in server and run the client benchmark against it."""
+    run_command(["cmake", "--preset", preset, "-DPAWSPECTIVE_BENCHMARKS=ON"])
+    run_command(["cmake", "--build", "--preset", preset, "-j", str(NPROCS), "--target", "client_benchmark"])
+    ext = ".exe" if os.name == 'nt' else ""
+    run_command([str(pathlib.Path(f"build-{preset}") / f"client_benchmark{ext}")] + sys.argv[3:])
+
 def build(preset="debug"):
     """Configure and build the project."""
     run_command(["cmake", "--preset", preset])
@@ -217,7 +224,7 @@ def tidy_lint():
                f"-config-file={pathlib.Path('.clang-tidy').resolve()}",
                "-header-filter=/src/.*",
                "-extra-arg=-Wno-unknown-argument",
-               '-extra-arg=-std=c++20',
+               '-extra-arg=-std=c++23',
                "-extra-arg=--target=x86_64-w64-windows-gnu",
                ]
         
@@ -249,6 +256,7 @@ def main():
             "  run [preset]             - Run application (default: debug)\n"
             "  clean                    - Clean build artifacts\n"
             "  test [preset]            - Build and run tests (default: debug)\n"
+            "  bench [preset] [args]    - Run the client benchmark against the stand-in server (default: release)\n"
             "  format                   - Format code with clang-format\n"
             "  format-check             - Check code formatting without changes\n"
             "  cppcheck                 - Run cppcheck static analysis\n"
@@ -269,6 +277,8 @@ def main():
         clean()
     elif cmd == "test":
         test(preset)
+    elif cmd == "bench":
+        bench(sys.argv[2] if len(sys.argv) > 2 else "release")
     elif cmd == "format":
         format_code()
     elif cmd == "format-check":
@@ -35,10 +35,40 @@ ApplicationWindow {
         function onSaveCompleted() {
             stackView.pop()
         }
+        function onQueuedChangeRejected(message) {
+            queuedChangeRejectedDialog.show(message)
+        }
+    }
+
+    // Changes saved while offline close their form right away; a later refusal by the server is shown here.
+    Connections {
+        target: createAnimalViewModel
+        function onQueuedChangeRejected(message) {
+            queuedChangeRejectedDialog.show(message)
+        }
+    }
+
+    Connections {
+        target: updateAnimalViewModel
+        function onQueuedChangeRejected(message) {
+            queuedChangeRejectedDialog.show(message)
+        }
     }
     signal animalCreated()
     signal animalUpdated()
 
+    // Hidden network inspector, toggled with Ctrl+Shift+I.
+    NetworkInspector {
+        id: networkInspector
+        viewModel: networkInspectorViewModel
+    }
+
+    Shortcut {
+        sequence: "Ctrl+Shift+I"
+        context: Qt.ApplicationShortcut
+        onActivated: networkInspector.opened ? networkInspector.close() : networkInspector.open()
+    }
+
     function openOrganizationView(organizationId, source, allowRefresh) {
         let resolvedOrganizationId = null
         const shouldRefresh = allowRefresh === undefined ? true : allowRefresh
@@ -140,6 +170,32 @@ ApplicationWindow {
         }
     }
 
+    Dialog {
+        id: queuedChangeRejectedDialog
+        property string message: ""
+        title: "Change Not Saved"
+        standardButtons: Dialog.Ok
+        modal: true
+        anchors.centerIn: parent
+        width: 400
+        height: 180
+
+        function show(text) {
+            message = text
+            open()
+        }
+
+        contentItem: Text {
+            text: queuedChangeRejectedDialog.message
+            wrapMode: Text.WordWrap
+            anchors.fill: parent
+            anchors.margins: 20
+            verticalAlignment: Text.AlignVCenter
+            horizontalAlignment: Text.AlignHCenter
+            font.pixelSize: 14
+        }
+    }
+
     // --- SCREEN COMPONENTS ---
 
     Component {
@@ -147,6 +203,7 @@ ApplicationWindow {
         LoginView {
             onRegisterRequested: stackView.push(registerViewComponent)
             onLoginSuccess: stackView.replace(userViewComponent)
+            Component.onCompleted: loginViewModel.initialize()
             Component.onDestruction: loginViewModel.cleanup()
         }
     }
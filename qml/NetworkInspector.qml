@@ -0,0 +1,135 @@
+import QtQuick 2.15
+import QtQuick.Controls 2.15
+import QtQuick.Layouts 1.15
+
+Drawer {
+    id: root
+
+    property var viewModel: null
+
+    QtObject {
+        id: theme
+        readonly property string fontName: "Consolas"
+        readonly property color pageBg: "#fdfdfd"
+        readonly property color headerBg: "#e9bebb"
+        readonly property color slowBg: "#f4a7b9"
+        readonly property color textDark: "#3b3452"
+    }
+
+    edge: Qt.RightEdge
+    width: Math.min(parent ? parent.width * 0.6 : 900, 1100)
+    height: parent ? parent.height : 800
+    interactive: false
+
+    onOpened: if (viewModel) viewModel.active = true
+    onClosed: if (viewModel) viewModel.active = false
+
+    function formatMs(value) {
+        return value < 0 ? "–" : Number(value).toFixed(1)
+    }
+
+    background: Rectangle { color: theme.pageBg }
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: 12
+        spacing: 8
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: 8
+
+            Label {
+                text: "Network inspector"
+                font.family: theme.fontName
+                font.bold: true
+                color: theme.textDark
+                Layout.fillWidth: true
+            }
+            Label {
+                text: "Slow ≥"
+                font.family: theme.fontName
+                color: theme.textDark
+            }
+            SpinBox {
+                from: 0
+                to: 60000
+                stepSize: 100
+                editable: true
+                value: root.viewModel ? root.viewModel.slowThresholdMs : 0
+                onValueModified: if (root.viewModel) root.viewModel.slowThresholdMs = value
+            }
+            Button {
+                text: "Dump JSON"
+                onClicked: {
+                    const path = root.viewModel ? root.viewModel.dumpJson() : ""
+                    dumpStatus.text = path.length > 0 ? "Saved to " + path : "Could not write the dump"
+                }
+            }
+            Button {
+                text: "Clear"
+                onClicked: if (root.viewModel) root.viewModel.clear()
+            }
+            Button {
+                text: "Close"
+                onClicked: root.close()
+            }
+        }
+
+        Label {
+            id: dumpStatus
+            visible: text.length > 0
+            font.family: theme.fontName
+            color: theme.textDark
+            elide: Text.ElideMiddle
+            Layout.fillWidth: true
+        }
+
+        Rectangle {
+            Layout.fillWidth: true
+            implicitHeight: 24
+            color: theme.headerBg
+
+            Text {
+                anchors.fill: parent
+                anchors.leftMargin: 6
+                verticalAlignment: Text.AlignVCenter
+                font.family: theme.fontName
+                color: theme.textDark
+                text: "status  total   queue   ttfb    xfer    parse   apply   bytes     request"
+            }
+        }
+
+        ListView {
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            clip: true
+            model: root.viewModel ? root.viewModel.requests : []
+
+            delegate: Rectangle {
+                width: ListView.view.width
+                height: 22
+                color: modelData.slow ? theme.slowBg : "transparent"
+
+                Text {
+                    anchors.fill: parent
+                    anchors.leftMargin: 6
+                    verticalAlignment: Text.AlignVCenter
+                    font.family: theme.fontName
+                    color: theme.textDark
+                    elide: Text.ElideRight
+                    text: String(modelData.status).padEnd(8)
+                          + root.formatMs(modelData.totalMs).padEnd(8)
+                          + root.formatMs(modelData.queueMs).padEnd(8)
+                          + root.formatMs(modelData.firstByteMs).padEnd(8)
+                          + root.formatMs(modelData.transferMs).padEnd(8)
+                          + root.formatMs(modelData.parseMs).padEnd(8)
+                          + root.formatMs(modelData.applyMs).padEnd(8)
+                          + String(modelData.bytes).padEnd(10)
+                          + modelData.method + " " + modelData.url
+                          + (modelData.attempt > 1 ? " (attempt " + modelData.attempt + ")" : "")
+                }
+            }
+        }
+    }
+}
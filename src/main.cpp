@@ -1,21 +1,29 @@
 #include <QApplication>
 #include <QDebug>
 #include <QDirIterator>
+#include <QElapsedTimer>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQuickWindow>
 #include <QUrl>
+#include <memory>
 
 #include "mainwindow.hpp"
 #include "services/animal_service.hpp"
 #include "services/auth_service.hpp"
 #include "services/breed_service.hpp"
 #include "services/city_service.hpp"
+#include "services/har_replay_client.hpp"
+#include "services/metrics_server.hpp"
+#include "services/mutation_queue.hpp"
 #include "services/organization_service.hpp"
 #include "services/user_service.hpp"
+#include "utils/trace.hpp"
 #include "viewmodels/animal_detail_viewmodel.hpp"
 #include "viewmodels/animal_list_viewmodel.hpp"
 #include "viewmodels/create_animal_viewmodel.hpp"
 #include "viewmodels/login_view_model.hpp"
+#include "viewmodels/network_inspector_viewmodel.hpp"
 #include "viewmodels/organization_card_viewmodel.hpp"
 #include "viewmodels/organization_view_model.hpp"
 #include "viewmodels/register_organization_view_model.hpp"
@@ -29,6 +37,53 @@
 int main(int argc, char* argv[]) {
     QGuiApplication app(argc, argv);
 
+    // --trace [file] or PAWSPECTIVE_TRACE=<file|1> records a Chrome trace (trace.json by default).
+    QString tracePath = qEnvironmentVariable("PAWSPECTIVE_TRACE");
+    if (tracePath == "1") {
+        tracePath = "trace.json";
+    }
+    if (const qsizetype index = app.arguments().indexOf("--trace"); index >= 0) {
+        const QString next = app.arguments().value(index + 1);
+        tracePath = next.isEmpty() || next.startsWith("--") ? QString("trace.json") : next;
+    }
+#ifdef PAWSPECTIVE_TRACING
+    if (!tracePath.isEmpty()) {
+        pawspective::utils::trace::start(tracePath);
+    }
+#else
+    if (!tracePath.isEmpty()) {
+        qWarning() << "Tracing requested, but this build has no trace spans (configure with -DPAWSPECTIVE_TRACING=ON)";
+    }
+#endif
+
+    // PAWSPECTIVE_METRICS_PORT=<port> serves Prometheus metrics on 127.0.0.1; PAWSPECTIVE_METRICS_FILE=<file> writes
+    // them every 10 s. Without either nothing is recorded.
+    auto& metrics = pawspective::services::MetricsRegistry::global();
+    pawspective::services::MetricsServer metricsServer(metrics);
+    const QString metricsPort = qEnvironmentVariable("PAWSPECTIVE_METRICS_PORT");
+    const QString metricsFile = qEnvironmentVariable("PAWSPECTIVE_METRICS_FILE");
+    if (!metricsPort.isEmpty() || !metricsFile.isEmpty()) {
+        metrics.setEnabled(true);
+        metrics.describe("pawspective_http_requests_total", "Finished HTTP request attempts by endpoint and status.");
+        metrics.describe("pawspective_http_request_duration_seconds", "Queue to end of callback, per attempt.");
+        metrics.describe("pawspective_http_retries_total", "Request attempts scheduled for a retry.");
+        metrics.describe("pawspective_http_cache_total", "GET responses served from the disk cache or the network.");
+        metrics.describe("pawspective_parse_duration_seconds", "JSON parsing of response bodies.");
+        metrics.describe("pawspective_model_update_duration_seconds", "Building DTOs and applying them to models.");
+        metrics.describe("pawspective_viewmodel_busy_seconds", "Time a view model spent with isBusy set.");
+        metrics.describe("pawspective_frame_duration_seconds", "Scene graph sync, render and swap per frame.");
+    }
+    if (!metricsPort.isEmpty()) {
+        if (metricsServer.listen(metricsPort.toUShort())) {
+            qInfo() << "Metrics on http://127.0.0.1:" + QString::number(metricsServer.port()) + "/metrics";
+        } else {
+            qWarning() << "Cannot serve metrics on port" << metricsPort;
+        }
+    }
+    if (!metricsFile.isEmpty()) {
+        metricsServer.setDumpFile(metricsFile, 10000);
+    }
+
     qRegisterMetaType<pawspective::models::UserDTO>("UserDTO");
     qRegisterMetaType<pawspective::models::UserDTO>("pawspective::models::UserDTO");
 
@@ -41,12 +96,58 @@ int main(int argc, char* argv[]) {
     }
 
     pawspective::services::NetworkClient networkClient(&app);
+    if (const QByteArray apiUrl = qgetenv("PAWSPECTIVE_API_URL"); !apiUrl.isEmpty()) {
+        networkClient.setBaseUrl(QUrl(QString::fromUtf8(apiUrl)));
+    }
+    networkClient.prewarm();
+
+    // PAWSPECTIVE_HAR_RECORD=<file> records the session; PAWSPECTIVE_HAR_REPLAY=<file> serves the API services from
+    // such a recording instead (PAWSPECTIVE_HAR_LATENCY_SCALE=<factor> speeds it up or slows it down). Sign-in and
+    // the user endpoints stay on the live client.
+    if (const QString harRecord = qEnvironmentVariable("PAWSPECTIVE_HAR_RECORD"); !harRecord.isEmpty()) {
+        networkClient.startHarRecording(harRecord);
+    }
+    std::unique_ptr<pawspective::services::HarReplayClient> harReplayClient;
+    if (const QString harReplay = qEnvironmentVariable("PAWSPECTIVE_HAR_REPLAY"); !harReplay.isEmpty()) {
+        if (const auto recording = pawspective::services::HarRecording::load(harReplay)) {
+            harReplayClient = std::make_unique<pawspective::services::HarReplayClient>(*recording);
+            harReplayClient->setBaseUrl(networkClient.baseUrl());
+            bool hasScale = false;
+            const double scale = qEnvironmentVariable("PAWSPECTIVE_HAR_LATENCY_SCALE").toDouble(&hasScale);
+            harReplayClient->setLatencyScale(hasScale ? scale : 1.0);
+        } else {
+            qWarning() << "Cannot read HAR recording" << harReplay;
+        }
+    }
+    pawspective::services::INetworkClient& apiClient =
+        harReplayClient ? static_cast<pawspective::services::INetworkClient&>(*harReplayClient) : networkClient;
+
     pawspective::services::AuthService authService(networkClient);
+    pawspective::services::MutationQueue mutationQueue(apiClient);
+    QObject::connect(
+        &authService,
+        &pawspective::services::AuthService::loginSuccess,
+        &mutationQueue,
+        [&mutationQueue](const QString&, const QString&, const QString&, uint64_t userId) {
+            mutationQueue.setUserId(userId != 0 ? std::optional<uint64_t>(userId) : std::nullopt);
+            mutationQueue.resume();
+        }
+    );
+    QObject::connect(
+        &authService,
+        &pawspective::services::AuthService::sessionEnded,
+        &mutationQueue,
+        [&mutationQueue]() { mutationQueue.setUserId(std::nullopt); }
+    );
     pawspective::services::UserService userService(networkClient);
-    pawspective::services::OrganizationService organizationService(networkClient);
-    pawspective::services::CityService cityService(networkClient);
-    pawspective::services::AnimalService animalService(networkClient);
-    pawspective::services::BreedService breedService(networkClient);
+    pawspective::services::OrganizationService organizationService(apiClient);
+    pawspective::services::CityService cityService(apiClient);
+    pawspective::services::AnimalService animalService(apiClient);
+    pawspective::services::BreedService breedService(apiClient);
+    organizationService.setMutationQueue(&mutationQueue);
+    animalService.setMutationQueue(&mutationQueue);
+    organizationService.setBatchingEnabled(true);
+    animalService.setBatchingEnabled(true);
     auto loginViewModel = new pawspective::viewmodels::LoginViewModel(authService, &app);
     auto registerViewModel = new pawspective::viewmodels::RegisterViewModel(userService, &app);
     auto registerOrganizationViewModel =
@@ -71,6 +172,7 @@ int main(int argc, char* argv[]) {
         cityService,
         &app
     );
+    auto networkInspectorViewModel = new pawspective::viewmodels::NetworkInspectorViewModel(networkClient, &app);
 
     engine.rootContext()->setContextProperty("loginViewModel", loginViewModel);
     engine.rootContext()->setContextProperty("authService", &authService);
@@ -86,6 +188,7 @@ int main(int argc, char* argv[]) {
     engine.rootContext()->setContextProperty("searchOrganizationViewModel", searchOrganizationViewModel);
     engine.rootContext()->setContextProperty("updateAnimalViewModel", updateAnimalViewModel);
     engine.rootContext()->setContextProperty("animalListViewModel", animalListViewModel);
+    engine.rootContext()->setContextProperty("networkInspectorViewModel", networkInspectorViewModel);
 
     QObject::connect(
         &engine,
@@ -101,5 +204,54 @@ int main(int argc, char* argv[]) {
 
     engine.load(url);
 
+    if (metrics.isEnabled() && !engine.rootObjects().isEmpty()) {
+        if (auto* window = qobject_cast<QQuickWindow*>(engine.rootObjects().constFirst())) {
+            // Both signals come from the render thread, so the timer is only ever touched there.
+            auto frameTimer = std::make_shared<QElapsedTimer>();
+            QObject::connect(
+                window,
+                &QQuickWindow::beforeSynchronizing,
+                window,
+                [frameTimer]() { frameTimer->start(); },
+                Qt::DirectConnection
+            );
+            QObject::connect(
+                window,
+                &QQuickWindow::frameSwapped,
+                window,
+                [frameTimer]() {
+                    if (frameTimer->isValid()) {
+                        pawspective::services::MetricsRegistry::global().observeMs(
+                            "pawspective_frame_duration_seconds",
+                            {},
+                            static_cast<double>(frameTimer->nsecsElapsed()) / 1e6
+                        );
+                    }
+                },
+                Qt::DirectConnection
+            );
+        }
+    }
+
+#ifdef PAWSPECTIVE_TRACING
+    // Flows that changed what is on screen end in the frame that shows it.
+    if (pawspective::utils::trace::isEnabled() && !engine.rootObjects().isEmpty()) {
+        if (auto* window = qobject_cast<QQuickWindow*>(engine.rootObjects().constFirst())) {
+            QObject::connect(
+                window,
+                &QQuickWindow::frameSwapped,
+                window,
+                []() { pawspective::utils::trace::frameRendered(); },
+                Qt::DirectConnection
+            );
+        }
+    }
+    const int exitCode = app.exec();
+    if (pawspective::utils::trace::stop()) {
+        qInfo() << "Trace written to" << tracePath;
+    }
+    return exitCode;
+#else
     return app.exec();  // NOLINT
+#endif
 }
\ No newline at end of file
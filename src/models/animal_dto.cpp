@@ -1,61 +1,78 @@
 #include "../include/models/animal_dto.hpp"
 
-#include <QJsonArray>
+#include <tuple>
 
 #include "utils/json.hpp"
+#include "utils/trace.hpp"
 
 namespace pawspective::models {
 
-QJsonObject AnimalDTO::toJson() const {
-    QJsonObject json;
-
-    json["id"] = id;
-    json["organization_id"] = organizationId;
-    json["name"] = name;
-    json["breed"] = breed.toJson();
-    json["size"] = toApiString(size);
-    json["gender"] = toApiString(gender);
-    json["care_level"] = toApiString(careLevel);
-    json["color"] = toApiString(color);
-    json["good_with"] = toApiString(goodWith);
-    json["age"] = age;
-    if (description.has_value()) {
-        json["description"] = description.value();
-    }
-    json["status"] = toApiString(status);
-
-    return json;
+namespace {
+
+namespace json = utils::json;
+
+constexpr auto animalFields = std::tuple{
+    json::required("id", &AnimalDTO::id),
+    json::required("organization_id", &AnimalDTO::organizationId),
+    json::required("name", &AnimalDTO::name),
+    json::required("breed", &AnimalDTO::breed),
+    json::required("size", &AnimalDTO::size),
+    json::required("gender", &AnimalDTO::gender),
+    json::required("care_level", &AnimalDTO::careLevel),
+    json::required("color", &AnimalDTO::color),
+    json::required("good_with", &AnimalDTO::goodWith),
+    json::required("age", &AnimalDTO::age),
+    json::optional("description", &AnimalDTO::description),
+    json::required("status", &AnimalDTO::status),
+};
+
+// A missing items array is an empty page; an item that does not decode is left out and listed in rejectedItems.
+constexpr auto animalListFields = std::tuple{
+    json::required("page", &AnimalListDTO::page),
+    json::required("limit", &AnimalListDTO::limit),
+    json::required("total_count", &AnimalListDTO::totalCount),
+    json::required("total_pages", &AnimalListDTO::totalPages),
+    json::skipInvalidItems(json::optional("items", &AnimalListDTO::items), &AnimalListDTO::rejectedItems),
+};
+
+}  // namespace
+
+QJsonObject AnimalDTO::toJson() const { return utils::json::encode(*this, animalFields); }
+
+AnimalDTO AnimalDTO::fromJson(const QJsonObject& json) { return utils::json::decode<AnimalDTO>(json, animalFields); }
+
+AnimalDTO AnimalDTO::fromJson(utils::json::JsonReader& reader) {
+    return utils::json::decode<AnimalDTO>(reader, animalFields);
+}
+
+utils::json::Decoded<AnimalDTO> AnimalDTO::tryFromJson(const QJsonObject& json) {
+    return utils::json::tryDecode<AnimalDTO>(json, animalFields);
 }
 
-AnimalDTO AnimalDTO::fromJson(const QJsonObject& json) {
-    AnimalDTO dto;
-    dto.id = pawspective::utils::json::getRequiredInt64(json, "id");
-    dto.organizationId = pawspective::utils::json::getRequiredInt64(json, "organization_id");
-    dto.name = pawspective::utils::json::getRequiredString(json, "name");
-    dto.breed = BreedDTO::fromJson(pawspective::utils::json::getRequiredObject(json, "breed"));
-    dto.size = animalSizeFromApi(pawspective::utils::json::getRequiredString(json, "size"));
-    dto.gender = animalGenderFromApi(pawspective::utils::json::getRequiredString(json, "gender"));
-    dto.careLevel = careLevelFromApi(pawspective::utils::json::getRequiredString(json, "care_level"));
-    dto.color = animalColorFromApi(pawspective::utils::json::getRequiredString(json, "color"));
-    dto.goodWith = goodWithFromApi(pawspective::utils::json::getRequiredString(json, "good_with"));
-    dto.age = pawspective::utils::json::getRequiredInt32(json, "age");
-    dto.description = pawspective::utils::json::getOptionalString(json, "description");
-    dto.status = animalStatusFromApi(pawspective::utils::json::getRequiredString(json, "status"));
-    return dto;
+utils::json::Decoded<AnimalDTO> AnimalDTO::tryFromJson(utils::json::JsonReader& reader) {
+    return utils::json::tryDecode<AnimalDTO>(reader, animalFields);
 }
 
+QJsonObject AnimalListDTO::toJson() const { return utils::json::encode(*this, animalListFields); }
+
 AnimalListDTO AnimalListDTO::fromJson(const QJsonObject& json) {
-    AnimalListDTO dto;
-    dto.page = pawspective::utils::json::getRequiredInt32(json, "page");
-    dto.limit = pawspective::utils::json::getRequiredInt32(json, "limit");
-    dto.totalCount = pawspective::utils::json::getRequiredInt64(json, "total_count");
-    dto.totalPages = pawspective::utils::json::getRequiredInt64(json, "total_pages");
-
-    const QJsonArray items = json["items"].toArray();
-    for (const auto& item : items) {
-        dto.items.append(AnimalDTO::fromJson(item.toObject()));
-    }
-    return dto;
+    PAWS_TRACE_SCOPE("AnimalListDTO::fromJson");
+    return utils::json::decode<AnimalListDTO>(json, animalListFields);
+}
+
+AnimalListDTO AnimalListDTO::fromJson(utils::json::JsonReader& reader) {
+    PAWS_TRACE_SCOPE("AnimalListDTO::fromJson");
+    return utils::json::decode<AnimalListDTO>(reader, animalListFields);
+}
+
+utils::json::Decoded<AnimalListDTO> AnimalListDTO::tryFromJson(const QJsonObject& json) {
+    PAWS_TRACE_SCOPE("AnimalListDTO::tryFromJson");
+    return utils::json::tryDecode<AnimalListDTO>(json, animalListFields);
+}
+
+utils::json::Decoded<AnimalListDTO> AnimalListDTO::tryFromJson(utils::json::JsonReader& reader) {
+    PAWS_TRACE_SCOPE("AnimalListDTO::tryFromJson");
+    return utils::json::tryDecode<AnimalListDTO>(reader, animalListFields);
 }
 
 }  // namespace pawspective::models
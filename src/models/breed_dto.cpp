@@ -1,25 +1,37 @@
 #include "models/breed_dto.hpp"
+
+#include <tuple>
+
 #include "utils/json.hpp"
 
 namespace pawspective::models {
 
-QJsonObject BreedDTO::toJson() const {
-    QJsonObject json;
+namespace {
+
+namespace json = utils::json;
+
+constexpr auto breedFields = std::tuple{
+    json::required("id", &BreedDTO::id),
+    json::required("animal_type", &BreedDTO::animalType),
+    json::interned(json::optional("name", &BreedDTO::name)),
+};
 
-    json["id"] = id;
-    json["animal_type"] = toApiString(animalType);
-    json["name"] = name;
+}  // namespace
+
+QJsonObject BreedDTO::toJson() const { return utils::json::encode(*this, breedFields); }
+
+BreedDTO BreedDTO::fromJson(const QJsonObject& json) { return utils::json::decode<BreedDTO>(json, breedFields); }
+
+BreedDTO BreedDTO::fromJson(utils::json::JsonReader& reader) {
+    return utils::json::decode<BreedDTO>(reader, breedFields);
+}
 
-    return json;
+utils::json::Decoded<BreedDTO> BreedDTO::tryFromJson(const QJsonObject& json) {
+    return utils::json::tryDecode<BreedDTO>(json, breedFields);
 }
 
-BreedDTO BreedDTO::fromJson(const QJsonObject& json) {
-    BreedDTO dto;
-    dto.id = utils::json::getRequiredInt64(json, "id");
-    dto.animalType = animalTypeFromApi(pawspective::utils::json::getRequiredString(json, "animal_type"));
-    auto nameOpt = utils::json::getOptionalString(json, "name");
-    dto.name = nameOpt.value_or("");
-    return dto;
+utils::json::Decoded<BreedDTO> BreedDTO::tryFromJson(utils::json::JsonReader& reader) {
+    return utils::json::tryDecode<BreedDTO>(reader, breedFields);
 }
 
 }  // namespace pawspective::models
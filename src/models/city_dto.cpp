@@ -1,30 +1,34 @@
 #include "../include/models/city_dto.hpp"
-#include <QString>
+
+#include <tuple>
+
+#include "utils/json.hpp"
 
 namespace pawspective::models {
 
-QJsonObject CityDTO::toJson() const {
-    QJsonObject json;
+namespace {
 
-    json["id"] = id;
-    json["name"] = name;
+namespace json = utils::json;
 
-    return json;
-}
+constexpr auto cityFields = std::tuple{
+    json::required("id", &CityDTO::id),
+    json::interned(json::required("name", &CityDTO::name)),
+};
+
+}  // namespace
 
-CityDTO CityDTO::fromJson(const QJsonObject& json) {
-    CityDTO dto;
+QJsonObject CityDTO::toJson() const { return utils::json::encode(*this, cityFields); }
 
-    if (!json.contains("id") || json["id"].isNull() || !json["id"].isDouble()) {
-        throw std::invalid_argument("Invalid or missing id field");
-    }
-    dto.id = json["id"].toVariant().toLongLong();
-    if (!json.contains("name") || json["name"].isNull() || !json["name"].isString()) {
-        throw std::invalid_argument("Invalid or missing name field");
-    }
-    dto.name = json["name"].toString();
+CityDTO CityDTO::fromJson(const QJsonObject& json) { return utils::json::decode<CityDTO>(json, cityFields); }
+
+CityDTO CityDTO::fromJson(utils::json::JsonReader& reader) { return utils::json::decode<CityDTO>(reader, cityFields); }
+
+utils::json::Decoded<CityDTO> CityDTO::tryFromJson(const QJsonObject& json) {
+    return utils::json::tryDecode<CityDTO>(json, cityFields);
+}
 
-    return dto;
+utils::json::Decoded<CityDTO> CityDTO::tryFromJson(utils::json::JsonReader& reader) {
+    return utils::json::tryDecode<CityDTO>(reader, cityFields);
 }
 
-}  // namespace pawspective::models
\ No newline at end of file
+}  // namespace pawspective::models
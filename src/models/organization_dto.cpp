@@ -1,55 +1,67 @@
-
 #include "../include/models/organization_dto.hpp"
-#include <QString>
-#include <optional>
+
+#include <tuple>
+
 #include "utils/json.hpp"
 
 namespace pawspective::models {
 
-QJsonObject OrganizationDTO::toJson() const {
-    QJsonObject json;
+namespace {
 
-    json["id"] = id;
-    json["name"] = name;
-    if (description.has_value()) {
-        json["description"] = description.value();
-    }
-    json["city"] = city.toJson();
+namespace json = utils::json;
 
-    return json;
-}
+constexpr auto organizationFields = std::tuple{
+    json::required("id", &OrganizationDTO::id),
+    json::interned(json::required("name", &OrganizationDTO::name)),
+    json::optional("description", &OrganizationDTO::description),
+    json::required("city", &OrganizationDTO::city),
+};
+
+// A missing items array is an empty page; an item that does not decode is left out and listed in rejectedItems.
+constexpr auto organizationListFields = std::tuple{
+    json::required("page", &OrganizationListDTO::page),
+    json::required("limit", &OrganizationListDTO::limit),
+    json::required("total_count", &OrganizationListDTO::totalCount),
+    json::required("total_pages", &OrganizationListDTO::totalPages),
+    json::skipInvalidItems(json::optional("items", &OrganizationListDTO::items), &OrganizationListDTO::rejectedItems),
+};
+
+}  // namespace
+
+QJsonObject OrganizationDTO::toJson() const { return utils::json::encode(*this, organizationFields); }
 
 OrganizationDTO OrganizationDTO::fromJson(const QJsonObject& json) {
-    OrganizationDTO dto;
+    return utils::json::decode<OrganizationDTO>(json, organizationFields);
+}
 
-    if (!json.contains("id") || json["id"].isNull() || !json["id"].isDouble()) {
-        throw std::invalid_argument("Invalid or missing id field");
-    }
-    dto.id = json["id"].toVariant().toLongLong();
-    if (!json.contains("name") || json["name"].isNull() || !json["name"].isString()) {
-        throw std::invalid_argument("Invalid or missing name field");
-    }
-    dto.name = json["name"].toString();
-    if (json.contains("description") && json["description"].isString() && !json["description"].isNull()) {
-        dto.description = json["description"].toString();
-    }
-    dto.city = CityDTO::fromJson(json["city"].toObject());
+OrganizationDTO OrganizationDTO::fromJson(utils::json::JsonReader& reader) {
+    return utils::json::decode<OrganizationDTO>(reader, organizationFields);
+}
 
-    return dto;
+utils::json::Decoded<OrganizationDTO> OrganizationDTO::tryFromJson(const QJsonObject& json) {
+    return utils::json::tryDecode<OrganizationDTO>(json, organizationFields);
 }
 
+utils::json::Decoded<OrganizationDTO> OrganizationDTO::tryFromJson(utils::json::JsonReader& reader) {
+    return utils::json::tryDecode<OrganizationDTO>(reader, organizationFields);
+}
+
+QJsonObject OrganizationListDTO::toJson() const { return utils::json::encode(*this, organizationListFields); }
+
 OrganizationListDTO OrganizationListDTO::fromJson(const QJsonObject& json) {
-    OrganizationListDTO dto;
-    dto.page = pawspective::utils::json::getRequiredInt32(json, "page");
-    dto.limit = pawspective::utils::json::getRequiredInt32(json, "limit");
-    dto.totalCount = pawspective::utils::json::getRequiredInt64(json, "total_count");
-    dto.totalPages = pawspective::utils::json::getRequiredInt64(json, "total_pages");
+    return utils::json::decode<OrganizationListDTO>(json, organizationListFields);
+}
+
+OrganizationListDTO OrganizationListDTO::fromJson(utils::json::JsonReader& reader) {
+    return utils::json::decode<OrganizationListDTO>(reader, organizationListFields);
+}
+
+utils::json::Decoded<OrganizationListDTO> OrganizationListDTO::tryFromJson(const QJsonObject& json) {
+    return utils::json::tryDecode<OrganizationListDTO>(json, organizationListFields);
+}
 
-    const QJsonArray items = json["items"].toArray();
-    for (const auto& item : items) {
-        dto.items.append(OrganizationDTO::fromJson(item.toObject()));
-    }
-    return dto;
+utils::json::Decoded<OrganizationListDTO> OrganizationListDTO::tryFromJson(utils::json::JsonReader& reader) {
+    return utils::json::tryDecode<OrganizationListDTO>(reader, organizationListFields);
 }
 
-}  // namespace pawspective::models
\ No newline at end of file
+}  // namespace pawspective::models
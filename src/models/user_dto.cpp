@@ -1,48 +1,31 @@
 #include "../include/models/user_dto.hpp"
-#include <QString>
-#include <optional>
+
+#include <tuple>
+
+#include "utils/json.hpp"
 
 namespace pawspective::models {
 
-QJsonObject UserDTO::toJson() const {
-    QJsonObject json;
+namespace {
 
-    json["id"] = id;
-    json["email"] = email;
-    json["first_name"] = firstName;
-    json["last_name"] = lastName;
-    if (organizationId.has_value()) {
-        json["organization_id"] = organizationId.value();
-    }
+namespace json = utils::json;
 
-    return json;
-}
+constexpr auto userFields = std::tuple{
+    json::required("id", &UserDTO::id),
+    json::required("email", &UserDTO::email),
+    json::required("first_name", &UserDTO::firstName),
+    json::required("last_name", &UserDTO::lastName),
+    json::optional("organization_id", &UserDTO::organizationId),
+};
 
-QString UserDTO::readString(const QJsonObject& json, const QString& key) {
-    if (!json.contains(key) || json[key].isNull() || !json[key].isString()) {
-        throw std::invalid_argument("Invalid or missing " + key.toStdString() + " field");
-    }
-    return json[key].toString();
-}
+}  // namespace
+
+QJsonObject UserDTO::toJson() const { return utils::json::encode(*this, userFields); }
+
+UserDTO UserDTO::fromJson(const QJsonObject& json) { return utils::json::decode<UserDTO>(json, userFields); }
 
-UserDTO UserDTO::fromJson(const QJsonObject& json) {
-    UserDTO dto;
-
-    if (!json.contains("id") || json["id"].isNull() || !json["id"].isDouble()) {
-        throw std::invalid_argument("Invalid or missing id field");
-    }
-    dto.id = json["id"].toVariant().toLongLong();
-    dto.email = readString(json, "email");
-    dto.firstName = readString(json, "first_name");
-    dto.lastName = readString(json, "last_name");
-    if (json.contains("organization_id") && !json["organization_id"].isNull()) {
-        if (!json["organization_id"].isDouble()) {
-            throw std::invalid_argument("organization_id must be a number");
-        }
-        dto.organizationId = json["organization_id"].toVariant().toLongLong();
-    }
-
-    return dto;
+utils::json::Decoded<UserDTO> UserDTO::tryFromJson(const QJsonObject& json) {
+    return utils::json::tryDecode<UserDTO>(json, userFields);
 }
 
-}  // namespace pawspective::models
\ No newline at end of file
+}  // namespace pawspective::models
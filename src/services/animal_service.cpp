@@ -1,11 +1,11 @@
 #include "services/animal_service.hpp"
 
+#include <QDebug>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
 #include <QList>
-#include <QNetworkReply>
 #include <QSharedPointer>
 #include <QUrl>
 #include <QUrlQuery>
@@ -15,22 +15,62 @@
 #include "models/animal_filter_dto.hpp"
 #include "services/errors.hpp"
 #include "services/i_network_client.hpp"
+#include "services/mutation_queue.hpp"
+#include "utils/trace.hpp"
 #include "validator.hpp"
 
 namespace pawspective::services {
 
 AnimalService::AnimalService(INetworkClient& networkClient, QObject* parent)
-    : QObject(parent), m_networkClient(networkClient) {}
+    : QObject(parent),
+      m_networkClient(networkClient),
+      m_animalLoader(
+          this,
+          [this](const QList<qint64>& ids, const RequestOptions& options, const BatchLoader::DoneHandler& unsupported) {
+              fetchAnimals(ids, options, unsupported);
+          },
+          [this](qint64 id, const RequestOptions& options, const BatchLoader::DoneHandler& done) {
+              fetchAnimal(id, options, done);
+          }
+      ) {}
 
-void AnimalService::handleError(QNetworkReply& reply, std::function<void(QSharedPointer<BaseError>)> onError) {
-    QByteArray data = reply.property("responseData").toByteArray();
+void AnimalService::setMutationQueue(MutationQueue* mutationQueue) {
+    if (m_mutationQueue != nullptr) {
+        disconnect(m_mutationQueue, nullptr, this, nullptr);
+    }
+    m_mutationQueue = mutationQueue;
+    if (m_mutationQueue == nullptr) {
+        return;
+    }
+    // Callers still waiting get their own error callback; this covers the ones that were told "queued".
+    connect(
+        m_mutationQueue,
+        &MutationQueue::mutationFailed,
+        this,
+        [this](const QString& kind, const QString&, const NetworkResponse& response) {
+            if (kind == "createAnimal") {
+                handleError(response, [this](QSharedPointer<BaseError> error) { emit createAnimalRejected(error); });
+            } else if (kind == "updateAnimal") {
+                handleError(response, [this](QSharedPointer<BaseError> error) { emit updateAnimalRejected(error); });
+            }
+        }
+    );
+}
+
+void AnimalService::setBatchingEnabled(bool enabled) { m_batchingEnabled = enabled; }
+
+void AnimalService::handleError(
+    const NetworkResponse& response,
+    std::function<void(QSharedPointer<BaseError>)> onError
+) {
+    const QByteArray& data = response.body;
     if (data.isEmpty()) {
         onError(QSharedPointer<UnknownError>::create("Empty response"));
         return;
     }
 
     QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+    QJsonDocument doc = response.parseJson(&parseError);
 
     if (parseError.error != QJsonParseError::NoError) {
         onError(QSharedPointer<UnknownError>::create(QString::fromUtf8(data)));
@@ -46,14 +86,13 @@ void AnimalService::handleError(QNetworkReply& reply, std::function<void(QShared
 }
 
 void AnimalService::handleSuccess(
-    QNetworkReply& reply,
+    const NetworkResponse& response,
     std::function<void(const QJsonObject&)> onSuccess,
     std::function<void(QSharedPointer<BaseError>)> onError
 ) {
     QJsonParseError parseError;
-    QByteArray data = reply.property("responseData").toByteArray();
     try {
-        QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+        QJsonDocument doc = response.parseJson(&parseError);
 
         if (parseError.error != QJsonParseError::NoError) {
             onError(
@@ -71,14 +110,13 @@ void AnimalService::handleSuccess(
 }
 
 void AnimalService::handleSuccessArray(
-    QNetworkReply& reply,
+    const NetworkResponse& response,
     std::function<void(const QJsonArray&)> onSuccess,
     std::function<void(QSharedPointer<BaseError>)> onError
 ) {
     QJsonParseError parseError;
-    QByteArray data = reply.property("responseData").toByteArray();
     try {
-        QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+        QJsonDocument doc = response.parseJson(&parseError);
 
         if (parseError.error != QJsonParseError::NoError) {
             onError(
@@ -100,7 +138,39 @@ void AnimalService::handleSuccessArray(
     }
 }
 
-void AnimalService::getAnimals(const models::AnimalFilterDTO& filter) {
+template <typename Dto>
+void AnimalService::handleDtoSuccess(
+    const NetworkResponse& response,
+    std::function<void(const models::Shared<Dto>&)> onSuccess,
+    std::function<void(QSharedPointer<BaseError>)> onError
+) {
+    utils::json::Decoded<Dto> dto = response.decodeJson<Dto>();
+    if (!dto) {
+        onError(QSharedPointer<BaseError>(new ClientJsonParseError(dto.error().toString())));
+        return;
+    }
+    onSuccess(models::Shared<Dto>(std::move(*dto)));
+}
+
+template <typename Dto>
+void AnimalService::handleListSuccess(
+    const NetworkResponse& response,
+    std::function<void(const models::Shared<Dto>&)> onSuccess,
+    std::function<void(QSharedPointer<BaseError>)> onError
+) {
+    utils::json::Decoded<Dto> dto = response.decodeJson<Dto>();
+    if (!dto) {
+        onError(QSharedPointer<BaseError>(new ClientJsonParseError(dto.error().toString())));
+        return;
+    }
+    // A page with a few bad items is still shown; the items themselves are only logged.
+    for (const auto& rejected : dto->rejectedItems) {
+        qWarning().noquote() << "Skipped item in" << response.url.path() << "-" << rejected.toString();
+    }
+    onSuccess(models::Shared<Dto>(std::move(*dto)));
+}
+
+void AnimalService::getAnimals(const models::AnimalFilterDTO& filter, const RequestOptions& options) {
     QUrl url("/animals");
     QUrlQuery query;
 
@@ -158,39 +228,98 @@ void AnimalService::getAnimals(const models::AnimalFilterDTO& filter) {
     qDebug() << "Requesting animals with URL:" << url.toString();
     m_networkClient.get(
         url,
-        [this](QNetworkReply& reply) {
-            handleSuccess(
-                reply,
-                [this](const QJsonObject& obj) { emit getAnimalsSuccess(models::AnimalListDTO::fromJson(obj)); },
+        [this](const NetworkResponse& response) {
+            PAWS_TRACE_SCOPE("AnimalService::getAnimals");
+            handleListSuccess<models::AnimalListDTO>(
+                response,
+                [this](const models::SharedAnimalList& result) { emit getAnimalsSuccess(result); },
                 [this](QSharedPointer<BaseError> error) { emit getAnimalsFailed(error); }
             );
         },
-        [this](QNetworkReply& reply) {
-            handleError(reply, [this](QSharedPointer<BaseError> error) { emit getAnimalsFailed(error); });
-        }
+        [this](const NetworkResponse& response) {
+            handleError(response, [this](QSharedPointer<BaseError> error) { emit getAnimalsFailed(error); });
+        },
+        options
     );
 }
 
-void AnimalService::getAnimal(qint64 id) {
+void AnimalService::getAnimal(qint64 id, const RequestOptions& options) {
+    if (m_batchingEnabled) {
+        m_animalLoader.load(id, options);
+        return;
+    }
+    fetchAnimal(id, options, {});
+}
+
+void AnimalService::fetchAnimal(qint64 id, const RequestOptions& options, const BatchLoader::DoneHandler& done) {
     m_networkClient.get(
         QUrl(QString("/animals/%1").arg(id)),
-        [this](QNetworkReply& reply) {
-            handleSuccess(
-                reply,
-                [this](const QJsonObject& obj) {
-                    models::AnimalDTO animal = models::AnimalDTO::fromJson(obj);
-                    emit getAnimalSuccess(animal);
-                },
-                [this](QSharedPointer<BaseError> error) { emit getAnimalFailed(error); }
+        [this, id, done](const NetworkResponse& response) {
+            handleDtoSuccess<models::AnimalDTO>(
+                response,
+                [this](const models::SharedAnimal& animal) { emit getAnimalSuccess(animal); },
+                [this, id](QSharedPointer<BaseError> error) { emit getAnimalFailed(error, id); }
             );
+            if (done) {
+                done();
+            }
         },
-        [this](QNetworkReply& reply) {
-            handleError(reply, [this](QSharedPointer<BaseError> error) { emit getAnimalFailed(error); });
-        }
+        [this, id, done](const NetworkResponse& response) {
+            handleError(response, [this, id](QSharedPointer<BaseError> error) { emit getAnimalFailed(error, id); });
+            if (done) {
+                done();
+            }
+        },
+        options
     );
 }
 
-void AnimalService::createAnimal(const models::AnimalRegisterDTO& dto) {
+void AnimalService::fetchAnimals(
+    const QList<qint64>& ids,
+    const RequestOptions& options,
+    const BatchLoader::DoneHandler& unsupported
+) {
+    m_networkClient.get(
+        BatchLoader::idsUrl("/animals", ids),
+        [this, ids, unsupported](const NetworkResponse& response) {
+            const QJsonDocument doc = response.parseJson();
+            if (!doc.isArray()) {
+                // The route exists but ignored ids= and answered with something else.
+                unsupported();
+                return;
+            }
+            const QList<qint64> missing = BatchLoader::deliverItems(
+                doc.array(),
+                ids,
+                [this](qint64 id, const QJsonObject& item, qsizetype index) {
+                    auto animal = models::AnimalDTO::tryFromJson(item);
+                    if (!animal) {
+                        const QString message = std::move(animal.error()).within(index).toString();
+                        emit getAnimalFailed(QSharedPointer<BaseError>(new ClientJsonParseError(message)), id);
+                        return;
+                    }
+                    emit getAnimalSuccess(models::SharedAnimal(std::move(*animal)));
+                }
+            );
+            for (qint64 id : missing) {
+                const QString message = QString("Animal %1 not found").arg(id);
+                emit getAnimalFailed(QSharedPointer<BaseError>(new AnimalNotFoundError(message)), id);
+            }
+        },
+        [this, ids, unsupported](const NetworkResponse& response) {
+            if (BatchLoader::isMissingEndpoint(response.statusCode)) {
+                unsupported();
+                return;
+            }
+            for (qint64 id : ids) {
+                handleError(response, [this, id](QSharedPointer<BaseError> error) { emit getAnimalFailed(error, id); });
+            }
+        },
+        options
+    );
+}
+
+void AnimalService::createAnimal(const models::AnimalRegisterDTO& dto, const RequestOptions& options) {
     utils::Validator validator;
     validator.field("name", dto.name.toStdString()).notBlank().maxLength(255);
     validator.field("age", std::to_string(dto.age)).inRange(0, 100);
@@ -201,26 +330,34 @@ void AnimalService::createAnimal(const models::AnimalRegisterDTO& dto) {
 
     const QJsonDocument doc(dto.toJson());
 
-    m_networkClient.post(
-        QUrl("/animals"),
-        doc.toJson(QJsonDocument::Compact),
-        [this](QNetworkReply& reply) {
-            handleSuccess(
-                reply,
-                [this](const QJsonObject& obj) {
-                    models::AnimalDTO animal = models::AnimalDTO::fromJson(obj);
-                    emit createAnimalSuccess(animal);
-                },
-                [this](QSharedPointer<BaseError> error) { emit createAnimalFailed(error); }
-            );
-        },
-        [this](QNetworkReply& reply) {
-            handleError(reply, [this](QSharedPointer<BaseError> error) { emit createAnimalFailed(error); });
-        }
-    );
+    auto onSuccess = [this](const NetworkResponse& response) {
+        handleDtoSuccess<models::AnimalDTO>(
+            response,
+            [this](const models::SharedAnimal& animal) { emit createAnimalSuccess(animal); },
+            [this](QSharedPointer<BaseError> error) { emit createAnimalFailed(error); }
+        );
+    };
+    auto onError = [this](const NetworkResponse& response) {
+        handleError(response, [this](QSharedPointer<BaseError> error) { emit createAnimalFailed(error); });
+    };
+
+    if (m_mutationQueue != nullptr) {
+        m_mutationQueue->enqueue(
+            "createAnimal",
+            "POST",
+            QUrl("/animals"),
+            doc.toJson(QJsonDocument::Compact),
+            onSuccess,
+            onError,
+            [this]() { emit createAnimalQueued(); },
+            options.priority
+        );
+        return;
+    }
+    m_networkClient.post(QUrl("/animals"), doc.toJson(QJsonDocument::Compact), onSuccess, onError, options);
 }
 
-void AnimalService::updateAnimal(qint64 id, const models::AnimalUpdateDTO& dto) {
+void AnimalService::updateAnimal(qint64 id, const models::AnimalUpdateDTO& dto, const RequestOptions& options) {
     utils::Validator validator;
     if (dto.name) {
         validator.field("name", dto.name->toStdString()).notBlank().maxLength(255);
@@ -235,31 +372,45 @@ void AnimalService::updateAnimal(qint64 id, const models::AnimalUpdateDTO& dto)
 
     const QJsonDocument doc(dto.toJson());
 
+    auto onSuccess = [this](const NetworkResponse& response) {
+        handleDtoSuccess<models::AnimalDTO>(
+            response,
+            [this](const models::SharedAnimal& animal) { emit updateAnimalSuccess(animal); },
+            [this](QSharedPointer<BaseError> error) { emit updateAnimalFailed(error); }
+        );
+    };
+    auto onError = [this](const NetworkResponse& response) {
+        handleError(response, [this](QSharedPointer<BaseError> error) { emit updateAnimalFailed(error); });
+    };
+
+    if (m_mutationQueue != nullptr) {
+        m_mutationQueue->enqueue(
+            "updateAnimal",
+            "PUT",
+            QUrl(QString("/animals/%1").arg(id)),
+            doc.toJson(QJsonDocument::Compact),
+            onSuccess,
+            onError,
+            [this]() { emit updateAnimalQueued(); },
+            options.priority
+        );
+        return;
+    }
     m_networkClient.put(
         QUrl(QString("/animals/%1").arg(id)),
         doc.toJson(QJsonDocument::Compact),
-        [this](QNetworkReply& reply) {
-            handleSuccess(
-                reply,
-                [this](const QJsonObject& obj) {
-                    models::AnimalDTO animal = models::AnimalDTO::fromJson(obj);
-                    emit updateAnimalSuccess(animal);
-                },
-                [this](QSharedPointer<BaseError> error) { emit updateAnimalFailed(error); }
-            );
-        },
-        [this](QNetworkReply& reply) {
-            handleError(reply, [this](QSharedPointer<BaseError> error) { emit updateAnimalFailed(error); });
-        }
+        onSuccess,
+        onError,
+        options
     );
 }
 
-void AnimalService::getAnimalFilters() {
+void AnimalService::getAnimalFilters(const RequestOptions& options) {
     m_networkClient.get(
         QUrl("/animals/filters"),
-        [this](QNetworkReply& reply) {
+        [this](const NetworkResponse& response) {
             handleSuccess(
-                reply,
+                response,
                 [this](const QJsonObject& obj) {
                     models::AnimalFilterDTO filters = models::AnimalFilterDTO::fromJson(obj);
                     emit getAnimalFiltersSuccess(filters);
@@ -267,13 +418,19 @@ void AnimalService::getAnimalFilters() {
                 [this](QSharedPointer<BaseError> error) { emit getAnimalFiltersFailed(error); }
             );
         },
-        [this](QNetworkReply& reply) {
-            handleError(reply, [this](QSharedPointer<BaseError> error) { emit getAnimalFiltersFailed(error); });
-        }
+        [this](const NetworkResponse& response) {
+            handleError(response, [this](QSharedPointer<BaseError> error) { emit getAnimalFiltersFailed(error); });
+        },
+        options
     );
 }
 
-void AnimalService::getAnimalsByOrganization(qint64 organizationId, int page, int limit) {
+void AnimalService::getAnimalsByOrganization(
+    qint64 organizationId,
+    int page,
+    int limit,
+    const RequestOptions& options
+) {
     QUrl url(QString("/orgs/%1/animals").arg(organizationId));
     QUrlQuery query;
     query.addQueryItem("page", QString::number(page));
@@ -282,18 +439,20 @@ void AnimalService::getAnimalsByOrganization(qint64 organizationId, int page, in
 
     m_networkClient.get(
         url,
-        [this](QNetworkReply& reply) {
-            handleSuccess(
-                reply,
-                [this](const QJsonObject& obj) {
-                    emit getAnimalsByOrganizationSuccess(models::AnimalListDTO::fromJson(obj));
-                },
+        [this](const NetworkResponse& response) {
+            handleListSuccess<models::AnimalListDTO>(
+                response,
+                [this](const models::SharedAnimalList& result) { emit getAnimalsByOrganizationSuccess(result); },
                 [this](QSharedPointer<BaseError> error) { emit getAnimalsByOrganizationFailed(error); }
             );
         },
-        [this](QNetworkReply& reply) {
-            handleError(reply, [this](QSharedPointer<BaseError> error) { emit getAnimalsByOrganizationFailed(error); });
-        }
+        [this](const NetworkResponse& response) {
+            handleError(
+                response,
+                [this](QSharedPointer<BaseError> error) { emit getAnimalsByOrganizationFailed(error); }
+            );
+        },
+        options
     );
 }
 
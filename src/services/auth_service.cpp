@@ -5,11 +5,11 @@
 #include <QJsonObject>
 #include <QJsonParseError>
 #include <QNetworkAccessManager>
-#include <QNetworkReply>
 #include <QObject>
 #include <QSharedPointer>
 #include <QString>
 #include <QUrl>
+#include <algorithm>
 #include <optional>
 #include "services/errors.hpp"
 #include "services/network_client.hpp"
@@ -39,75 +39,110 @@ std::optional<QJsonObject> parseJwtPayload(const QString& token) {
 
     return doc.object();
 }
+}  // namespace
 
-std::optional<int> extractTokenExpiration(const QString& token) {
-    auto payload = parseJwtPayload(token);
-    if (!payload.has_value()) {
-        return std::nullopt;
-    }
-
-    QJsonObject obj = payload.value();
-
-    if (obj.contains("exp")) {
-        qint64 exp = obj["exp"].toVariant().toLongLong();
-        qint64 now = QDateTime::currentSecsSinceEpoch();
-
-        int secondsLeft = static_cast<int>(exp - now);
+namespace pawspective::services {
 
-        return secondsLeft;
-    }
+AuthService::AuthService(NetworkClient& networkClient, QObject* parent)
+    : QObject(parent), m_networkClient(networkClient), m_userId(std::nullopt) {
+    connect(&m_networkClient, &NetworkClient::unauthorizedAccess, this, &AuthService::handleUnauthorizedAccess);
+    connect(&m_networkClient, &NetworkClient::invalidTokenDetected, this, [this]() { clearSession(); });
+    m_networkClient.setTokenProvider([this]() { return m_accessToken; });
+    m_networkClient.setUserId(m_userId);
 
-    return std::nullopt;
+    m_refreshTimer.setSingleShot(true);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &AuthService::refreshAhead);
 }
-std::optional<uint64_t> extractUserIdFromToken(const QString& token) {
+
+AuthService::TokenClaims AuthService::decodeClaims(const QString& token) {
+    TokenClaims claims;
     auto payload = parseJwtPayload(token);
     if (!payload.has_value()) {
-        return std::nullopt;
+        return claims;
     }
 
     QJsonObject obj = payload.value();
 
+    if (obj.contains("exp")) {
+        claims.expiresAt = obj["exp"].toVariant().toLongLong();
+    }
     if (obj.contains("sub")) {
         if (obj["sub"].isString()) {
-            return obj["sub"].toString().toULongLong();
+            claims.userId = obj["sub"].toString().toULongLong();
         } else if (obj["sub"].isDouble()) {
-            return static_cast<uint64_t>(obj["sub"].toDouble());
+            claims.userId = static_cast<uint64_t>(obj["sub"].toDouble());
         }
     }
 
-    return std::nullopt;
+    return claims;
 }
-}  // namespace
 
-namespace pawspective::services {
+void AuthService::applyTokens(const QString& accessToken, const QString& refreshToken) {
+    m_accessToken = accessToken;
+    m_refreshToken = refreshToken;
+    m_claims = decodeClaims(accessToken);
 
-AuthService::AuthService(NetworkClient& networkClient, QObject* parent)
-    : QObject(parent), m_networkClient(networkClient), m_userId(std::nullopt) {
-    connect(&m_networkClient, &NetworkClient::unauthorizedAccess, this, &AuthService::handleUnauthorizedAccess);
-    connect(&m_networkClient, &NetworkClient::invalidTokenDetected, this, [this]() { clearSession(); });
-    m_networkClient.setTokenProvider([this]() { return m_accessToken; });
-    m_networkClient.setUserId(m_userId);
+    if (m_claims.userId.has_value()) {
+        m_userId = m_claims.userId;
+        m_networkClient.setUserId(m_claims.userId);
+    }
+    scheduleRefresh();
+}
+
+void AuthService::scheduleRefresh() {
+    // QTimer takes an int of milliseconds, so long-lived tokens re-arm once a day until they get close.
+    static constexpr qint64 maxWaitSeconds = 24 * 60 * 60;
+
+    m_refreshTimer.stop();
+    if (m_refreshToken.isEmpty() || !m_claims.expiresAt.has_value()) {
+        return;
+    }
+    const qint64 secondsLeft = *m_claims.expiresAt - QDateTime::currentSecsSinceEpoch() - m_refreshMarginSeconds;
+    m_refreshTimer.start(static_cast<int>(std::clamp<qint64>(secondsLeft, 0, maxWaitSeconds) * 1000));
+}
+
+void AuthService::refreshAhead() {
+    if (m_isRefreshing || m_refreshToken.isEmpty()) {
+        return;
+    }
+    // A retry after a failed attempt goes ahead even if the claims say there is time left: the server disagreed.
+    if (m_refreshRetryMs == 0 && m_claims.expiresAt.has_value() &&
+        *m_claims.expiresAt - QDateTime::currentSecsSinceEpoch() > m_refreshMarginSeconds) {
+        scheduleRefresh();
+        return;
+    }
+    // Requests issued from here on wait for the new token instead of going out with one about to expire.
+    m_networkClient.holdRequests();
+    refreshToken(m_refreshToken);
+}
+
+void AuthService::setRefreshMargin(int seconds) {
+    m_refreshMarginSeconds = seconds;
+    scheduleRefresh();
 }
 
 void AuthService::clearSession() {
     m_isRefreshing = false;
+    m_refreshRetryMs = 0;
+    m_refreshTimer.stop();
     m_accessToken.clear();
     m_refreshToken.clear();
+    m_claims = {};
     m_userId = std::nullopt;
     m_networkClient.setUserId(std::nullopt);
     m_networkClient.clearPendingRequests();
     emit sessionEnded();
 }
 
-void AuthService::handleError(QNetworkReply& reply, std::function<void(QSharedPointer<BaseError>)> onError) {
+void AuthService::handleError(const NetworkResponse& response, std::function<void(QSharedPointer<BaseError>)> onError) {
     QJsonParseError parseError;
 
-    QByteArray data = reply.property("responseData").toByteArray();
+    const QByteArray& data = response.body;
     if (data.isEmpty()) {
         onError(QSharedPointer<UnknownError>::create("Empty response"));
         return;
     }
-    QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+    QJsonDocument doc = response.parseJson(&parseError);
     if (parseError.error != QJsonParseError::NoError) {
         onError(QSharedPointer<UnknownError>::create(QString::fromUtf8(data)));
         return;
@@ -116,18 +151,19 @@ void AuthService::handleError(QNetworkReply& reply, std::function<void(QSharedPo
     if (doc.isObject()) {
         auto error = ErrorFactory::createError(doc.object());
         onError(error);
+    } else {
+        onError(QSharedPointer<UnknownError>::create(QString::fromUtf8(data)));
     }
 }
 void AuthService::handleSuccess(
-    QNetworkReply& reply,
+    const NetworkResponse& response,
     std::function<void(const QJsonObject&)> onSuccess,
     std::function<void(QSharedPointer<BaseError>)> onError
 ) {
     QJsonParseError parseError;
-    QByteArray data = reply.property("responseData").toByteArray();
 
     try {
-        QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+        QJsonDocument doc = response.parseJson(&parseError);
 
         if (parseError.error != QJsonParseError::NoError) {
             auto error = QSharedPointer<BaseError>(new ClientJsonParseError(
@@ -164,30 +200,22 @@ void AuthService::login(const QString& email, const QString& password) {
     m_networkClient.post(
         url,
         data,
-        [this](QNetworkReply& reply) {
+        [this](const NetworkResponse& response) {
             handleSuccess(
-                reply,
+                response,
                 [this](const QJsonObject& obj) {
                     auto [accessToken, refreshToken, tokenType] = parseTokenResponse(obj);
+                    applyTokens(accessToken, refreshToken);
 
-                    m_accessToken = accessToken;
-                    m_refreshToken = refreshToken;
-
-                    auto userId = extractUserIdFromToken(accessToken);
-                    if (userId.has_value()) {
-                        uint64_t id = userId.value();
-                        m_userId = id;
-                        m_networkClient.setUserId(id);
-                    }
-
-                    emit loginSuccess(accessToken, refreshToken, tokenType, userId.value_or(0));
+                    emit loginSuccess(accessToken, refreshToken, tokenType, m_claims.userId.value_or(0));
                 },
                 [this](QSharedPointer<BaseError> error) { emit loginFailed(error); }
             );
         },
-        [this](QNetworkReply& reply) {
-            handleError(reply, [this](QSharedPointer<BaseError> error) { emit loginFailed(error); });
-        }
+        [this](const NetworkResponse& response) {
+            handleError(response, [this](QSharedPointer<BaseError> error) { emit loginFailed(error); });
+        },
+        RequestOptions{.priority = RequestPriority::Interactive, .requiresAuth = false}
     );
 }
 
@@ -202,15 +230,15 @@ void AuthService::logout() {
     m_networkClient.post(
         url,
         std::move(data),
-        [this](QNetworkReply& reply) {
+        [this](const NetworkResponse& response) {
             handleSuccess(
-                reply,
+                response,
                 [this](const QJsonObject&) { clearSession(); },
                 [this](QSharedPointer<BaseError> error) { emit logoutFailed(error); }
             );
         },
-        [this](QNetworkReply& reply) {
-            handleError(reply, [this](QSharedPointer<BaseError> error) { emit logoutFailed(error); });
+        [this](const NetworkResponse& response) {
+            handleError(response, [this](QSharedPointer<BaseError> error) { emit logoutFailed(error); });
         }
     );
 }
@@ -240,49 +268,53 @@ void AuthService::refreshToken(const QString& refreshToken) {
     m_networkClient.post(
         url,
         data,
-        [this](QNetworkReply& reply) {
+        [this](const NetworkResponse& response) {
             handleSuccess(
-                reply,
+                response,
                 [this](const QJsonObject& obj) {
                     auto [accessToken, refreshToken, tokenType] = parseTokenResponse(obj);
-
-                    m_accessToken = accessToken;
-                    m_refreshToken = refreshToken;
-
-                    auto userId = extractUserIdFromToken(accessToken);
-                    if (userId.has_value()) {
-                        uint64_t id = userId.value();
-                        m_userId = id;
-                        m_networkClient.setUserId(id);
-                    }
+                    m_refreshRetryMs = 0;
+                    applyTokens(accessToken, refreshToken);
 
                     m_isRefreshing = false;
                     m_networkClient.retryPendingRequests();
 
                     emit refreshSuccess(accessToken, refreshToken, tokenType);
                 },
-                [this](QSharedPointer<BaseError> error) {
-                    emit refreshFailed(error);
-                    clearSession();
-                }
+                [this](QSharedPointer<BaseError> error) { failRefresh(error, false); }
             );
         },
-        [this](QNetworkReply& reply) {
-            handleError(reply, [this](QSharedPointer<BaseError> error) {
-                emit refreshFailed(error);
-                clearSession();
+        [this](const NetworkResponse& response) {
+            const bool rejected = response.statusCode == 401 || response.statusCode == 403;
+            handleError(response, [this, rejected](QSharedPointer<BaseError> error) {
+                failRefresh(error, rejected || error.dynamicCast<RefreshTokenInvalidError>());
             });
-        }
+        },
+        RequestOptions{.priority = RequestPriority::Interactive, .requiresAuth = false}
     );
 }
 
+void AuthService::failRefresh(QSharedPointer<BaseError> error, bool rejected) {
+    m_isRefreshing = false;
+    emit refreshFailed(error);
+    if (rejected) {
+        clearSession();
+        return;
+    }
+    // Offline or a server hiccup says nothing about the refresh token. Held requests go out with the current token,
+    // which is often still valid for a proactive refresh, and the refresh is tried again with backoff.
+    m_refreshRetryMs = m_refreshRetryMs == 0 ? minRefreshRetryMs : qMin(m_refreshRetryMs * 2, maxRefreshRetryMs);
+    m_refreshTimer.start(m_refreshRetryMs);
+    m_networkClient.retryPendingRequests();
+}
+
 void AuthService::getCurrentUser() {
     QUrl url("/auth/me");
     m_networkClient.get(
         url,
-        [this](QNetworkReply& reply) {
+        [this](const NetworkResponse& response) {
             handleSuccess(
-                reply,
+                response,
                 [this](const QJsonObject& obj) {
                     models::UserDTO user = models::UserDTO::fromJson(obj);
 
@@ -296,14 +328,17 @@ void AuthService::getCurrentUser() {
                 [this](QSharedPointer<BaseError> error) { emit getCurrentUserFailed(error); }
             );
         },
-        [this](QNetworkReply& reply) {
-            handleError(reply, [this](QSharedPointer<BaseError> error) { emit getCurrentUserFailed(error); });
+        [this](const NetworkResponse& response) {
+            handleError(response, [this](QSharedPointer<BaseError> error) { emit getCurrentUserFailed(error); });
         }
     );
 }
 
+void AuthService::prewarmConnection() { m_networkClient.prewarm(); }
+
 void AuthService::handleUnauthorizedAccess() {
-    if (!m_refreshToken.isEmpty() && !m_isRefreshing) {
+    // After a failed attempt the retry timer decides when to try again; rejected requests stay held until then.
+    if (!m_refreshToken.isEmpty() && !m_isRefreshing && m_refreshRetryMs == 0) {
         refreshToken(m_refreshToken);
     }
 }
@@ -313,12 +348,8 @@ bool AuthService::isAuthenticated() const {
         return false;
     }
 
-    auto expiresIn = extractTokenExpiration(m_accessToken);
-    if (!expiresIn.has_value() || expiresIn.value() <= 0) {
-        return false;
-    }
-
-    return true;
+    // Claims are decoded once per token in applyTokens().
+    return m_claims.expiresAt.has_value() && *m_claims.expiresAt > QDateTime::currentSecsSinceEpoch();
 }
 
 std::tuple<QString, QString, QString> AuthService::parseTokenResponse(const QJsonObject& obj) {
@@ -0,0 +1,157 @@
+#include "services/batch_loader.hpp"
+
+#include <QDebug>
+#include <QPointer>
+#include <QStringList>
+#include <QTimer>
+#include <QUrlQuery>
+#include <algorithm>
+#include <utility>
+
+#include "utils/json.hpp"
+
+namespace pawspective::services {
+
+BatchLoader::BatchLoader(QObject* context, FetchMany fetchMany, FetchOne fetchOne)
+    : m_context(context), m_fetchMany(std::move(fetchMany)), m_fetchOne(std::move(fetchOne)) {}
+
+void BatchLoader::load(qint64 id, const RequestOptions& options) {
+    if (!options.supersedeKey.isEmpty()) {
+        m_callers.removeIf([&options](const Caller& caller) {
+            return caller.options.supersedeKey == options.supersedeKey;
+        });
+    }
+    m_callers.append({id, options});
+
+    if (!m_scheduled) {
+        m_scheduled = true;
+        QTimer::singleShot(0, m_context, [this]() { dispatch(); });
+    }
+}
+
+void BatchLoader::setMaxParallel(int maxParallel) { m_maxParallel = qMax(1, maxParallel); }
+
+bool BatchLoader::isBatchSupported() const { return m_batchSupported; }
+
+bool BatchLoader::isMissingEndpoint(int statusCode) {
+    return statusCode == 400 || statusCode == 404 || statusCode == 405 || statusCode == 501;
+}
+
+QUrl BatchLoader::idsUrl(const QString& path, const QList<qint64>& ids) {
+    QStringList idList;
+    for (qint64 id : ids) {
+        idList.append(QString::number(id));
+    }
+    QUrl url(path);
+    QUrlQuery query;
+    query.addQueryItem("ids", idList.join(','));
+    url.setQuery(query);
+    return url;
+}
+
+QList<qint64> BatchLoader::deliverItems(const QJsonArray& items, const QList<qint64>& ids, const ItemHandler& onItem) {
+    QList<qint64> missing = ids;
+    for (qsizetype i = 0; i < items.size(); ++i) {
+        const QJsonObject item = items[i].toObject();
+        const std::optional<qint64> id = utils::json::integralValue(item.value("id"));
+        if (!id || !missing.contains(*id)) {
+            qWarning().noquote() << QString("Skipped items[%1]: no requested id").arg(i);
+            continue;
+        }
+        missing.removeAll(*id);
+        onItem(*id, item, i);
+    }
+    return missing;
+}
+
+void BatchLoader::dispatch() {
+    m_scheduled = false;
+    QList<Caller> callers = std::exchange(m_callers, {});
+    callers.removeIf([](const Caller& caller) { return caller.options.cancellationToken.isCancelled(); });
+    callers = perId(callers);
+    if (callers.isEmpty()) {
+        return;
+    }
+    if (callers.size() == 1 || !m_batchSupported) {
+        enqueueSingles(callers);
+        return;
+    }
+
+    // The batch answers several callers, so no single caller's token or supersede key may cancel it; it only
+    // inherits the most urgent priority.
+    QList<qint64> ids;
+    RequestOptions options;
+    options.priority = callers.first().options.priority;
+    for (const auto& caller : callers) {
+        ids.append(caller.id);
+        options.priority = qMin(options.priority, caller.options.priority);
+    }
+    m_fetchMany(ids, options, [this, callers]() {
+        m_batchSupported = false;
+        enqueueSingles(callers);
+    });
+}
+
+QList<BatchLoader::Caller> BatchLoader::perId(const QList<Caller>& callers) {
+    QList<Caller> result;
+    for (const auto& caller : callers) {
+        auto it = std::find_if(result.begin(), result.end(), [&caller](const Caller& other) {
+            return other.id == caller.id;
+        });
+        if (it == result.end()) {
+            result.append(caller);
+            continue;
+        }
+        RequestOptions shared;
+        shared.priority = qMin(it->options.priority, caller.options.priority);
+        it->options = shared;
+    }
+    return result;
+}
+
+void BatchLoader::enqueueSingles(const QList<Caller>& callers) {
+    for (const auto& caller : callers) {
+        Single single{caller.id, caller.options, caller.options.cancellationToken};
+        single.options.cancellationToken = CancellationToken::create();
+        single.options.supersedeKey.clear();
+        if (!caller.options.supersedeKey.isEmpty()) {
+            // Also reaches a superseded single that is still waiting for a slot.
+            m_supersedeTokens.value(caller.options.supersedeKey).cancel();
+            m_supersedeTokens.insert(caller.options.supersedeKey, single.options.cancellationToken);
+        }
+        const CancellationToken token = single.options.cancellationToken;
+        single.callerSubscription = single.callerToken.subscribe([token]() { token.cancel(); });
+        m_singles.enqueue(single);
+    }
+    startSingles();
+}
+
+void BatchLoader::startSingles() {
+    while (m_singlesInFlight < m_maxParallel && !m_singles.isEmpty()) {
+        const Single single = m_singles.dequeue();
+        if (single.options.cancellationToken.isCancelled()) {
+            single.callerToken.unsubscribe(single.callerSubscription);
+            continue;
+        }
+        ++m_singlesInFlight;
+
+        // A cancelled or superseded request never reports back, so the slot is freed by whichever comes first.
+        auto released = QSharedPointer<bool>::create(false);
+        const QPointer<QObject> context = m_context;
+        const CancellationToken callerToken = single.callerToken;
+        const int callerSubscription = single.callerSubscription;
+        auto release = [this, context, released, callerToken, callerSubscription]() {
+            if (*released || context.isNull()) {
+                return;
+            }
+            *released = true;
+            callerToken.unsubscribe(callerSubscription);
+            --m_singlesInFlight;
+            startSingles();
+        };
+        single.options.cancellationToken.subscribe(release);
+        m_fetchOne(single.id, single.options, release);
+    }
+}
+
+}  // namespace pawspective::services
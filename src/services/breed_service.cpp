@@ -1,10 +1,10 @@
 #include "services/breed_service.hpp"
 
+#include <QDebug>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
-#include <QNetworkReply>
 #include <QSharedPointer>
 #include <QUrl>
 #include <QUrlQuery>
@@ -20,8 +20,11 @@ namespace pawspective::services {
 BreedService::BreedService(INetworkClient& networkClient, QObject* parent)
     : QObject(parent), m_networkClient(networkClient) {}
 
-void BreedService::handleError(QNetworkReply& reply, std::function<void(QSharedPointer<BaseError>)> onError) {
-    QByteArray data = reply.property("responseData").toByteArray();
+void BreedService::handleError(
+    const NetworkResponse& response,
+    std::function<void(QSharedPointer<BaseError>)> onError
+) {
+    const QByteArray& data = response.body;
 
     if (data.isEmpty()) {
         onError(QSharedPointer<UnknownError>::create("Empty response"));
@@ -29,7 +32,7 @@ void BreedService::handleError(QNetworkReply& reply, std::function<void(QSharedP
     }
 
     QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+    QJsonDocument doc = response.parseJson(&parseError);
 
     if (parseError.error != QJsonParseError::NoError) {
         onError(QSharedPointer<UnknownError>::create(QString::fromUtf8(data)));
@@ -45,14 +48,13 @@ void BreedService::handleError(QNetworkReply& reply, std::function<void(QSharedP
 }
 
 void BreedService::handleSuccess(
-    QNetworkReply& reply,
+    const NetworkResponse& response,
     std::function<void(const QJsonArray&)> onSuccess,
     std::function<void(QSharedPointer<BaseError>)> onError
 ) {
     QJsonParseError parseError;
-    QByteArray data = reply.property("responseData").toByteArray();
     try {
-        QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+        QJsonDocument doc = response.parseJson(&parseError);
 
         if (parseError.error != QJsonParseError::NoError) {
             onError(
@@ -74,7 +76,7 @@ void BreedService::handleSuccess(
     }
 }
 
-void BreedService::getBreedsByType(models::AnimalType type) {
+void BreedService::getBreedsByType(models::AnimalType type, const RequestOptions& options) {
     utils::Validator validator;
     validator.field("type", models::toApiString(type).toStdString()).notBlank();
     if (auto error = validator.getValidationError()) {
@@ -89,22 +91,28 @@ void BreedService::getBreedsByType(models::AnimalType type) {
 
     m_networkClient.get(
         url,
-        [this](QNetworkReply& reply) {
+        [this](const NetworkResponse& response) {
             handleSuccess(
-                reply,
+                response,
                 [this](const QJsonArray& array) {
                     QList<models::BreedDTO> breeds;
-                    for (const auto& value : array) {
-                        breeds.append(models::BreedDTO::fromJson(value.toObject()));
+                    for (qsizetype i = 0; i < array.size(); ++i) {
+                        auto breed = models::BreedDTO::tryFromJson(array[i].toObject());
+                        if (!breed) {
+                            qWarning().noquote() << "Skipped breed" << std::move(breed.error()).within(i).toString();
+                            continue;
+                        }
+                        breeds.append(std::move(*breed));
                     }
                     emit getBreedsByTypeSuccess(breeds);
                 },
                 [this](QSharedPointer<BaseError> error) { emit getBreedsByTypeFailed(error); }
             );
         },
-        [this](QNetworkReply& reply) {
-            handleError(reply, [this](QSharedPointer<BaseError> error) { emit getBreedsByTypeFailed(error); });
-        }
+        [this](const NetworkResponse& response) {
+            handleError(response, [this](QSharedPointer<BaseError> error) { emit getBreedsByTypeFailed(error); });
+        },
+        options
     );
 }
 
@@ -0,0 +1,43 @@
+#include "services/cancellation_token.hpp"
+
+#include <utility>
+
+namespace pawspective::services {
+
+CancellationToken CancellationToken::create() {
+    CancellationToken token;
+    token.m_state = QSharedPointer<State>::create();
+    return token;
+}
+
+bool CancellationToken::isValid() const { return !m_state.isNull(); }
+
+bool CancellationToken::isCancelled() const { return m_state && m_state->cancelled; }
+
+void CancellationToken::cancel() const {
+    if (!m_state || m_state->cancelled) {
+        return;
+    }
+    m_state->cancelled = true;
+    const QHash<int, Handler> handlers = std::exchange(m_state->handlers, {});
+    for (const auto& handler : handlers) {
+        handler();
+    }
+}
+
+int CancellationToken::subscribe(Handler handler) const {
+    if (!m_state || m_state->cancelled) {
+        return -1;
+    }
+    const int id = m_state->nextId++;
+    m_state->handlers.insert(id, std::move(handler));
+    return id;
+}
+
+void CancellationToken::unsubscribe(int id) const {
+    if (m_state) {
+        m_state->handlers.remove(id);
+    }
+}
+
+}  // namespace pawspective::services
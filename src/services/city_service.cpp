@@ -1,10 +1,10 @@
 #include "services/city_service.hpp"
 
+#include <QDebug>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
-#include <QNetworkReply>
 #include <QSharedPointer>
 #include <QUrl>
 
@@ -17,8 +17,8 @@ namespace pawspective::services {
 CityService::CityService(INetworkClient& networkClient, QObject* parent)
     : QObject(parent), m_networkClient(networkClient) {}
 
-void CityService::handleError(QNetworkReply& reply, std::function<void(QSharedPointer<BaseError>)> onError) {
-    QByteArray data = reply.property("responseData").toByteArray();
+void CityService::handleError(const NetworkResponse& response, std::function<void(QSharedPointer<BaseError>)> onError) {
+    const QByteArray& data = response.body;
 
     if (data.isEmpty()) {
         onError(QSharedPointer<UnknownError>::create("Empty response"));
@@ -26,7 +26,7 @@ void CityService::handleError(QNetworkReply& reply, std::function<void(QSharedPo
     }
 
     QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+    QJsonDocument doc = response.parseJson(&parseError);
 
     if (parseError.error != QJsonParseError::NoError) {
         onError(QSharedPointer<UnknownError>::create(QString::fromUtf8(data)));
@@ -42,14 +42,13 @@ void CityService::handleError(QNetworkReply& reply, std::function<void(QSharedPo
 }
 
 void CityService::handleSuccess(
-    QNetworkReply& reply,
+    const NetworkResponse& response,
     std::function<void(const QJsonArray&)> onSuccess,
     std::function<void(QSharedPointer<BaseError>)> onError
 ) {
     QJsonParseError parseError;
-    QByteArray data = reply.property("responseData").toByteArray();
     try {
-        QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+        QJsonDocument doc = response.parseJson(&parseError);
 
         if (parseError.error != QJsonParseError::NoError) {
             onError(
@@ -71,25 +70,31 @@ void CityService::handleSuccess(
     }
 }
 
-void CityService::getCities() {
+void CityService::getCities(const RequestOptions& options) {
     m_networkClient.get(
         QUrl("/city"),
-        [this](QNetworkReply& reply) {
+        [this](const NetworkResponse& response) {
             handleSuccess(
-                reply,
+                response,
                 [this](const QJsonArray& array) {
                     QList<models::CityDTO> cities;
-                    for (const auto& value : array) {
-                        cities.append(models::CityDTO::fromJson(value.toObject()));
+                    for (qsizetype i = 0; i < array.size(); ++i) {
+                        auto city = models::CityDTO::tryFromJson(array[i].toObject());
+                        if (!city) {
+                            qWarning().noquote() << "Skipped city" << std::move(city.error()).within(i).toString();
+                            continue;
+                        }
+                        cities.append(std::move(*city));
                     }
                     emit getCitiesSuccess(cities);
                 },
                 [this](QSharedPointer<BaseError> error) { emit getCitiesFailed(error); }
             );
         },
-        [this](QNetworkReply& reply) {
-            handleError(reply, [this](QSharedPointer<BaseError> error) { emit getCitiesFailed(error); });
-        }
+        [this](const NetworkResponse& response) {
+            handleError(response, [this](QSharedPointer<BaseError> error) { emit getCitiesFailed(error); });
+        },
+        options
     );
 }
 
@@ -0,0 +1,304 @@
+#include "services/har_recording.hpp"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonValue>
+#include <QSaveFile>
+#include <QUrlQuery>
+
+namespace pawspective::services {
+
+namespace {
+
+QJsonArray headersToJson(const HttpHeaders& headers) {
+    QJsonArray array;
+    for (const auto& [name, value] : headers) {
+        const QByteArray stored = HarRecording::isSensitiveHeader(name) ? QByteArray("<redacted>") : value;
+        array.append(QJsonObject{{"name", QString::fromLatin1(name)}, {"value", QString::fromLatin1(stored)}});
+    }
+    return array;
+}
+
+HttpHeaders headersFromJson(const QJsonArray& array) {
+    HttpHeaders headers;
+    headers.reserve(array.size());
+    for (const auto& header : array) {
+        headers.append({header["name"].toString().toLatin1(), header["value"].toString().toLatin1()});
+    }
+    return headers;
+}
+
+QByteArray headerValue(const HttpHeaders& headers, const QByteArray& name) {
+    for (const auto& [key, value] : headers) {
+        if (key.compare(name, Qt::CaseInsensitive) == 0) {
+            return value;
+        }
+    }
+    return {};
+}
+
+QJsonObject harLog(const QJsonArray& entries) {
+    return {
+        {"log",
+         QJsonObject{
+             {"version", "1.2"},
+             {"creator", QJsonObject{{"name", "pawspective"}, {"version", "1.0"}}},
+             {"entries", entries}
+         }}
+    };
+}
+
+// The compact document with no entries, split where the entries go.
+QPair<QByteArray, QByteArray> harLogFrame() {
+    const QByteArray empty = QJsonDocument(harLog({})).toJson(QJsonDocument::Compact);
+    const QByteArray marker = R"("entries":[)";
+    const qsizetype split = empty.indexOf(marker) + marker.size();
+    return {empty.left(split), empty.mid(split)};
+}
+
+bool redactFields(QJsonValue& value) {
+    bool redacted = false;
+    if (value.isObject()) {
+        QJsonObject object = value.toObject();
+        for (auto it = object.begin(); it != object.end(); ++it) {
+            if (HarRecording::isSensitiveField(it.key())) {
+                *it = "<redacted>";
+                redacted = true;
+            } else {
+                QJsonValue child = *it;
+                if (redactFields(child)) {
+                    *it = child;
+                    redacted = true;
+                }
+            }
+        }
+        value = object;
+    } else if (value.isArray()) {
+        QJsonArray array = value.toArray();
+        for (auto it = array.begin(); it != array.end(); ++it) {
+            QJsonValue child = *it;
+            if (redactFields(child)) {
+                *it = child;
+                redacted = true;
+            }
+        }
+        value = array;
+    }
+    return redacted;
+}
+
+// Bodies without credentials are kept byte for byte; a sign-in body that is not JSON is dropped as a whole.
+QByteArray redactBody(const QByteArray& body, const QUrl& url) {
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(body, &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        return !body.isEmpty() && url.path().startsWith("/auth/") ? QByteArray("<redacted>") : body;
+    }
+    QJsonValue value = doc.isObject() ? QJsonValue(doc.object()) : QJsonValue(doc.array());
+    if (!redactFields(value)) {
+        return body;
+    }
+    const QJsonDocument redacted = value.isObject() ? QJsonDocument(value.toObject()) : QJsonDocument(value.toArray());
+    return redacted.toJson(QJsonDocument::Compact);
+}
+
+// Bodies that are valid UTF-8 are stored as text so the file stays readable; anything else as base64.
+QJsonObject contentToJson(const QByteArray& body, const QByteArray& mimeType) {
+    QJsonObject content{{"size", body.size()}, {"mimeType", QString::fromLatin1(mimeType)}};
+    const QString text = QString::fromUtf8(body);
+    if (text.toUtf8() == body) {
+        content.insert("text", text);
+    } else {
+        content.insert("text", QString::fromLatin1(body.toBase64()));
+        content.insert("encoding", "base64");
+    }
+    return content;
+}
+
+QByteArray contentFromJson(const QJsonObject& content) {
+    const QString text = content["text"].toString();
+    return content["encoding"].toString() == "base64" ? QByteArray::fromBase64(text.toLatin1()) : text.toUtf8();
+}
+
+}  // namespace
+
+QJsonObject HarEntry::toJson() const {
+    QJsonArray queryString;
+    for (const auto& [name, value] : QUrlQuery(url).queryItems(QUrl::FullyDecoded)) {
+        queryString.append(QJsonObject{{"name", name}, {"value", value}});
+    }
+
+    QJsonObject request{
+        {"method", QString::fromLatin1(method)},
+        {"url", url.toString(QUrl::FullyEncoded)},
+        {"httpVersion", "HTTP/1.1"},
+        {"cookies", QJsonArray()},
+        {"headers", headersToJson(requestHeaders)},
+        {"queryString", queryString},
+        {"headersSize", -1},
+        {"bodySize", requestBody.size()}
+    };
+    if (!requestBody.isEmpty()) {
+        QJsonObject postData =
+            contentToJson(redactBody(requestBody, url), headerValue(requestHeaders, "Content-Type"));
+        postData.remove("size");
+        request.insert("postData", postData);
+    }
+
+    QJsonObject response{
+        {"status", status},
+        {"statusText", ""},
+        {"httpVersion", "HTTP/1.1"},
+        {"cookies", QJsonArray()},
+        {"headers", headersToJson(responseHeaders)},
+        {"content", contentToJson(redactBody(responseBody, url), headerValue(responseHeaders, "Content-Type"))},
+        {"redirectURL", ""},
+        {"headersSize", -1},
+        {"bodySize", responseBody.size()}
+    };
+    if (error != QNetworkReply::NoError) {
+        response.insert("_error", static_cast<int>(error));
+        response.insert("_errorString", errorString);
+    }
+
+    return {
+        {"startedDateTime", startedAt.toString(Qt::ISODateWithMs)},
+        {"time", blockedMs + waitMs + receiveMs},
+        {"request", request},
+        {"response", response},
+        {"cache", QJsonObject()},
+        {"timings",
+         QJsonObject{
+             {"blocked", blockedMs},
+             {"dns", -1},
+             {"connect", -1},
+             {"send", 0},
+             {"wait", waitMs},
+             {"receive", receiveMs},
+             {"ssl", -1}
+         }}
+    };
+}
+
+HarEntry HarEntry::fromJson(const QJsonObject& json) {
+    const QJsonObject request = json["request"].toObject();
+    const QJsonObject response = json["response"].toObject();
+    const QJsonObject timings = json["timings"].toObject();
+
+    HarEntry entry;
+    entry.startedAt = QDateTime::fromString(json["startedDateTime"].toString(), Qt::ISODateWithMs);
+    entry.method = request["method"].toString().toLatin1();
+    entry.url = QUrl(request["url"].toString(), QUrl::StrictMode);
+    entry.requestHeaders = headersFromJson(request["headers"].toArray());
+    entry.requestBody = contentFromJson(request["postData"].toObject());
+    entry.status = response["status"].toInt();
+    entry.responseHeaders = headersFromJson(response["headers"].toArray());
+    entry.responseBody = contentFromJson(response["content"].toObject());
+    entry.error = static_cast<QNetworkReply::NetworkError>(response["_error"].toInt(QNetworkReply::NoError));
+    entry.errorString = response["_errorString"].toString();
+    entry.blockedMs = qMax(0.0, timings["blocked"].toDouble());
+    entry.waitMs = qMax(0.0, timings["wait"].toDouble());
+    entry.receiveMs = qMax(0.0, timings["receive"].toDouble());
+    // Recordings from other tools may only carry the total.
+    if (!json.contains("timings")) {
+        entry.waitMs = qMax(0.0, json["time"].toDouble());
+    }
+    return entry;
+}
+
+void HarRecording::append(HarEntry entry) { m_entries.append(std::move(entry)); }
+
+void HarRecording::clear() {
+    m_entries.clear();
+    m_flushed = 0;
+}
+
+const QList<HarEntry>& HarRecording::entries() const { return m_entries; }
+
+QJsonObject HarRecording::toJson() const {
+    QJsonArray entries;
+    for (const auto& entry : m_entries) {
+        entries.append(entry.toJson());
+    }
+    return harLog(entries);
+}
+
+bool HarRecording::save(const QString& path) const {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Indented));
+    return file.commit();
+}
+
+bool HarRecording::flush(const QString& path) {
+    if (m_flushed == m_entries.size()) {
+        return true;
+    }
+    const auto [head, tail] = harLogFrame();
+    QByteArray entries;
+    for (qsizetype i = m_flushed; i < m_entries.size(); ++i) {
+        if (i > 0) {
+            entries += ',';
+        }
+        entries += QJsonDocument(m_entries[i].toJson()).toJson(QJsonDocument::Compact);
+    }
+
+    if (m_flushed > 0) {
+        // Overwrite the closing tail with the new entries and the tail again.
+        QFile file(path);
+        if (file.open(QIODevice::ReadWrite) && file.size() >= tail.size() && file.seek(file.size() - tail.size()) &&
+            file.read(tail.size()) == tail && file.seek(file.size() - tail.size())) {
+            if (file.write(entries + tail) != entries.size() + tail.size()) {
+                return false;
+            }
+            m_flushed = m_entries.size();
+            return true;
+        }
+        m_flushed = 0;
+        return flush(path);
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(head + entries + tail);
+    if (!file.commit()) {
+        return false;
+    }
+    m_flushed = m_entries.size();
+    return true;
+}
+
+std::optional<HarRecording> HarRecording::load(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::nullopt;
+    }
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc["log"].isObject()) {
+        return std::nullopt;
+    }
+
+    HarRecording recording;
+    for (const auto& entry : doc["log"]["entries"].toArray()) {
+        recording.append(HarEntry::fromJson(entry.toObject()));
+    }
+    return recording;
+}
+
+bool HarRecording::isSensitiveHeader(const QByteArray& name) {
+    const QByteArray lower = name.toLower();
+    return lower == "authorization" || lower == "cookie" || lower == "set-cookie";
+}
+
+bool HarRecording::isSensitiveField(const QString& name) {
+    const QString lower = name.toLower();
+    return lower.contains("password") || lower == "token" || lower.endsWith("_token");
+}
+
+}  // namespace pawspective::services
@@ -0,0 +1,137 @@
+#include "services/har_replay_client.hpp"
+
+#include <QTimer>
+#include <cmath>
+
+namespace pawspective::services {
+
+HarReplayClient::HarReplayClient(const HarRecording& recording, QObject* parent) : QObject(parent) {
+    for (const auto& entry : recording.entries()) {
+        m_entries[keyFor(entry.method, entry.url)].append(entry);
+    }
+}
+
+void HarReplayClient::get(
+    const QUrl& endpoint,
+    CallbackHandler onSuccess,
+    CallbackHandler onError,
+    const RequestOptions& options
+) {
+    replay("GET", endpoint, std::move(onSuccess), std::move(onError), options);
+}
+
+void HarReplayClient::post(
+    const QUrl& endpoint,
+    const QByteArray& /*data*/,
+    CallbackHandler onSuccess,
+    CallbackHandler onError,
+    const RequestOptions& options
+) {
+    replay("POST", endpoint, std::move(onSuccess), std::move(onError), options);
+}
+
+void HarReplayClient::put(
+    const QUrl& endpoint,
+    const QByteArray& /*data*/,
+    CallbackHandler onSuccess,
+    CallbackHandler onError,
+    const RequestOptions& options
+) {
+    replay("PUT", endpoint, std::move(onSuccess), std::move(onError), options);
+}
+
+void HarReplayClient::patch(
+    const QUrl& endpoint,
+    const QByteArray& /*data*/,
+    CallbackHandler onSuccess,
+    CallbackHandler onError,
+    const RequestOptions& options
+) {
+    replay("PATCH", endpoint, std::move(onSuccess), std::move(onError), options);
+}
+
+void HarReplayClient::deleteResource(
+    const QUrl& endpoint,
+    CallbackHandler onSuccess,
+    CallbackHandler onError,
+    const RequestOptions& options
+) {
+    replay("DELETE", endpoint, std::move(onSuccess), std::move(onError), options);
+}
+
+void HarReplayClient::setBaseUrl(const QUrl& url) { m_baseUrl = url; }
+
+void HarReplayClient::setLatencyScale(double scale) { m_latencyScale = qMax(0.0, scale); }
+
+const QStringList& HarReplayClient::unmatched() const { return m_unmatched; }
+
+void HarReplayClient::replay(
+    const QByteArray& method,
+    const QUrl& endpoint,
+    CallbackHandler onSuccess,
+    CallbackHandler onError,
+    const RequestOptions& options
+) {
+    const QUrl url = m_baseUrl.resolved(endpoint);
+    const QString key = keyFor(method, url);
+
+    // Same semantics as NetworkClient: a newer request under the same key silences the older one.
+    CancellationToken superseded;
+    if (!options.supersedeKey.isEmpty()) {
+        if (const auto previous = m_supersedeTokens.constFind(options.supersedeKey);
+            previous != m_supersedeTokens.cend()) {
+            previous->cancel();
+        }
+        superseded = CancellationToken::create();
+        m_supersedeTokens.insert(options.supersedeKey, superseded);
+    }
+
+    NetworkResponse response;
+    response.url = url;
+    response.timing = QSharedPointer<RequestTiming>::create();
+    response.timing->method = QString::fromLatin1(method);
+    response.timing->url = url.toString();
+    int delayMs = 0;
+
+    const auto recorded = m_entries.constFind(key);
+    if (recorded == m_entries.cend()) {
+        m_unmatched.append(key);
+        response.error = QNetworkReply::ContentNotFoundError;
+        response.errorString = QString("No recorded response for %1").arg(key);
+        response.body = QByteArray("Network error: ") + response.errorString.toUtf8();
+    } else {
+        qsizetype& served = m_served[key];
+        const HarEntry& entry = recorded->at(qMin(served, recorded->size() - 1));
+        ++served;
+        response.statusCode = entry.status;
+        response.error = entry.error;
+        response.errorString = entry.errorString;
+        response.body = entry.responseBody;
+        delayMs = static_cast<int>(std::lround(entry.latencyMs() * m_latencyScale));
+        response.timing->statusCode = entry.status;
+        response.timing->bytesReceived = entry.responseBody.size();
+        response.timing->firstByteMs = entry.waitMs * m_latencyScale;
+        response.timing->transferMs = entry.receiveMs * m_latencyScale;
+    }
+
+    const CancellationToken token = options.cancellationToken;
+    QTimer::singleShot(delayMs, this, [this, response, delayMs, token, superseded, onSuccess, onError]() {
+        if (token.isCancelled() || superseded.isCancelled()) {
+            return;
+        }
+        response.timing->startedAt = QDateTime::currentDateTime();
+        emit requestReplayed(response.url, response.statusCode, delayMs);
+        const bool succeeded =
+            response.error == QNetworkReply::NoError && response.statusCode >= 200 && response.statusCode < 300;
+        const CallbackHandler& handler = succeeded ? onSuccess : onError;
+        if (handler) {
+            handler(response);
+        }
+    });
+}
+
+QString HarReplayClient::keyFor(const QByteArray& method, const QUrl& url) {
+    return QString::fromLatin1(method) + ' ' + url.adjusted(QUrl::NormalizePathSegments).toString(QUrl::FullyEncoded);
+}
+
+}  // namespace pawspective::services
@@ -0,0 +1,65 @@
+#include "services/latency_tracker.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace pawspective::services {
+
+LatencyTracker::LatencyTracker() = default;
+
+std::size_t LatencyTracker::bucketOf(int milliseconds) {
+    const auto it = std::lower_bound(bucketBounds.cbegin(), bucketBounds.cend(), milliseconds);
+    return static_cast<std::size_t>(it - bucketBounds.cbegin());
+}
+
+void LatencyTracker::record(const QString& endpoint, int milliseconds) {
+    Window& window = m_windows[endpoint];
+    if (window.samples.size() < windowSize) {
+        window.samples.append(milliseconds);
+        ++window.histogram.samples;
+    } else {
+        --window.histogram.counts.at(bucketOf(window.samples.at(window.next)));
+        window.samples[window.next] = milliseconds;
+        window.next = (window.next + 1) % windowSize;
+    }
+    ++window.histogram.counts.at(bucketOf(milliseconds));
+}
+
+void LatencyTracker::clear() { m_windows.clear(); }
+
+QList<QString> LatencyTracker::endpoints() const { return m_windows.keys(); }
+
+LatencyTracker::Histogram LatencyTracker::histogram(const QString& endpoint) const {
+    return m_windows.value(endpoint).histogram;
+}
+
+int LatencyTracker::percentile(const QString& endpoint, double fraction) const {
+    const Histogram data = histogram(endpoint);
+    if (data.samples == 0) {
+        return 0;
+    }
+
+    // Interpolates linearly inside the bucket that holds the requested rank.
+    const double rank = std::clamp(fraction, 0.0, 1.0) * data.samples;
+    double seen = 0;
+    for (std::size_t index = 0; index < data.counts.size(); ++index) {
+        const int count = data.counts.at(index);
+        if (count > 0 && seen + count >= rank) {
+            const double lower = index == 0 ? 0 : bucketBounds.at(index - 1);
+            const double upper = index < bucketCount ? bucketBounds.at(index) : bucketBounds.back() * 2.0;
+            return static_cast<int>(std::ceil(lower + (upper - lower) * (rank - seen) / count));
+        }
+        seen += count;
+    }
+    return bucketBounds.back();
+}
+
+int LatencyTracker::timeoutFor(const QString& endpoint, const TimeoutPolicy& policy) const {
+    if (histogram(endpoint).samples < policy.minSamples) {
+        return policy.defaultMs;
+    }
+    const double timeout = percentile(endpoint, policy.percentile) * policy.multiplier;
+    return std::clamp(static_cast<int>(timeout), policy.floorMs, policy.ceilingMs);
+}
+
+}  // namespace pawspective::services
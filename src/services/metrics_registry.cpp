@@ -0,0 +1,169 @@
+#include "services/metrics_registry.hpp"
+
+#include <QMutexLocker>
+#include <array>
+#include <bit>
+
+namespace pawspective::services {
+
+namespace {
+
+// Prometheus bucket bounds in seconds; the HDR buckets are folded into these on export.
+constexpr std::array<double, 14> exportBounds{
+    0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10,
+};
+
+QString escapeLabel(QString value) {
+    return value.replace('\\', "\\\\").replace('"', "\\\"").replace('\n', "\\n");
+}
+
+}  // namespace
+
+qsizetype HdrHistogram::bucketOf(qint64 value) {
+    const auto unsignedValue = static_cast<quint64>(qMax<qint64>(0, value));
+    if (unsignedValue < 2 * subBuckets) {
+        return static_cast<qsizetype>(unsignedValue);
+    }
+    const int exponent = std::bit_width(unsignedValue) - 1;
+    const int shift = exponent - std::countr_zero(static_cast<unsigned>(subBuckets));
+    const auto sub = static_cast<qsizetype>((unsignedValue >> shift) & (subBuckets - 1));
+    return 2 * subBuckets + static_cast<qsizetype>(shift - 1) * subBuckets + sub;
+}
+
+qint64 HdrHistogram::upperBoundOf(qsizetype bucket) {
+    if (bucket < 2 * subBuckets) {
+        return bucket;
+    }
+    const qsizetype shift = (bucket - 2 * subBuckets) / subBuckets + 1;
+    const qsizetype sub = (bucket - 2 * subBuckets) % subBuckets;
+    return ((subBuckets + sub + 1) << shift) - 1;
+}
+
+void HdrHistogram::record(qint64 value) {
+    const qsizetype bucket = bucketOf(value);
+    if (static_cast<std::size_t>(bucket) >= m_buckets.size()) {
+        m_buckets.resize(bucket + 1);
+    }
+    ++m_buckets[bucket];
+    ++m_count;
+    m_sum += qMax<qint64>(0, value);
+    m_max = qMax(m_max, value);
+}
+
+qint64 HdrHistogram::percentile(double fraction) const {
+    if (m_count == 0) {
+        return 0;
+    }
+    const auto target = static_cast<quint64>(qBound(0.0, fraction, 1.0) * static_cast<double>(m_count - 1)) + 1;
+    quint64 seen = 0;
+    for (std::size_t i = 0; i < m_buckets.size(); ++i) {
+        seen += m_buckets[i];
+        if (seen >= target) {
+            return qMin(upperBoundOf(static_cast<qsizetype>(i)), m_max);
+        }
+    }
+    return m_max;
+}
+
+quint64 HdrHistogram::countAtOrBelow(qint64 bound) const {
+    quint64 total = 0;
+    for (std::size_t i = 0; i < m_buckets.size() && upperBoundOf(static_cast<qsizetype>(i)) <= bound; ++i) {
+        total += m_buckets[i];
+    }
+    return total;
+}
+
+MetricsRegistry& MetricsRegistry::global() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+void MetricsRegistry::setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+
+void MetricsRegistry::describe(const QString& name, const QString& help) {
+    const QMutexLocker lock(&m_mutex);
+    m_help.insert(name, help);
+}
+
+void MetricsRegistry::increment(const QString& name, const Labels& labels, double by) {
+    if (!isEnabled()) {
+        return;
+    }
+    const QMutexLocker lock(&m_mutex);
+    m_counters[name][labelString(labels)] += by;
+}
+
+void MetricsRegistry::observeMs(const QString& name, const Labels& labels, double milliseconds) {
+    if (!isEnabled() || milliseconds < 0) {
+        return;
+    }
+    const QMutexLocker lock(&m_mutex);
+    m_histograms[name][labelString(labels)].record(static_cast<qint64>(milliseconds * 1000));
+}
+
+double MetricsRegistry::counter(const QString& name, const Labels& labels) const {
+    const QMutexLocker lock(&m_mutex);
+    return m_counters.value(name).value(labelString(labels));
+}
+
+HdrHistogram MetricsRegistry::histogram(const QString& name, const Labels& labels) const {
+    const QMutexLocker lock(&m_mutex);
+    return m_histograms.value(name).value(labelString(labels));
+}
+
+QString MetricsRegistry::labelString(const Labels& labels) {
+    QStringList parts;
+    parts.reserve(labels.size());
+    for (const auto& [key, value] : labels) {
+        parts.append(QString("%1=\"%2\"").arg(key, escapeLabel(value)));
+    }
+    return parts.join(',');
+}
+
+QByteArray MetricsRegistry::toPrometheus() const {
+    const QMutexLocker lock(&m_mutex);
+    QString out;
+    const auto header = [this, &out](const QString& name, const char* type) {
+        if (const auto help = m_help.constFind(name); help != m_help.cend()) {
+            out += QString("# HELP %1 %2\n").arg(name, *help);
+        }
+        out += QString("# TYPE %1 %2\n").arg(name, QString::fromLatin1(type));
+    };
+    const auto withLabels = [](const QString& labels, const QString& extra = {}) {
+        const QString all = labels.isEmpty() ? extra : (extra.isEmpty() ? labels : labels + ',' + extra);
+        return all.isEmpty() ? QString() : '{' + all + '}';
+    };
+
+    for (auto family = m_counters.cbegin(); family != m_counters.cend(); ++family) {
+        header(family.key(), "counter");
+        for (auto series = family->cbegin(); series != family->cend(); ++series) {
+            out += family.key() + withLabels(series.key()) + ' ' + QString::number(series.value(), 'g', 15) + '\n';
+        }
+    }
+    for (auto family = m_histograms.cbegin(); family != m_histograms.cend(); ++family) {
+        header(family.key(), "histogram");
+        for (auto series = family->cbegin(); series != family->cend(); ++series) {
+            const HdrHistogram& histogram = series.value();
+            for (double bound : exportBounds) {
+                const auto count = histogram.countAtOrBelow(static_cast<qint64>(bound * 1e6));
+                out += family.key() + "_bucket" + withLabels(series.key(), QString("le=\"%1\"").arg(bound)) + ' ' +
+                       QString::number(count) + '\n';
+            }
+            out += family.key() + "_bucket" + withLabels(series.key(), "le=\"+Inf\"") + ' ' +
+                   QString::number(histogram.count()) + '\n';
+            out += family.key() + "_sum" + withLabels(series.key()) + ' ' +
+                   QString::number(static_cast<double>(histogram.sum()) / 1e6, 'g', 15) + '\n';
+            out += family.key() + "_count" + withLabels(series.key()) + ' ' + QString::number(histogram.count()) +
+                   '\n';
+        }
+    }
+    return out.toUtf8();
+}
+
+void MetricsRegistry::clear() {
+    const QMutexLocker lock(&m_mutex);
+    m_counters.clear();
+    m_histograms.clear();
+}
+
+}  // namespace pawspective::services
@@ -0,0 +1,67 @@
+#include "services/metrics_server.hpp"
+
+#include <QSaveFile>
+#include <QTcpSocket>
+
+namespace pawspective::services {
+
+namespace {
+
+constexpr qsizetype maxRequestHeaderSize = 8192;
+
+}  // namespace
+
+MetricsServer::MetricsServer(MetricsRegistry& registry, QObject* parent) : QObject(parent), m_registry(registry) {
+    connect(&m_server, &QTcpServer::newConnection, this, &MetricsServer::handleConnection);
+    connect(&m_dumpTimer, &QTimer::timeout, this, &MetricsServer::dump);
+}
+
+bool MetricsServer::listen(quint16 port) { return m_server.listen(QHostAddress::LocalHost, port); }
+
+quint16 MetricsServer::port() const { return m_server.serverPort(); }
+
+void MetricsServer::setDumpFile(const QString& path, int intervalMs) {
+    m_dumpFile = path;
+    if (m_dumpFile.isEmpty() || intervalMs <= 0) {
+        m_dumpTimer.stop();
+        return;
+    }
+    m_dumpTimer.start(intervalMs);
+}
+
+bool MetricsServer::dump() const {
+    QSaveFile file(m_dumpFile);
+    if (m_dumpFile.isEmpty() || !file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(m_registry.toPrometheus());
+    return file.commit();
+}
+
+void MetricsServer::handleConnection() {
+    while (QTcpSocket* socket = m_server.nextPendingConnection()) {
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QTcpSocket::readyRead, socket, [this, socket]() {
+            // One request per connection; only the request line matters.
+            if (!socket->canReadLine()) {
+                if (socket->bytesAvailable() > maxRequestHeaderSize) {
+                    socket->abort();
+                }
+                return;
+            }
+            const QList<QByteArray> requestLine = socket->readLine().trimmed().split(' ');
+            const bool isMetrics = requestLine.size() >= 2 && requestLine.at(0) == "GET" &&
+                                   (requestLine.at(1) == "/metrics" || requestLine.at(1).startsWith("/metrics?"));
+
+            const QByteArray body = isMetrics ? m_registry.toPrometheus() : QByteArray("Not found\n");
+            QByteArray response = isMetrics ? "HTTP/1.1 200 OK\r\n" : "HTTP/1.1 404 Not Found\r\n";
+            response += isMetrics ? "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                                  : "Content-Type: text/plain; charset=utf-8\r\n";
+            response += "Content-Length: " + QByteArray::number(body.size()) + "\r\nConnection: close\r\n\r\n";
+            socket->write(response + body);
+            socket->disconnectFromHost();
+        });
+    }
+}
+
+}  // namespace pawspective::services
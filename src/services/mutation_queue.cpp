@@ -0,0 +1,278 @@
+#include "services/mutation_queue.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkInformation>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QUuid>
+#include <utility>
+
+namespace pawspective::services {
+
+MutationQueue::MutationQueue(INetworkClient& networkClient, QObject* parent)
+    : QObject(parent), m_networkClient(networkClient) {
+    m_retryTimer.setSingleShot(true);
+    connect(&m_retryTimer, &QTimer::timeout, this, &MutationQueue::resume);
+
+    if (QNetworkInformation::loadDefaultBackend()) {
+        connect(
+            QNetworkInformation::instance(),
+            &QNetworkInformation::reachabilityChanged,
+            this,
+            [this](QNetworkInformation::Reachability reachability) {
+                if (reachability == QNetworkInformation::Reachability::Online) {
+                    resume();
+                }
+            }
+        );
+    }
+}
+
+void MutationQueue::setStorageFile(const QString& path) {
+    // Replies to a send from the old log must not touch the entries loaded below.
+    ++m_sendGeneration;
+    m_sending = false;
+    m_retryTimer.stop();
+    m_retryDelayMs = minRetryDelayMs;
+    // Callers still waiting get their answer now; the outcome can no longer reach them.
+    reportQueued();
+
+    m_storageFile = path;
+    m_entries.clear();
+    load();
+    emit pendingCountChanged();
+}
+
+void MutationQueue::setUserId(std::optional<uint64_t> userId) {
+    QString path;
+    if (userId.has_value()) {
+        path = QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation))
+                   .filePath(QString("mutations-%1.log").arg(*userId));
+    }
+    setStorageFile(path);
+}
+
+QString MutationQueue::enqueue(
+    const QString& kind,
+    const QByteArray& method,
+    const QUrl& endpoint,
+    const QByteArray& body,
+    CallbackHandler onSuccess,
+    CallbackHandler onError,
+    QueuedHandler onQueued,
+    RequestPriority priority
+) {
+    Mutation mutation{QUuid::createUuid().toString(QUuid::WithoutBraces), kind, method, endpoint, body, priority};
+    appendRecord(
+        {{"op", "add"},
+         {"key", mutation.idempotencyKey},
+         {"kind", mutation.kind},
+         {"method", QString::fromLatin1(mutation.method)},
+         {"endpoint", mutation.endpoint.toString()},
+         {"body", QString::fromUtf8(mutation.body)},
+         {"priority", static_cast<int>(mutation.priority)}}
+    );
+    const QString key = mutation.idempotencyKey;
+    m_entries.append({std::move(mutation), std::move(onSuccess), std::move(onError), std::move(onQueued)});
+    emit pendingCountChanged();
+
+    if (m_retryTimer.isActive()) {
+        // Already offline: report straight away instead of waiting behind the head entry.
+        if (m_entries.last().onQueued) {
+            std::exchange(m_entries.last().onQueued, {})();
+            m_entries.last().onSuccess = {};
+            m_entries.last().onError = {};
+        }
+    } else {
+        sendHead();
+    }
+    return key;
+}
+
+QList<MutationQueue::Mutation> MutationQueue::pending() const {
+    QList<Mutation> mutations;
+    mutations.reserve(m_entries.size());
+    for (const auto& entry : m_entries) {
+        mutations.append(entry.mutation);
+    }
+    return mutations;
+}
+
+qsizetype MutationQueue::pendingCount() const { return m_entries.size(); }
+
+void MutationQueue::resume() {
+    m_retryTimer.stop();
+    sendHead();
+}
+
+bool MutationQueue::isTransient(const NetworkResponse& response) {
+    // 401 included: the session may simply not be restored yet, and the mutation is still wanted after login.
+    return response.statusCode == 0 || response.statusCode == 401 || response.statusCode == 408 ||
+           response.statusCode == 429 || response.statusCode >= 500;
+}
+
+RequestPriority MutationQueue::priorityFrom(const QJsonValue& value) {
+    // Logs written before the priority was recorded hold user edits, which were always sent as interactive.
+    const int priority = value.toInt(static_cast<int>(RequestPriority::Interactive));
+    if (priority < 0 || priority > static_cast<int>(RequestPriority::Background)) {
+        return RequestPriority::Interactive;
+    }
+    return static_cast<RequestPriority>(priority);
+}
+
+void MutationQueue::sendHead() {
+    if (m_sending || m_entries.isEmpty()) {
+        return;
+    }
+    m_sending = true;
+
+    const Mutation& mutation = m_entries.first().mutation;
+    RequestOptions options;
+    options.priority = mutation.priority;
+    options.idempotencyKey = mutation.idempotencyKey.toLatin1();
+
+    auto onSuccess = [this, generation = m_sendGeneration](const NetworkResponse& response) {
+        if (generation == m_sendGeneration) {
+            handleSuccess(response);
+        }
+    };
+    auto onError = [this, generation = m_sendGeneration](const NetworkResponse& response) {
+        if (generation == m_sendGeneration) {
+            handleError(response);
+        }
+    };
+    if (mutation.method == "PUT") {
+        m_networkClient.put(mutation.endpoint, mutation.body, onSuccess, onError, options);
+    } else if (mutation.method == "PATCH") {
+        m_networkClient.patch(mutation.endpoint, mutation.body, onSuccess, onError, options);
+    } else {
+        m_networkClient.post(mutation.endpoint, mutation.body, onSuccess, onError, options);
+    }
+}
+
+void MutationQueue::handleSuccess(const NetworkResponse& response) {
+    m_sending = false;
+    m_retryDelayMs = minRetryDelayMs;
+    const Entry entry = m_entries.first();
+    completeHead();
+
+    if (entry.onSuccess) {
+        entry.onSuccess(response);
+    } else {
+        emit mutationCompleted(entry.mutation.kind, entry.mutation.idempotencyKey, response);
+    }
+    sendHead();
+}
+
+void MutationQueue::handleError(const NetworkResponse& response) {
+    m_sending = false;
+
+    if (isTransient(response)) {
+        // The caller can return now; the mutation stays at the head and is reported through the signals later.
+        reportQueued();
+        m_retryTimer.start(m_retryDelayMs);
+        m_retryDelayMs = qMin(m_retryDelayMs * 2, maxRetryDelayMs);
+        return;
+    }
+
+    // Rejected by the server: replaying cannot succeed, so it leaves the queue and the next one goes.
+    const Entry entry = m_entries.first();
+    completeHead();
+    if (entry.onError) {
+        entry.onError(response);
+    } else {
+        emit mutationFailed(entry.mutation.kind, entry.mutation.idempotencyKey, response);
+    }
+    sendHead();
+}
+
+void MutationQueue::reportQueued() {
+    for (auto& entry : m_entries) {
+        if (entry.onQueued) {
+            std::exchange(entry.onQueued, {})();
+            entry.onSuccess = {};
+            entry.onError = {};
+        }
+    }
+}
+
+void MutationQueue::completeHead() {
+    const Entry entry = m_entries.takeFirst();
+    if (m_entries.isEmpty()) {
+        compact();
+    } else {
+        appendRecord({{"op", "done"}, {"key", entry.mutation.idempotencyKey}});
+    }
+    emit pendingCountChanged();
+}
+
+void MutationQueue::load() {
+    QFile file(m_storageFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    while (!file.atEnd()) {
+        // A torn last line from a crash mid-write does not parse and is skipped.
+        const QJsonObject record = QJsonDocument::fromJson(file.readLine()).object();
+        const QString key = record["key"].toString();
+        if (record["op"].toString() == "add") {
+            m_entries.append(
+                {{key,
+                  record["kind"].toString(),
+                  record["method"].toString().toLatin1(),
+                  QUrl(record["endpoint"].toString()),
+                  record["body"].toString().toUtf8(),
+                  priorityFrom(record["priority"])},
+                 {},
+                 {},
+                 {}}
+            );
+        } else if (record["op"].toString() == "done") {
+            m_entries.removeIf([&key](const Entry& entry) { return entry.mutation.idempotencyKey == key; });
+        }
+    }
+    file.close();
+    compact();
+}
+
+void MutationQueue::appendRecord(const QJsonObject& record) {
+    if (m_storageFile.isEmpty()) {
+        return;
+    }
+    QDir().mkpath(QFileInfo(m_storageFile).absolutePath());
+    QFile file(m_storageFile);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        file.write(QJsonDocument(record).toJson(QJsonDocument::Compact) + '\n');
+        file.flush();
+    }
+}
+
+void MutationQueue::compact() {
+    if (m_storageFile.isEmpty()) {
+        return;
+    }
+    QDir().mkpath(QFileInfo(m_storageFile).absolutePath());
+    QSaveFile file(m_storageFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    for (const auto& entry : m_entries) {
+        const QJsonObject record{
+            {"op", "add"},
+            {"key", entry.mutation.idempotencyKey},
+            {"kind", entry.mutation.kind},
+            {"method", QString::fromLatin1(entry.mutation.method)},
+            {"endpoint", entry.mutation.endpoint.toString()},
+            {"body", QString::fromUtf8(entry.mutation.body)},
+            {"priority", static_cast<int>(entry.mutation.priority)}
+        };
+        file.write(QJsonDocument(record).toJson(QJsonDocument::Compact) + '\n');
+    }
+    file.commit();
+}
+
+}  // namespace pawspective::services
@@ -1,38 +1,272 @@
 #include "services/network_client.hpp"
 
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
 #include <QNetworkCookieJar>
 #include <QNetworkReply>
+#include <QSaveFile>
+#include <QSslSocket>
+#include <QStandardPaths>
+#include <QTimer>
+#include <algorithm>
 #include "services/errors.hpp"
+#include "services/metrics_registry.hpp"
+#include "utils/string_pool.hpp"
+#include "utils/trace.hpp"
 
 namespace pawspective::services {
 
-NetworkClient::NetworkClient(QObject* parent) : QObject(parent) { m_manager.setCookieJar(new QNetworkCookieJar(this)); }
+namespace {
+
+bool isIdempotent(HttpMethod method) {
+    return method == HttpMethod::Get || method == HttpMethod::Put || method == HttpMethod::Delete;
+}
+
+bool isTransient(QNetworkReply::NetworkError error) {
+    switch (error) {
+        case QNetworkReply::ConnectionRefusedError:
+        case QNetworkReply::RemoteHostClosedError:
+        case QNetworkReply::TimeoutError:
+        case QNetworkReply::OperationCanceledError:  // transfer timeout; deliberate aborts never reach the handler
+        case QNetworkReply::TemporaryNetworkFailureError:
+        case QNetworkReply::NetworkSessionFailedError:
+        case QNetworkReply::ProxyConnectionClosedError:
+        case QNetworkReply::ProxyTimeoutError:
+        case QNetworkReply::UnknownNetworkError:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Numeric path segments become {id}, so /animals/12 and /animals/13 share one set of counters.
+QString endpointTemplate(const QUrl& url) {
+    QStringList segments = url.path().split('/');
+    for (auto& segment : segments) {
+        bool isNumber = false;
+        segment.toLongLong(&isNumber);
+        if (isNumber) {
+            segment = "{id}";
+        }
+    }
+    return segments.join('/');
+}
+
+QString methodName(HttpMethod method) {
+    switch (method) {
+        case HttpMethod::Get:
+            return "GET";
+        case HttpMethod::Post:
+            return "POST";
+        case HttpMethod::Put:
+            return "PUT";
+        case HttpMethod::Patch:
+            return "PATCH";
+        case HttpMethod::Delete:
+            return "DELETE";
+    }
+    return {};
+}
+
+double elapsedMs(const QElapsedTimer& timer) { return static_cast<double>(timer.nsecsElapsed()) / 1e6; }
+
+// Retry-After is either delta-seconds or an HTTP-date.
+std::optional<qint64> retryAfterMs(const QNetworkReply& reply) {
+    const QByteArray value = reply.rawHeader("Retry-After").trimmed();
+    if (value.isEmpty()) {
+        return std::nullopt;
+    }
+    bool isNumber = false;
+    const qint64 seconds = value.toLongLong(&isNumber);
+    if (isNumber) {
+        return qMax<qint64>(0, seconds) * 1000;
+    }
+    const QDateTime date = QDateTime::fromString(QString::fromLatin1(value), Qt::RFC2822Date);
+    if (!date.isValid()) {
+        return std::nullopt;
+    }
+    return qMax<qint64>(0, QDateTime::currentDateTimeUtc().msecsTo(date));
+}
+
+}  // namespace
+
+NetworkClient::NetworkClient(QObject* parent, const QString& cacheDirectory) : QObject(parent) {
+    m_manager.setCookieJar(new QNetworkCookieJar(this));
+
+    // QNetworkAccessManager takes ownership of the cache. It revalidates stale entries with
+    // If-None-Match / If-Modified-Since and replays the stored body as a 200 when the server answers 304.
+    m_cache = new QNetworkDiskCache();
+    m_cache->setMaximumCacheSize(maxCacheSize);
+    setCacheDirectory(
+        cacheDirectory.isEmpty()
+            ? QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("http")
+            : cacheDirectory
+    );
+    m_manager.setCache(m_cache);
+
+    // HTTP/2 is negotiated through ALPN and falls back to HTTP/1.1. Session persistence exposes the ticket the server
+    // issues, so a reconnect after a restart resumes the TLS session instead of doing a full handshake.
+    m_sslConfiguration = QSslConfiguration::defaultConfiguration();
+    m_sslConfiguration.setAllowedNextProtocols(
+        {QSslConfiguration::ALPNProtocolHTTP2, QSslConfiguration::NextProtocolHttp1_1}
+    );
+    m_sslConfiguration.setSslOption(QSsl::SslOptionDisableSessionPersistence, false);
+    setTlsSessionFile(QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).filePath("tls-session"));
+
+    connect(&m_replayTimer, &QTimer::timeout, this, &NetworkClient::replayPending);
+
+    m_harFlushTimer.setSingleShot(true);
+    m_harFlushTimer.setInterval(harFlushDelayMs);
+    connect(&m_harFlushTimer, &QTimer::timeout, this, &NetworkClient::flushHarRecording);
+}
+
+NetworkClient::~NetworkClient() { stopHarRecording(); }
+
+bool NetworkClient::Subscriber::isCancelled() const {
+    return std::any_of(tokens.cbegin(), tokens.cend(), [](const CancellationToken& token) {
+        return token.isCancelled();
+    });
+}
 
 void NetworkClient::sendRequest(
     HttpMethod method,
     const QUrl& endpoint,
     const QByteArray& data,
     CallbackHandler onSuccess,
-    CallbackHandler onError
+    CallbackHandler onError,
+    const RequestOptions& options
+) {
+    Subscriber subscriber{std::move(onSuccess), std::move(onError), {}};
+    if (options.cancellationToken.isValid()) {
+        subscriber.tokens.append(options.cancellationToken);
+    }
+    if (!options.supersedeKey.isEmpty()) {
+        CancellationToken superseding = CancellationToken::create();
+        std::exchange(m_supersedeTokens[options.supersedeKey], superseding).cancel();
+        subscriber.tokens.append(superseding);
+    }
+    enqueueRequest(method, endpoint, data, std::move(subscriber), options, 1);
+}
+
+void NetworkClient::enqueueRequest(
+    HttpMethod method,
+    const QUrl& endpoint,
+    const QByteArray& data,
+    Subscriber subscriber,
+    const RequestOptions& options,
+    int attempt
 ) {
-    QNetworkRequest request = createRequest(endpoint);
+    if (subscriber.isCancelled()) {
+        return;
+    }
+    // While the access token is being refreshed, requests that carry it wait for the new one.
+    if (m_isRefreshing && options.requiresAuth) {
+        queuePending(method, endpoint, data, std::move(subscriber), options);
+        return;
+    }
+
+    // Identical GETs issued while one is already queued or on the wire share its reply instead of opening a new one.
+    QString coalescingKey;
+    if (method == HttpMethod::Get) {
+        coalescingKey = coalescingKeyFor(endpoint);
+        auto it = m_inFlightGets.constFind(coalescingKey);
+        if (it != m_inFlightGets.cend()) {
+            addSubscriber(*it, std::move(subscriber));
+            return;
+        }
+    }
+
+    const quint64 id = ++m_nextRequestId;
+    InFlightRequest& entry =
+        *m_requests.insert(id, {method, endpoint, data, options, coalescingKey, {}, {}, {}, attempt});
+    entry.queued.start();
+    entry.timing = QSharedPointer<RequestTiming>::create();
+    entry.timing->id = id;
+    entry.timing->method = methodName(method);
+    entry.timing->url = m_baseUrl.resolved(endpoint).toString();
+    entry.timing->endpoint = endpointTemplate(m_baseUrl.resolved(endpoint));
+    entry.timing->attempt = attempt;
+    entry.traceFlow = PAWS_TRACE_CURRENT_FLOW();
+    if (!coalescingKey.isEmpty()) {
+        m_inFlightGets.insert(coalescingKey, id);
+    }
+    addSubscriber(id, std::move(subscriber));
+
+    m_scheduler.enqueue(options.priority, [this, id, priority = options.priority]() {
+        // Abandoned while still queued: hand the slot straight back.
+        if (!m_requests.contains(id)) {
+            m_scheduler.release(priority);
+            return;
+        }
+        startRequest(id);
+    });
+}
+
+void NetworkClient::addSubscriber(quint64 id, Subscriber subscriber) {
+    InFlightRequest& request = m_requests[id];
+    for (const auto& token : subscriber.tokens) {
+        // Tokens may be cancelled from inside a callback of this very request, so the check is deferred.
+        const int subscription = token.subscribe([client = QPointer<NetworkClient>(this), id]() {
+            if (client) {
+                QMetaObject::invokeMethod(
+                    client.data(),
+                    [client, id]() { client->abandonIfCancelled(id); },
+                    Qt::QueuedConnection
+                );
+            }
+        });
+        request.subscriptions.append({token, subscription});
+    }
+    request.subscribers.append(std::move(subscriber));
+}
+
+void NetworkClient::startRequest(quint64 id) {
+    InFlightRequest& entry = m_requests[id];
+    if (entry.attempt == 1) {
+        m_retryLimiter.recordRequest();
+    }
+
+    // The request is built when it is admitted, not when it is queued, so it carries the current access token.
+    QNetworkRequest request = createRequest(entry.endpoint);
+    if (entry.options.priority == RequestPriority::Interactive) {
+        request.setPriority(QNetworkRequest::HighPriority);
+    } else if (entry.options.priority == RequestPriority::Background) {
+        request.setPriority(QNetworkRequest::LowPriority);
+    }
+
+    // QNetworkAccessManager advertises gzip/deflate itself and inflates incrementally, so readyRead already delivers
+    // decoded bytes; the safety check stops a compression bomb at the same limit as a plain oversized body.
+    request.setDecompressedSafetyCheckThreshold(maxResponseSizeFor(entry));
+    if (!entry.options.idempotencyKey.isEmpty()) {
+        request.setRawHeader("Idempotency-Key", entry.options.idempotencyKey);
+    }
+
+    const QByteArray body = encodeRequestBody(request.url(), entry.data, request);
+    TransferStats& stats = m_transferStats[endpointTemplate(request.url())];
+    ++stats.requests;
+    stats.bytesSent += body.size();
+    stats.bytesSentRaw += entry.data.size();
+
     QNetworkReply* reply = nullptr;
 
-    switch (method) {
+    switch (entry.method) {
         case HttpMethod::Get:
             reply = m_manager.get(request);
             break;
         case HttpMethod::Post:
             request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-            reply = m_manager.post(request, data);
+            reply = m_manager.post(request, body);
             break;
         case HttpMethod::Put:
             request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-            reply = m_manager.put(request, data);
+            reply = m_manager.put(request, body);
             break;
         case HttpMethod::Patch:
             request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-            reply = m_manager.sendCustomRequest(request, "PATCH", data);
+            reply = m_manager.sendCustomRequest(request, "PATCH", body);
             break;
         case HttpMethod::Delete:
             reply = m_manager.deleteResource(request);
@@ -40,127 +274,421 @@ void NetworkClient::sendRequest(
     }
 
     if (!reply) {
+        m_scheduler.release(takeRequest(id).options.priority);
         return;
     }
+    entry.reply = reply;
+    entry.elapsed.start();
+    entry.timing->queueMs = elapsedMs(entry.queued);
+    entry.timing->startedAt = QDateTime::currentDateTime();
 
-    connect(
-        reply,
-        &QNetworkReply::finished,
-        this,
-        [this,
-         method,
-         endpoint = request.url(),
-         data,
-         reply,
-         onSuccess = std::move(onSuccess),
-         onError = std::move(onError)]() {
-            QByteArray responseData = reply->readAll();
-            reply->setProperty("responseData", responseData);
-            if (reply->error() != QNetworkReply::NoError) {
-                if (responseData.isEmpty()) {
-                    reply->setProperty("responseData", QByteArray("Network error: ") + reply->errorString().toUtf8());
-                }
-
-                if (onError) {
-                    onError(*reply);
-                }
-
-                reply->deleteLater();
-                return;
+    connect(reply, &QNetworkReply::metaDataChanged, this, [this, id]() { reserveBody(id); });
+    connect(reply, &QNetworkReply::readyRead, this, [this, id]() { readBody(id); });
+    connect(reply, &QNetworkReply::finished, this, [this, id, reply]() {
+        readBody(id);
+        storeSessionTicket(*reply);
+        InFlightRequest request = takeRequest(id);
+        m_scheduler.release(request.options.priority);
+        recordReceived(*reply, request.body);
+        // A timed-out transfer is recorded at the time it took, so a slow endpoint pushes its own timeout up.
+        const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        RequestTiming& timing = *request.timing;
+        timing.statusCode = statusCode;
+        timing.bytesReceived = request.body.size();
+        timing.fromCache = reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+        timing.transferMs = elapsedMs(request.elapsed) - qMax(0.0, timing.firstByteMs);
+        if (m_harRecording) {
+            recordHarEntry(*reply, request);
+        }
+        // A disk cache answer says nothing about the server, so it would only drag the endpoint's timeout down.
+        if (!request.oversized && !timing.fromCache &&
+            (statusCode > 0 || reply->error() == QNetworkReply::OperationCanceledError)) {
+            m_latency.record(endpointTemplate(reply->url()), static_cast<int>(request.elapsed.elapsed()));
+        }
+
+        QList<Subscriber> subscribers;
+        std::copy_if(
+            request.subscribers.cbegin(),
+            request.subscribers.cend(),
+            std::back_inserter(subscribers),
+            [](const Subscriber& subscriber) { return !subscriber.isCancelled(); }
+        );
+        if (subscribers.isEmpty()) {
+            recordTiming(timing);
+            reply->deleteLater();
+            return;
+        }
+        if (const auto delay = request.oversized ? std::nullopt : retryDelay(*reply, request)) {
+            recordTiming(timing);
+            scheduleRetry(request, subscribers, *delay);
+            reply->deleteLater();
+            return;
+        }
+
+        NetworkResponse response;
+        response.url = reply->url();
+        response.statusCode = statusCode;
+        response.error = reply->error();
+        response.errorString = reply->errorString();
+        response.body = std::move(request.body);
+        response.retryCount = request.attempt - 1;
+        response.timing = request.timing;
+        if (request.oversized) {
+            response.error = QNetworkReply::UnknownContentError;
+            response.errorString = QString("Response body exceeds %1 bytes").arg(maxResponseSizeFor(request));
+            response.body.clear();
+        }
+        reply->deleteLater();
+
+        PAWS_TRACE_FLOW_SCOPE(request.traceFlow);
+        PAWS_TRACE_COMPLETE(
+            timing.method.toUtf8() + ' ' + timing.url.toUtf8(),
+            "network",
+            request.elapsed.nsecsElapsed()
+        );
+        PAWS_TRACE_SCOPE("NetworkClient::handleReply");
+        // With direct connections the callbacks run the service and the view model slots, so whatever the service
+        // did not book as parsing is the time it took to apply the result.
+        QElapsedTimer callbacks;
+        callbacks.start();
+        handleReply(response, request, subscribers);
+        timing.applyMs = elapsedMs(callbacks) - qMax(0.0, timing.parseMs);
+        recordTiming(timing);
+    });
+}
+
+qint64 NetworkClient::maxResponseSizeFor(const InFlightRequest& request) const {
+    return request.options.maxResponseSize > 0 ? request.options.maxResponseSize : m_maxResponseSize;
+}
+
+void NetworkClient::reserveBody(quint64 id) {
+    auto it = m_requests.find(id);
+    if (it == m_requests.end() || !it->reply) {
+        return;
+    }
+    if (it->timing->firstByteMs < 0) {
+        it->timing->firstByteMs = elapsedMs(it->elapsed);
+    }
+    // Content-Length lets the whole body land in one allocation; a payload over the limit fails before any of it
+    // is buffered.
+    const qint64 length = it->reply->header(QNetworkRequest::ContentLengthHeader).toLongLong();
+    if (length > maxResponseSizeFor(*it)) {
+        it->oversized = true;
+        it->reply->abort();
+        return;
+    }
+    if (length > it->body.capacity()) {
+        it->body.reserve(length);
+    }
+}
+
+void NetworkClient::readBody(quint64 id) {
+    auto it = m_requests.find(id);
+    if (it == m_requests.end() || !it->reply || it->oversized) {
+        return;
+    }
+    const qint64 available = it->reply->bytesAvailable();
+    if (available <= 0) {
+        return;
+    }
+    const qint64 offset = it->body.size();
+    if (offset + available > maxResponseSizeFor(*it)) {
+        it->oversized = true;
+        it->reply->abort();
+        return;
+    }
+    // Read straight into the buffer instead of through a temporary from readAll().
+    it->body.resize(offset + available);
+    const qint64 read = it->reply->read(it->body.data() + offset, available);
+    it->body.resize(offset + qMax<qint64>(0, read));
+}
+
+void NetworkClient::abandonIfCancelled(quint64 id) {
+    auto it = m_requests.constFind(id);
+    if (it == m_requests.cend()) {
+        return;
+    }
+    const bool allCancelled = std::all_of(it->subscribers.cbegin(), it->subscribers.cend(), [](const auto& subscriber) {
+        return subscriber.isCancelled();
+    });
+    if (!allCancelled) {
+        return;
+    }
+
+    const InFlightRequest request = takeRequest(id);
+    if (request.reply) {
+        request.reply->disconnect(this);
+        request.reply->abort();
+        request.reply->deleteLater();
+        m_scheduler.release(request.options.priority);
+    }
+}
+
+NetworkClient::InFlightRequest NetworkClient::takeRequest(quint64 id) {
+    InFlightRequest request = m_requests.take(id);
+    for (const auto& [token, subscription] : request.subscriptions) {
+        token.unsubscribe(subscription);
+    }
+    if (!request.coalescingKey.isEmpty() && m_inFlightGets.value(request.coalescingKey) == id) {
+        m_inFlightGets.remove(request.coalescingKey);
+    }
+    return request;
+}
+
+std::optional<int> NetworkClient::retryDelay(const QNetworkReply& reply, const InFlightRequest& request) {
+    const RetryPolicy& policy = request.options.retry;
+    // A server that honours Idempotency-Key applies a replayed POST or PATCH at most once.
+    if (!isIdempotent(request.method) && request.options.idempotencyKey.isEmpty()) {
+        return std::nullopt;
+    }
+
+    const int statusCode = reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    const bool throttled = statusCode == 429 || statusCode == 503;
+    const bool retryable = throttled || statusCode == 502 || statusCode == 504 ||
+                           (statusCode == 0 && isTransient(reply.error()));
+    if (!retryable) {
+        return std::nullopt;
+    }
+    if (request.attempt >= policy.maxAttempts) {
+        ++m_retryStats.exhausted;
+        return std::nullopt;
+    }
+
+    qint64 delay = RetryLimiter::backoffDelay(policy, request.attempt);
+    if (throttled) {
+        if (const auto retryAfter = retryAfterMs(reply)) {
+            if (*retryAfter > policy.maxRetryAfterMs) {
+                ++m_retryStats.exhausted;
+                return std::nullopt;
             }
-            if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 401) {
-                QSharedPointer<BaseError> error = ErrorFactory::createError(responseData);
-                if (error.dynamicCast<AccessTokenExpiredError>()) {
-                    m_pendingRequests.append({method, endpoint, data, onSuccess, onError});
-
-                    if (!m_isRefreshing) {
-                        m_isRefreshing = true;
-                        emit unauthorizedAccess();
-                    }
-                    reply->deleteLater();
-                    return;
-                }
-                if (error.dynamicCast<AccessTokenInvalidError>()) {
-                    emit invalidTokenDetected();
-                    reply->deleteLater();
-                    return;
-                }
-                reply->setProperty("responseData", responseData);
-                if (onError) {
-                    onError(*reply);
-                }
-                reply->deleteLater();
-                return;
+            delay = qMax(delay, *retryAfter);
+        }
+    }
+
+    const QUrl url = m_baseUrl.resolved(request.endpoint);
+    if (!m_retryLimiter.tryAcquire(url.adjusted(QUrl::RemoveQuery | QUrl::RemoveFragment).toString())) {
+        ++m_retryStats.throttled;
+        return std::nullopt;
+    }
+    return static_cast<int>(delay);
+}
+
+void NetworkClient::scheduleRetry(const InFlightRequest& request, const QList<Subscriber>& subscribers, int delayMs) {
+    ++m_retryStats.retried;
+    MetricsRegistry::global().increment(
+        "pawspective_http_retries_total",
+        {{"endpoint", request.timing->endpoint}, {"method", request.timing->method}}
+    );
+    emit requestRetried(m_baseUrl.resolved(request.endpoint), request.attempt + 1, delayMs);
+
+    // Subscribers cancelled while waiting are dropped by enqueueRequest().
+    QTimer::singleShot(delayMs, this, [this, request, subscribers]() {
+        PAWS_TRACE_FLOW_SCOPE(request.traceFlow);
+        for (const auto& subscriber : subscribers) {
+            enqueueRequest(
+                request.method,
+                request.endpoint,
+                request.data,
+                subscriber,
+                request.options,
+                request.attempt + 1
+            );
+        }
+    });
+}
+
+void NetworkClient::handleReply(
+    const NetworkResponse& response,
+    const InFlightRequest& request,
+    const QList<Subscriber>& subscribers
+) {
+    const auto notifyError = [&subscribers](const NetworkResponse& failed) {
+        for (const auto& subscriber : subscribers) {
+            if (subscriber.onError) {
+                subscriber.onError(failed);
             }
-            int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-
-            if (statusCode >= 200 && statusCode < 300) {
-                if (onSuccess) {
-                    onSuccess(*reply);
-                }
-            } else {
-                if (onError) {
-                    onError(*reply);
-                }
+        }
+    };
+
+    // Qt reports a 401 as AuthenticationRequiredError, so the status has to be checked before the error.
+    if (response.statusCode == 401 && request.options.requiresAuth) {
+        QSharedPointer<BaseError> error = ErrorFactory::createError(response.body);
+        if (error.dynamicCast<AccessTokenExpiredError>()) {
+            for (const auto& subscriber : subscribers) {
+                queuePending(request.method, request.endpoint, request.data, subscriber, request.options);
+            }
+
+            if (!m_isRefreshing) {
+                m_isRefreshing = true;
+                emit unauthorizedAccess();
+            }
+            return;
+        }
+        if (error.dynamicCast<AccessTokenInvalidError>()) {
+            // The session is over; the callers still hear about their request.
+            emit invalidTokenDetected();
+            notifyError(response);
+            return;
+        }
+        notifyError(response);
+        return;
+    }
+
+    if (response.error != QNetworkReply::NoError) {
+        if (response.body.isEmpty()) {
+            NetworkResponse failed = response;
+            failed.body = QByteArray("Network error: ") + response.errorString.toUtf8();
+            notifyError(failed);
+            return;
+        }
+        notifyError(response);
+        return;
+    }
+
+    if (response.statusCode >= 200 && response.statusCode < 300) {
+        for (const auto& subscriber : subscribers) {
+            if (subscriber.onSuccess) {
+                subscriber.onSuccess(response);
+            }
+        }
+    } else {
+        notifyError(response);
+    }
+}
+
+void NetworkClient::holdRequests() { m_isRefreshing = true; }
+
+void NetworkClient::queuePending(
+    HttpMethod method,
+    const QUrl& endpoint,
+    const QByteArray& data,
+    Subscriber subscriber,
+    const RequestOptions& options
+) {
+    if (method == HttpMethod::Get) {
+        for (auto& pending : m_pendingRequests) {
+            if (pending.method == HttpMethod::Get && pending.endpoint == endpoint) {
+                pending.subscribers.append(std::move(subscriber));
+                return;
             }
-            reply->deleteLater();
         }
+    }
+    // The oldest entry is the least likely to still matter to the user.
+    if (m_pendingRequests.size() >= maxPendingRequests) {
+        failPending(m_pendingRequests.takeFirst(), "Too many requests waiting for authentication");
+    }
+    m_pendingRequests.append(
+        {method, endpoint, data, {std::move(subscriber)}, options, QDeadlineTimer(pendingRequestTtlMs)}
     );
 }
 
+void NetworkClient::failPending(const PendingRequest& request, const QString& reason) {
+    NetworkResponse response;
+    response.url = m_baseUrl.resolved(request.endpoint);
+    response.error = QNetworkReply::OperationCanceledError;
+    response.errorString = reason;
+    response.body = QByteArray("Network error: ") + reason.toUtf8();
+    for (const auto& subscriber : request.subscribers) {
+        if (!subscriber.isCancelled() && subscriber.onError) {
+            subscriber.onError(response);
+        }
+    }
+}
+
 void NetworkClient::retryPendingRequests() {
     m_isRefreshing = false;
-    QList<PendingRequest> pendingRequests = std::move(m_pendingRequests);
-    m_pendingRequests.clear();
-    for (auto& request : pendingRequests) {
-        sendRequest(
-            request.method,
-            request.endpoint,
-            request.data,
-            std::move(request.onSuccess),
-            std::move(request.onError)
-        );
+    replayPending();
+    if (!m_pendingRequests.isEmpty()) {
+        m_replayTimer.start(replayIntervalMs);
+    }
+}
+
+void NetworkClient::replayPending() {
+    // A few entries per tick: the scheduler caps how many run at once, the pacer caps how fast they arrive, so a
+    // client that slept through expiry does not hit the API with its whole backlog right after the refresh.
+    if (m_isRefreshing) {
+        m_replayTimer.stop();
+        return;
+    }
+    int replayed = 0;
+    while (replayed < replayBatchSize && !m_pendingRequests.isEmpty()) {
+        const PendingRequest request = m_pendingRequests.takeFirst();
+        if (request.deadline.hasExpired()) {
+            failPending(request, "Request expired while waiting for authentication");
+            continue;
+        }
+        ++replayed;
+        // Replayed with the original tokens, so a request superseded while waiting for the refresh stays dropped.
+        for (const auto& subscriber : request.subscribers) {
+            enqueueRequest(request.method, request.endpoint, request.data, subscriber, request.options, 1);
+        }
+    }
+    if (m_pendingRequests.isEmpty()) {
+        m_replayTimer.stop();
     }
 }
 
 void NetworkClient::clearPendingRequests() {
     m_isRefreshing = false;
-    m_pendingRequests.clear();
+    m_replayTimer.stop();
+    // Every held request still ends in its error callback, so nothing waits for a reply that will never come.
+    const QList<PendingRequest> pending = std::exchange(m_pendingRequests, {});
+    for (const auto& request : pending) {
+        failPending(request, "Session ended");
+    }
 }
 
-void NetworkClient::get(const QUrl& endpoint, CallbackHandler onSuccess, CallbackHandler onError) {
-    sendRequest(HttpMethod::Get, endpoint, {}, std::move(onSuccess), std::move(onError));
+void NetworkClient::get(
+    const QUrl& endpoint,
+    CallbackHandler onSuccess,
+    CallbackHandler onError,
+    const RequestOptions& options
+) {
+    sendRequest(HttpMethod::Get, endpoint, {}, std::move(onSuccess), std::move(onError), options);
 }
 
 void NetworkClient::post(
     const QUrl& endpoint,
     const QByteArray& data,
     CallbackHandler onSuccess,
-    CallbackHandler onError
+    CallbackHandler onError,
+    const RequestOptions& options
 ) {
-    sendRequest(HttpMethod::Post, endpoint, data, std::move(onSuccess), std::move(onError));
+    sendRequest(HttpMethod::Post, endpoint, data, std::move(onSuccess), std::move(onError), options);
 }
 
 void NetworkClient::put(
     const QUrl& endpoint,
     const QByteArray& data,
     CallbackHandler onSuccess,
-    CallbackHandler onError
+    CallbackHandler onError,
+    const RequestOptions& options
 ) {
-    sendRequest(HttpMethod::Put, endpoint, data, std::move(onSuccess), std::move(onError));
+    sendRequest(HttpMethod::Put, endpoint, data, std::move(onSuccess), std::move(onError), options);
 }
 
 void NetworkClient::patch(
     const QUrl& endpoint,
     const QByteArray& data,
     CallbackHandler onSuccess,
-    CallbackHandler onError
+    CallbackHandler onError,
+    const RequestOptions& options
+) {
+    sendRequest(HttpMethod::Patch, endpoint, data, std::move(onSuccess), std::move(onError), options);
+}
+
+void NetworkClient::deleteResource(
+    const QUrl& endpoint,
+    CallbackHandler onSuccess,
+    CallbackHandler onError,
+    const RequestOptions& options
 ) {
-    sendRequest(HttpMethod::Patch, endpoint, data, std::move(onSuccess), std::move(onError));
+    sendRequest(HttpMethod::Delete, endpoint, {}, std::move(onSuccess), std::move(onError), options);
 }
 
-void NetworkClient::deleteResource(const QUrl& endpoint, CallbackHandler onSuccess, CallbackHandler onError) {
-    sendRequest(HttpMethod::Delete, endpoint, {}, std::move(onSuccess), std::move(onError));
+QString NetworkClient::coalescingKeyFor(const QUrl& endpoint) const {
+    const QString token = m_tokenProvider ? m_tokenProvider() : QString();
+    return m_baseUrl.resolved(endpoint).toString(QUrl::FullyEncoded) + '\n' + token;
 }
 
 QNetworkRequest NetworkClient::createRequest(const QUrl& endpoint) const {
@@ -172,14 +700,226 @@ QNetworkRequest NetworkClient::createRequest(const QUrl& endpoint) const {
             request.setRawHeader("Authorization", "Bearer " + token.toUtf8());
         }
     }
-    request.setTransferTimeout(m_timeout);
+    // Cheap lookups fail fast while large pages get room, each according to what the endpoint has shown so far.
+    request.setTransferTimeout(m_latency.timeoutFor(endpointTemplate(request.url()), m_timeoutPolicy));
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferNetwork);
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+    if (request.url().scheme() == "https") {
+        request.setSslConfiguration(m_sslConfiguration);
+    }
     return request;
 }
 
+void NetworkClient::storeSessionTicket(const QNetworkReply& reply) {
+    if (reply.url().scheme() != "https" || m_tlsSessionFile.isEmpty()) {
+        return;
+    }
+    const QByteArray ticket = reply.sslConfiguration().sessionTicket();
+    if (ticket.isEmpty() || ticket == m_sslConfiguration.sessionTicket()) {
+        return;
+    }
+    m_sslConfiguration.setSessionTicket(ticket);
+
+    QDir().mkpath(QFileInfo(m_tlsSessionFile).absolutePath());
+    QSaveFile file(m_tlsSessionFile);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(ticket);
+        file.commit();
+    }
+}
+
+QByteArray NetworkClient::encodeRequestBody(const QUrl& url, const QByteArray& data, QNetworkRequest& request) const {
+    if (data.size() < m_requestCompressionThreshold || !m_deflateRequestHosts.contains(url.host())) {
+        return data;
+    }
+    // HTTP "deflate" is the zlib format; qCompress() prepends a 4-byte length that is not part of it.
+    QByteArray encoded = qCompress(data).mid(4);
+    if (encoded.size() >= data.size()) {
+        return data;
+    }
+    request.setRawHeader("Content-Encoding", "deflate");
+    return encoded;
+}
+
+void NetworkClient::recordReceived(const QNetworkReply& reply, const QByteArray& body) {
+    // A server lists the codings it accepts for request bodies in Accept-Encoding on its responses (RFC 7694).
+    const QByteArray acceptEncoding = reply.rawHeader("Accept-Encoding").toLower();
+    if (acceptEncoding.contains("deflate")) {
+        m_deflateRequestHosts.insert(reply.url().host());
+    } else if (reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 415) {
+        m_deflateRequestHosts.remove(reply.url().host());
+    }
+
+    bool hasLength = false;
+    const qint64 wireSize = reply.rawHeader("Content-Length").toLongLong(&hasLength);
+    TransferStats& stats = m_transferStats[endpointTemplate(reply.url())];
+    stats.bytesReceived += hasLength ? wireSize : body.size();
+    stats.bytesReceivedRaw += body.size();
+}
+
+void NetworkClient::recordTiming(const RequestTiming& timing) {
+    m_timeline.append(timing);
+    if (m_slowRequestThresholdMs > 0 && timing.totalMs() >= m_slowRequestThresholdMs) {
+        qWarning().noquote() << QString("Slow request %1 %2: %3 ms (status %4, %5 bytes; queue %6, first byte %7, "
+                                        "transfer %8, parse %9, apply %10)")
+                                    .arg(timing.method, timing.url)
+                                    .arg(timing.totalMs(), 0, 'f', 1)
+                                    .arg(timing.statusCode)
+                                    .arg(timing.bytesReceived)
+                                    .arg(timing.queueMs, 0, 'f', 1)
+                                    .arg(timing.firstByteMs, 0, 'f', 1)
+                                    .arg(timing.transferMs, 0, 'f', 1)
+                                    .arg(timing.parseMs, 0, 'f', 1)
+                                    .arg(timing.applyMs, 0, 'f', 1);
+    }
+    recordMetrics(timing);
+    emit requestTimed(timing);
+}
+
+void NetworkClient::recordMetrics(const RequestTiming& timing) {
+    MetricsRegistry& metrics = MetricsRegistry::global();
+    if (!metrics.isEnabled()) {
+        return;
+    }
+    const MetricsRegistry::Labels endpoint = {{"endpoint", timing.endpoint}, {"method", timing.method}};
+    metrics.increment(
+        "pawspective_http_requests_total",
+        endpoint + MetricsRegistry::Labels{{"status", QString::number(timing.statusCode)}}
+    );
+    metrics.observeMs("pawspective_http_request_duration_seconds", endpoint, timing.totalMs());
+    if (timing.method == "GET") {
+        metrics.increment("pawspective_http_cache_total", {{"result", timing.fromCache ? "hit" : "miss"}});
+    }
+    if (timing.parseMs >= 0) {
+        metrics.observeMs("pawspective_parse_duration_seconds", endpoint, timing.parseMs);
+    }
+    if (timing.applyMs >= 0) {
+        metrics.observeMs("pawspective_model_update_duration_seconds", endpoint, timing.applyMs);
+    }
+}
+
+void NetworkClient::setBaseUrl(const QUrl& url) { m_baseUrl = url; }
+
+const QUrl& NetworkClient::baseUrl() const { return m_baseUrl; }
+
+void NetworkClient::prewarm() {
+    // Opens the connection (and the TLS session) ahead of the first request; QNetworkAccessManager keeps it in its
+    // pool, so the request that follows skips DNS, TCP and TLS setup.
+    const QString host = m_baseUrl.host();
+    if (host.isEmpty()) {
+        return;
+    }
+    if (m_baseUrl.scheme() == "https") {
+        if (QSslSocket::supportsSsl()) {
+            m_manager.connectToHostEncrypted(host, static_cast<quint16>(m_baseUrl.port(443)), m_sslConfiguration);
+        }
+        return;
+    }
+    m_manager.connectToHost(host, static_cast<quint16>(m_baseUrl.port(80)));
+}
+
+void NetworkClient::setTlsSessionFile(const QString& path) {
+    m_tlsSessionFile = path;
+    QFile file(path);
+    if (!path.isEmpty() && file.open(QIODevice::ReadOnly)) {
+        m_sslConfiguration.setSessionTicket(file.readAll());
+    }
+}
+
 void NetworkClient::setTokenProvider(TokenProvider provider) { m_tokenProvider = std::move(provider); }
 
-void NetworkClient::setUserId(std::optional<uint64_t> userId) { m_userId = userId; }
+void NetworkClient::setUserId(std::optional<uint64_t> userId) {
+    // Cached entries are keyed by URL only, so a different identity must not see the previous user's responses.
+    if (m_userId != userId) {
+        clearCache();
+    }
+    m_userId = userId;
+}
 
 std::optional<uint64_t> NetworkClient::getUserId() const { return m_userId; }
 
+void NetworkClient::setMaxResponseSize(qint64 bytes) { m_maxResponseSize = bytes; }
+
+void NetworkClient::setCacheDirectory(const QString& path) { m_cache->setCacheDirectory(path); }
+
+void NetworkClient::clearCache() {
+    m_cache->clear();
+    // Pooled names that only the evicted responses referred to can go as well.
+    utils::StringPool::global().trim();
+}
+
+RequestScheduler& NetworkClient::scheduler() { return m_scheduler; }
+
+RetryLimiter& NetworkClient::retryLimiter() { return m_retryLimiter; }
+
+const NetworkClient::RetryStats& NetworkClient::retryStats() const { return m_retryStats; }
+
+const QHash<QString, NetworkClient::TransferStats>& NetworkClient::transferStats() const { return m_transferStats; }
+
+void NetworkClient::setRequestCompressionThreshold(qsizetype bytes) { m_requestCompressionThreshold = bytes; }
+
+void NetworkClient::setTimeoutPolicy(const TimeoutPolicy& policy) { m_timeoutPolicy = policy; }
+
+const LatencyTracker& NetworkClient::latency() const { return m_latency; }
+
+RequestTimeline& NetworkClient::timeline() { return m_timeline; }
+
+void NetworkClient::setSlowRequestThreshold(int ms) { m_slowRequestThresholdMs = qMax(0, ms); }
+
+int NetworkClient::slowRequestThreshold() const { return m_slowRequestThresholdMs; }
+
+void NetworkClient::startHarRecording(const QString& path) {
+    stopHarRecording();
+    m_harFile = path;
+    m_harRecording = std::make_unique<HarRecording>();
+}
+
+void NetworkClient::stopHarRecording() {
+    if (!m_harRecording) {
+        return;
+    }
+    m_harFlushTimer.stop();
+    saveHarRecording();
+    m_harRecording.reset();
+}
+
+bool NetworkClient::isHarRecording() const { return m_harRecording != nullptr; }
+
+void NetworkClient::recordHarEntry(const QNetworkReply& reply, const InFlightRequest& request) {
+    const RequestTiming& timing = *request.timing;
+    HarEntry entry;
+    entry.startedAt = timing.startedAt;
+    entry.method = timing.method.toLatin1();
+    entry.url = reply.url();
+    for (const QByteArray& name : reply.request().rawHeaderList()) {
+        entry.requestHeaders.append({name, reply.request().rawHeader(name)});
+    }
+    // The body as the service passed it, before any request compression.
+    entry.requestBody = request.data;
+    entry.status = timing.statusCode;
+    entry.responseHeaders = reply.rawHeaderPairs();
+    entry.responseBody = request.body;
+    entry.error = reply.error();
+    entry.errorString = entry.error == QNetworkReply::NoError ? QString() : reply.errorString();
+    entry.blockedMs = timing.queueMs;
+    entry.waitMs = qMax(0.0, timing.firstByteMs);
+    entry.receiveMs = qMax(0.0, timing.transferMs);
+    m_harRecording->append(std::move(entry));
+    if (!m_harFlushTimer.isActive()) {
+        m_harFlushTimer.start();
+    }
+}
+
+void NetworkClient::flushHarRecording() {
+    if (m_harRecording && !m_harRecording->flush(m_harFile)) {
+        qWarning() << "Cannot write HAR recording to" << m_harFile;
+    }
+}
+
+void NetworkClient::saveHarRecording() {
+    if (m_harRecording && !m_harRecording->save(m_harFile)) {
+        qWarning() << "Cannot write HAR recording to" << m_harFile;
+    }
+}
+
 }  // namespace pawspective::services
\ No newline at end of file
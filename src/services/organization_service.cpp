@@ -1,11 +1,11 @@
 #include "services/organization_service.hpp"
 
+#include <QDebug>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
 #include <QList>
-#include <QNetworkReply>
 #include <QSharedPointer>
 #include <QUrl>
 #include <QUrlQuery>
@@ -13,15 +13,54 @@
 #include "models/organization_dto.hpp"
 #include "services/errors.hpp"
 #include "services/i_network_client.hpp"
+#include "services/mutation_queue.hpp"
 #include "validator.hpp"
 
 namespace pawspective::services {
 
 OrganizationService::OrganizationService(INetworkClient& networkClient, QObject* parent)
-    : QObject(parent), m_networkClient(networkClient) {}
+    : QObject(parent),
+      m_networkClient(networkClient),
+      m_organizationLoader(
+          this,
+          [this](const QList<qint64>& ids, const RequestOptions& options, const BatchLoader::DoneHandler& unsupported) {
+              fetchOrganizations(ids, options, unsupported);
+          },
+          [this](qint64 id, const RequestOptions& options, const BatchLoader::DoneHandler& done) {
+              fetchOrganization(id, options, done);
+          }
+      ) {}
 
-void OrganizationService::handleError(QNetworkReply& reply, std::function<void(QSharedPointer<BaseError>)> onError) {
-    QByteArray data = reply.property("responseData").toByteArray();
+void OrganizationService::setMutationQueue(MutationQueue* mutationQueue) {
+    if (m_mutationQueue != nullptr) {
+        disconnect(m_mutationQueue, nullptr, this, nullptr);
+    }
+    m_mutationQueue = mutationQueue;
+    if (m_mutationQueue == nullptr) {
+        return;
+    }
+    // Callers still waiting get their own error callback; this covers the ones that were told "queued".
+    connect(
+        m_mutationQueue,
+        &MutationQueue::mutationFailed,
+        this,
+        [this](const QString& kind, const QString&, const NetworkResponse& response) {
+            if (kind == "updateOrganization") {
+                handleError(response, [this](QSharedPointer<BaseError> error) {
+                    emit updateOrganizationRejected(error);
+                });
+            }
+        }
+    );
+}
+
+void OrganizationService::setBatchingEnabled(bool enabled) { m_batchingEnabled = enabled; }
+
+void OrganizationService::handleError(
+    const NetworkResponse& response,
+    std::function<void(QSharedPointer<BaseError>)> onError
+) {
+    const QByteArray& data = response.body;
 
     if (data.isEmpty()) {
         onError(QSharedPointer<UnknownError>::create("Empty response"));
@@ -29,7 +68,7 @@ void OrganizationService::handleError(QNetworkReply& reply, std::function<void(Q
     }
 
     QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+    QJsonDocument doc = response.parseJson(&parseError);
 
     if (parseError.error != QJsonParseError::NoError) {
         onError(QSharedPointer<UnknownError>::create(QString::fromUtf8(data)));
@@ -44,51 +83,94 @@ void OrganizationService::handleError(QNetworkReply& reply, std::function<void(Q
     }
 }
 
-void OrganizationService::handleSuccess(
-    QNetworkReply& reply,
-    std::function<void(const QJsonObject&)> onSuccess,
-    std::function<void(QSharedPointer<BaseError>)> onError
-) {
-    QJsonParseError parseError;
-    QByteArray data = reply.property("responseData").toByteArray();
-    try {
-        QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
-
-        if (parseError.error != QJsonParseError::NoError) {
-            onError(
-                QSharedPointer<BaseError>(new ClientJsonParseError(
-                    QString("JSON parse error at %1: %2").arg(parseError.offset).arg(parseError.errorString())
-                ))
-            );
-            return;
-        }
-
-        onSuccess(doc.object());
-    } catch (const std::exception& e) {
-        onError(QSharedPointer<BaseError>(new ClientJsonParseError(QString(e.what()))));
+void OrganizationService::getOrganization(qint64 id, const RequestOptions& options) {
+    if (m_batchingEnabled) {
+        m_organizationLoader.load(id, options);
+        return;
     }
+    fetchOrganization(id, options, {});
 }
 
-void OrganizationService::getOrganization(qint64 id) {
+void OrganizationService::fetchOrganization(
+    qint64 id,
+    const RequestOptions& options,
+    const BatchLoader::DoneHandler& done
+) {
     m_networkClient.get(
         QUrl(QString("/orgs/%1").arg(id)),
-        [this](QNetworkReply& reply) {
-            handleSuccess(
-                reply,
-                [this](const QJsonObject& obj) {
-                    models::OrganizationDTO organization = models::OrganizationDTO::fromJson(obj);
-                    emit getOrganizationSuccess(organization);
-                },
-                [this](QSharedPointer<BaseError> error) { emit getOrganizationFailed(error); }
+        [this, id, done](const NetworkResponse& response) {
+            handleDtoSuccess<models::OrganizationDTO>(
+                response,
+                [this](const models::SharedOrganization& organization) { emit getOrganizationSuccess(organization); },
+                [this, id](QSharedPointer<BaseError> error) { emit getOrganizationFailed(error, id); }
             );
+            if (done) {
+                done();
+            }
         },
-        [this](QNetworkReply& reply) {
-            handleError(reply, [this](QSharedPointer<BaseError> error) { emit getOrganizationFailed(error); });
-        }
+        [this, id, done](const NetworkResponse& response) {
+            handleError(response, [this, id](QSharedPointer<BaseError> error) {
+                emit getOrganizationFailed(error, id);
+            });
+            if (done) {
+                done();
+            }
+        },
+        options
+    );
+}
+
+void OrganizationService::fetchOrganizations(
+    const QList<qint64>& ids,
+    const RequestOptions& options,
+    const BatchLoader::DoneHandler& unsupported
+) {
+    m_networkClient.get(
+        BatchLoader::idsUrl("/orgs", ids),
+        [this, ids, unsupported](const NetworkResponse& response) {
+            const QJsonDocument doc = response.parseJson();
+            if (!doc.isArray()) {
+                // The route exists but ignored ids= and answered with something else.
+                unsupported();
+                return;
+            }
+            const QList<qint64> missing = BatchLoader::deliverItems(
+                doc.array(),
+                ids,
+                [this](qint64 id, const QJsonObject& item, qsizetype index) {
+                    auto organization = models::OrganizationDTO::tryFromJson(item);
+                    if (!organization) {
+                        const QString message = std::move(organization.error()).within(index).toString();
+                        emit getOrganizationFailed(QSharedPointer<BaseError>(new ClientJsonParseError(message)), id);
+                        return;
+                    }
+                    emit getOrganizationSuccess(models::SharedOrganization(std::move(*organization)));
+                }
+            );
+            for (qint64 id : missing) {
+                const QString message = QString("Organization %1 not found").arg(id);
+                emit getOrganizationFailed(QSharedPointer<BaseError>(new OrganizationNotFoundError(message)), id);
+            }
+        },
+        [this, ids, unsupported](const NetworkResponse& response) {
+            if (BatchLoader::isMissingEndpoint(response.statusCode)) {
+                unsupported();
+                return;
+            }
+            for (qint64 id : ids) {
+                handleError(response, [this, id](QSharedPointer<BaseError> error) {
+                    emit getOrganizationFailed(error, id);
+                });
+            }
+        },
+        options
     );
 }
 
-void OrganizationService::createOrganization(const models::OrganizationRegisterDTO& dto) {
+void OrganizationService::createOrganization(
+    const models::OrganizationRegisterDTO& dto,
+    const RequestOptions& options
+) {
     const QJsonDocument doc(dto.toJson());
 
     utils::Validator validator;
@@ -101,31 +183,30 @@ void OrganizationService::createOrganization(const models::OrganizationRegisterD
     m_networkClient.post(
         QUrl("/orgs"),
         doc.toJson(QJsonDocument::Compact),
-        [this](QNetworkReply& reply) {
-            handleSuccess(
-                reply,
-                [this](const QJsonObject& obj) {
-                    models::OrganizationDTO organization = models::OrganizationDTO::fromJson(obj);
+        [this](const NetworkResponse& response) {
+            handleDtoSuccess<models::OrganizationDTO>(
+                response,
+                [this](const models::SharedOrganization& organization) {
                     emit createOrganizationSuccess(organization);
                 },
                 [this](QSharedPointer<BaseError> error) { emit createOrganizationFailed(error); }
             );
         },
-        [this](QNetworkReply& reply) {
-            handleError(reply, [this](QSharedPointer<BaseError> error) { emit createOrganizationFailed(error); });
-        }
+        [this](const NetworkResponse& response) {
+            handleError(response, [this](QSharedPointer<BaseError> error) { emit createOrganizationFailed(error); });
+        },
+        options
     );
 }
 
 void OrganizationService::handleSuccessArray(
-    QNetworkReply& reply,
+    const NetworkResponse& response,
     std::function<void(const QJsonArray&)> onSuccess,
     std::function<void(QSharedPointer<BaseError>)> onError
 ) {
     QJsonParseError parseError;
-    QByteArray data = reply.property("responseData").toByteArray();
     try {
-        QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+        QJsonDocument doc = response.parseJson(&parseError);
 
         if (parseError.error != QJsonParseError::NoError) {
             onError(
@@ -147,7 +228,39 @@ void OrganizationService::handleSuccessArray(
     }
 }
 
-void OrganizationService::findByNameContaining(const QString& name, int page) {
+template <typename Dto>
+void OrganizationService::handleDtoSuccess(
+    const NetworkResponse& response,
+    std::function<void(const models::Shared<Dto>&)> onSuccess,
+    std::function<void(QSharedPointer<BaseError>)> onError
+) {
+    utils::json::Decoded<Dto> dto = response.decodeJson<Dto>();
+    if (!dto) {
+        onError(QSharedPointer<BaseError>(new ClientJsonParseError(dto.error().toString())));
+        return;
+    }
+    onSuccess(models::Shared<Dto>(std::move(*dto)));
+}
+
+template <typename Dto>
+void OrganizationService::handleListSuccess(
+    const NetworkResponse& response,
+    std::function<void(const models::Shared<Dto>&)> onSuccess,
+    std::function<void(QSharedPointer<BaseError>)> onError
+) {
+    utils::json::Decoded<Dto> dto = response.decodeJson<Dto>();
+    if (!dto) {
+        onError(QSharedPointer<BaseError>(new ClientJsonParseError(dto.error().toString())));
+        return;
+    }
+    // A page with a few bad items is still shown; the items themselves are only logged.
+    for (const auto& rejected : dto->rejectedItems) {
+        qWarning().noquote() << "Skipped item in" << response.url.path() << "-" << rejected.toString();
+    }
+    onSuccess(models::Shared<Dto>(std::move(*dto)));
+}
+
+void OrganizationService::findByNameContaining(const QString& name, int page, const RequestOptions& options) {
     utils::Validator validator;
     validator.field("name", name.toStdString()).notBlank();
     if (auto error = validator.getValidationError()) {
@@ -163,22 +276,25 @@ void OrganizationService::findByNameContaining(const QString& name, int page) {
 
     m_networkClient.get(
         url,
-        [this](QNetworkReply& reply) {
-            handleSuccess(
-                reply,
-                [this](const QJsonObject& obj) {
-                    emit findByNameContainingSuccess(models::OrganizationListDTO::fromJson(obj));
-                },
+        [this](const NetworkResponse& response) {
+            handleListSuccess<models::OrganizationListDTO>(
+                response,
+                [this](const models::SharedOrganizationList& result) { emit findByNameContainingSuccess(result); },
                 [this](QSharedPointer<BaseError> error) { emit findByNameContainingFailed(error); }
             );
         },
-        [this](QNetworkReply& reply) {
-            handleError(reply, [this](QSharedPointer<BaseError> error) { emit findByNameContainingFailed(error); });
-        }
+        [this](const NetworkResponse& response) {
+            handleError(response, [this](QSharedPointer<BaseError> error) { emit findByNameContainingFailed(error); });
+        },
+        options
     );
 }
 
-void OrganizationService::updateOrganization(qint64 id, const models::OrganizationUpdateDTO& dto) {
+void OrganizationService::updateOrganization(
+    qint64 id,
+    const models::OrganizationUpdateDTO& dto,
+    const RequestOptions& options
+) {
     const QJsonDocument doc(dto.toJson());
     utils::Validator validator;
     if (dto.name) {
@@ -188,22 +304,36 @@ void OrganizationService::updateOrganization(qint64 id, const models::Organizati
         emit updateOrganizationFailed(QSharedPointer<BaseError>(new ValidationError(std::move(*error))));
         return;
     }
+    auto onSuccess = [this](const NetworkResponse& response) {
+        handleDtoSuccess<models::OrganizationDTO>(
+            response,
+            [this](const models::SharedOrganization& organization) { emit updateOrganizationSuccess(organization); },
+            [this](QSharedPointer<BaseError> error) { emit updateOrganizationFailed(error); }
+        );
+    };
+    auto onError = [this](const NetworkResponse& response) {
+        handleError(response, [this](QSharedPointer<BaseError> error) { emit updateOrganizationFailed(error); });
+    };
+
+    if (m_mutationQueue != nullptr) {
+        m_mutationQueue->enqueue(
+            "updateOrganization",
+            "PUT",
+            QUrl(QString("/orgs/%1").arg(id)),
+            doc.toJson(QJsonDocument::Compact),
+            onSuccess,
+            onError,
+            [this]() { emit updateOrganizationQueued(); },
+            options.priority
+        );
+        return;
+    }
     m_networkClient.put(
         QUrl(QString("/orgs/%1").arg(id)),
         doc.toJson(QJsonDocument::Compact),
-        [this](QNetworkReply& reply) {
-            handleSuccess(
-                reply,
-                [this](const QJsonObject& obj) {
-                    models::OrganizationDTO organization = models::OrganizationDTO::fromJson(obj);
-                    emit updateOrganizationSuccess(organization);
-                },
-                [this](QSharedPointer<BaseError> error) { emit updateOrganizationFailed(error); }
-            );
-        },
-        [this](QNetworkReply& reply) {
-            handleError(reply, [this](QSharedPointer<BaseError> error) { emit updateOrganizationFailed(error); });
-        }
+        onSuccess,
+        onError,
+        options
     );
 }
 
@@ -0,0 +1,104 @@
+#include "services/request_scheduler.hpp"
+
+#include <optional>
+
+namespace pawspective::services {
+
+RequestScheduler::RequestScheduler() = default;
+
+std::size_t RequestScheduler::indexOf(RequestPriority priority) { return static_cast<std::size_t>(priority); }
+
+void RequestScheduler::enqueue(RequestPriority priority, Job start) {
+    QueuedJob job{std::move(start), {}};
+    job.waiting.start();
+    m_queues.at(indexOf(priority)).enqueue(std::move(job));
+    dispatch();
+}
+
+void RequestScheduler::release(RequestPriority priority) {
+    const std::size_t index = indexOf(priority);
+    if (m_running.at(index) > 0) {
+        --m_running.at(index);
+        if (priority != RequestPriority::Interactive) {
+            --m_sharedRunning;
+        }
+    }
+    dispatch();
+}
+
+void RequestScheduler::clear() {
+    for (auto& queue : m_queues) {
+        queue.clear();
+    }
+}
+
+void RequestScheduler::setLimit(RequestPriority priority, int limit) {
+    m_limits.at(indexOf(priority)) = qMax(1, limit);
+    dispatch();
+}
+
+void RequestScheduler::setSharedLimit(int limit) {
+    m_sharedLimit = qMax(1, limit);
+    dispatch();
+}
+
+void RequestScheduler::setStarvationThreshold(int milliseconds) { m_starvationThreshold = milliseconds; }
+
+int RequestScheduler::running(RequestPriority priority) const { return m_running.at(indexOf(priority)); }
+
+int RequestScheduler::queued(RequestPriority priority) const {
+    return static_cast<int>(m_queues.at(indexOf(priority)).size());
+}
+
+bool RequestScheduler::hasCapacity(std::size_t index) const {
+    if (m_running.at(index) >= m_limits.at(index)) {
+        return false;
+    }
+    return index == indexOf(RequestPriority::Interactive) || m_sharedRunning < m_sharedLimit;
+}
+
+std::optional<std::size_t> RequestScheduler::nextClass() const {
+    // A starving request wins over any fresher one, oldest first.
+    std::optional<std::size_t> starving;
+    qint64 longestWait = m_starvationThreshold;
+    for (std::size_t index = 0; index < classCount; ++index) {
+        const auto& queue = m_queues.at(index);
+        if (queue.isEmpty() || !hasCapacity(index)) {
+            continue;
+        }
+        const qint64 waited = queue.head().waiting.elapsed();
+        if (waited >= longestWait) {
+            longestWait = waited;
+            starving = index;
+        }
+    }
+    if (starving) {
+        return starving;
+    }
+
+    for (std::size_t index = 0; index < classCount; ++index) {
+        if (!m_queues.at(index).isEmpty() && hasCapacity(index)) {
+            return index;
+        }
+    }
+    return std::nullopt;
+}
+
+void RequestScheduler::dispatch() {
+    // Jobs may finish synchronously and call release() from inside start(); the outer loop picks that up.
+    if (m_dispatching) {
+        return;
+    }
+    m_dispatching = true;
+    while (auto index = nextClass()) {
+        QueuedJob job = m_queues.at(*index).dequeue();
+        ++m_running.at(*index);
+        if (*index != indexOf(RequestPriority::Interactive)) {
+            ++m_sharedRunning;
+        }
+        job.start();
+    }
+    m_dispatching = false;
+}
+
+}  // namespace pawspective::services
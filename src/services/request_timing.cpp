@@ -0,0 +1,83 @@
+#include "services/request_timing.hpp"
+
+#include <QJsonArray>
+
+namespace pawspective::services {
+
+double RequestTiming::totalMs() const {
+    return queueMs + qMax(0.0, firstByteMs) + transferMs + qMax(0.0, parseMs) + qMax(0.0, applyMs);
+}
+
+QJsonObject RequestTiming::toJson() const {
+    return {
+        {"id", QString::number(id)},
+        {"method", method},
+        {"url", url},
+        {"endpoint", endpoint},
+        {"startedAt", startedAt.toString(Qt::ISODateWithMs)},
+        {"attempt", attempt},
+        {"status", statusCode},
+        {"bytes", bytesReceived},
+        {"fromCache", fromCache},
+        {"queueMs", queueMs},
+        {"firstByteMs", firstByteMs},
+        {"transferMs", transferMs},
+        {"parseMs", parseMs},
+        {"applyMs", applyMs},
+        {"totalMs", totalMs()}
+    };
+}
+
+RequestTimeline::RequestTimeline(qsizetype capacity) : m_capacity(qMax<qsizetype>(1, capacity)) {}
+
+void RequestTimeline::append(const RequestTiming& timing) {
+    if (m_entries.size() < m_capacity) {
+        m_entries.append(timing);
+        return;
+    }
+    m_entries[m_next] = timing;
+    m_next = (m_next + 1) % m_capacity;
+}
+
+void RequestTimeline::clear() {
+    m_entries.clear();
+    m_next = 0;
+}
+
+QList<RequestTiming> RequestTimeline::entries() const {
+    QList<RequestTiming> ordered;
+    ordered.reserve(m_entries.size());
+    for (qsizetype i = 0; i < m_entries.size(); ++i) {
+        ordered.append(m_entries.at((m_next + i) % m_entries.size()));
+    }
+    return ordered;
+}
+
+QList<RequestTiming> RequestTimeline::slowerThan(double thresholdMs) const {
+    QList<RequestTiming> slow = entries();
+    slow.removeIf([thresholdMs](const RequestTiming& timing) { return timing.totalMs() < thresholdMs; });
+    return slow;
+}
+
+qsizetype RequestTimeline::capacity() const { return m_capacity; }
+
+void RequestTimeline::setCapacity(qsizetype capacity) {
+    const QList<RequestTiming> ordered = entries();
+    m_capacity = qMax<qsizetype>(1, capacity);
+    m_entries = ordered.mid(qMax<qsizetype>(0, ordered.size() - m_capacity));
+    m_next = 0;
+}
+
+QJsonObject RequestTimeline::toJson(double slowThresholdMs) const {
+    QJsonArray all;
+    QJsonArray slow;
+    for (const auto& timing : entries()) {
+        all.append(timing.toJson());
+        if (slowThresholdMs > 0 && timing.totalMs() >= slowThresholdMs) {
+            slow.append(timing.toJson());
+        }
+    }
+    return {{"slowThresholdMs", slowThresholdMs}, {"requests", all}, {"slow", slow}};
+}
+
+}  // namespace pawspective::services
@@ -0,0 +1,55 @@
+#include "services/retry_limiter.hpp"
+
+#include <QRandomGenerator>
+#include <algorithm>
+
+namespace pawspective::services {
+
+RetryLimiter::RetryLimiter() = default;
+
+void RetryLimiter::recordRequest() { m_budget = std::min(m_maxBudget, m_budget + m_retriesPerRequest); }
+
+bool RetryLimiter::tryAcquire(const QString& endpoint) {
+    if (m_budget < 1) {
+        return false;
+    }
+
+    auto it = m_endpoints.find(endpoint);
+    if (it == m_endpoints.end()) {
+        it = m_endpoints.insert(endpoint, {m_endpointCapacity, {}});
+        it->refilled.start();
+    } else {
+        const double refill = static_cast<double>(it->refilled.restart()) / 1000.0 * m_endpointRefillPerSecond;
+        it->tokens = std::min(m_endpointCapacity, it->tokens + refill);
+    }
+    if (it->tokens < 1) {
+        return false;
+    }
+
+    it->tokens -= 1;
+    m_budget -= 1;
+    return true;
+}
+
+void RetryLimiter::setBudget(double retriesPerRequest, double maxTokens) {
+    m_retriesPerRequest = retriesPerRequest;
+    m_maxBudget = maxTokens;
+    m_budget = std::min(m_budget, m_maxBudget);
+}
+
+void RetryLimiter::setEndpointBucket(double capacity, double refillPerSecond) {
+    m_endpointCapacity = capacity;
+    m_endpointRefillPerSecond = refillPerSecond;
+    m_endpoints.clear();
+}
+
+int RetryLimiter::backoffDelay(const RetryPolicy& policy, int attempt) {
+    // Capped exponential backoff with equal jitter: half of the window is fixed, the other half random, so callers
+    // that failed together do not come back together.
+    const int exponent = std::clamp(attempt - 1, 0, 16);
+    const qint64 window = std::min<qint64>(policy.maxDelayMs, static_cast<qint64>(policy.baseDelayMs) << exponent);
+    const qint64 half = window / 2;
+    return static_cast<int>(half + QRandomGenerator::global()->bounded(half + 1));
+}
+
+}  // namespace pawspective::services
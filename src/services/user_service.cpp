@@ -3,7 +3,6 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
-#include <QNetworkReply>
 #include <QSharedPointer>
 #include <QUrl>
 
@@ -16,8 +15,8 @@ namespace pawspective::services {
 UserService::UserService(NetworkClient& networkClient, QObject* parent)
     : QObject(parent), m_networkClient(networkClient) {}
 
-void UserService::handleError(QNetworkReply& reply) {
-    QByteArray data = reply.property("responseData").toByteArray();
+void UserService::handleError(const NetworkResponse& response) {
+    const QByteArray& data = response.body;
 
     if (data.isEmpty()) {
         emit requestFailed(QSharedPointer<UnknownError>::create("Empty response"));
@@ -25,7 +24,7 @@ void UserService::handleError(QNetworkReply& reply) {
     }
 
     QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+    QJsonDocument doc = response.parseJson(&parseError);
 
     if (parseError.error != QJsonParseError::NoError) {
         emit requestFailed(QSharedPointer<UnknownError>::create(QString::fromUtf8(data)));
@@ -40,11 +39,10 @@ void UserService::handleError(QNetworkReply& reply) {
     }
 }
 
-void UserService::handleSuccess(QNetworkReply& reply, std::function<void(const QJsonObject&)> onSuccess) {
+void UserService::handleSuccess(const NetworkResponse& response, std::function<void(const QJsonObject&)> onSuccess) {
     QJsonParseError parseError;
-    QByteArray data = reply.property("responseData").toByteArray();
     try {
-        QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+        QJsonDocument doc = response.parseJson(&parseError);
 
         if (parseError.error != QJsonParseError::NoError) {
             emit requestFailed(
@@ -90,13 +88,14 @@ void UserService::updateUserProfile(const models::UserUpdateDTO& dto) {
     m_networkClient.put(
         QUrl(QString("/user/%1").arg(*m_networkClient.getUserId())),
         data.toJson(QJsonDocument::Compact),
-        [this](QNetworkReply& reply) {
-            handleSuccess(reply, [this](const QJsonObject& obj) {
+        [this](const NetworkResponse& response) {
+            handleSuccess(response, [this](const QJsonObject& obj) {
                 models::UserDTO user = models::UserDTO::fromJson(obj);
                 emit updateUserProfileSuccess(user);
             });
         },
-        [this](QNetworkReply& reply) { handleError(reply); }
+        [this](const NetworkResponse& response) { handleError(response); },
+        RequestOptions{RequestPriority::Interactive}
     );
 }
 
@@ -114,13 +113,14 @@ void UserService::registerUser(const models::UserRegisterDTO& dto) {
     m_networkClient.post(
         QUrl("/user/register"),
         doc.toJson(QJsonDocument::Compact),
-        [this](QNetworkReply& reply) {
-            handleSuccess(reply, [this](const QJsonObject& obj) {
+        [this](const NetworkResponse& response) {
+            handleSuccess(response, [this](const QJsonObject& obj) {
                 models::UserDTO user = models::UserDTO::fromJson(obj);
                 emit registerUserSuccess(user);
             });
         },
-        [this](QNetworkReply& reply) { handleError(reply); }
+        [this](const NetworkResponse& response) { handleError(response); },
+        RequestOptions{RequestPriority::Interactive}
     );
 }
 
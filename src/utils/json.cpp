@@ -1,73 +1,120 @@
 #include "utils/json.hpp"
 
 #include <format>
+#include <stdexcept>
 #include <string_view>
+#include <utility>
 
 namespace pawspective::utils::json {
 
-QString getRequiredString(const QJsonObject& json, std::string_view key) {
-    QString qkey = QString::fromUtf8(key.data(), key.size());
-    if (!json.contains(qkey) || json[qkey].isNull() || !json[qkey].isString()) {
+namespace {
+
+bool isAbsent(const QJsonValue& value) { return value.isUndefined() || value.isNull(); }
+
+[[noreturn]] void throwInvalidField(std::string_view key, bool required) {
+    if (required) {
         throw std::invalid_argument(std::format("Invalid or missing {} field", key));
     }
-    return json[qkey].toString();
+    throw std::invalid_argument(std::format("Invalid {} field", key));
+}
+
+}  // namespace
+
+DecodeError DecodeError::within(QLatin1StringView key) && {
+    if (path.isEmpty()) {
+        path = key;
+    } else if (path.startsWith('[')) {
+        path.prepend(key);
+    } else {
+        path = QString(key) + '.' + path;
+    }
+    return std::move(*this);
+}
+
+DecodeError DecodeError::within(qsizetype index) && {
+    const QString prefix = QString("[%1]").arg(index);
+    path = path.isEmpty() || path.startsWith('[') ? prefix + path : prefix + '.' + path;
+    return std::move(*this);
+}
+
+QString DecodeError::toString() const { return path.isEmpty() ? message : path + ": " + message; }
+
+DecodeError invalidField(QLatin1StringView key, bool required) {
+    return {
+        key,
+        required ? QString("Invalid or missing %1 field").arg(key) : QString("Invalid %1 field").arg(key),
+    };
+}
+
+void throwDecodeError(const DecodeError& error) { throw std::invalid_argument(error.message.toStdString()); }
+
+QString getRequiredString(const QJsonObject& json, std::string_view key) {
+    const QJsonValue value = json.value(latin1Key(key));
+    if (!value.isString()) {
+        throwInvalidField(key, true);
+    }
+    return value.toString();
 }
 
 qint64 getRequiredInt64(const QJsonObject& json, std::string_view key) {
-    QString qkey = QString::fromUtf8(key.data(), key.size());
-    if (!json.contains(qkey) || json[qkey].isNull() || !json[qkey].isDouble()) {
-        throw std::invalid_argument(std::format("Invalid or missing {} field", key));
+    const QJsonValue value = json.value(latin1Key(key));
+    const std::optional<qint64> number = value.isDouble() ? integralValue(value) : std::nullopt;
+    if (!number) {
+        throwInvalidField(key, true);
     }
-    return json[qkey].toVariant().toLongLong();
+    return *number;
 }
 
 qint32 getRequiredInt32(const QJsonObject& json, std::string_view key) {
-    QString qkey = QString::fromUtf8(key.data(), key.size());
-    if (!json.contains(qkey) || json[qkey].isNull() || !json[qkey].isDouble()) {
-        throw std::invalid_argument(std::format("Invalid or missing {} field", key));
+    const QJsonValue value = json.value(latin1Key(key));
+    const std::optional<qint32> number = value.isDouble() ? integralValue32(value) : std::nullopt;
+    if (!number) {
+        throwInvalidField(key, true);
     }
-    return json[qkey].toInt();
+    return *number;
 }
 
 QJsonObject getRequiredObject(const QJsonObject& json, std::string_view key) {
-    QString qkey = QString::fromUtf8(key.data(), key.size());
-    if (!json.contains(qkey) || json[qkey].isNull() || !json[qkey].isObject()) {
-        throw std::invalid_argument(std::format("Invalid or missing {} field", key));
+    const QJsonValue value = json.value(latin1Key(key));
+    if (!value.isObject()) {
+        throwInvalidField(key, true);
     }
-    return json[qkey].toObject();
+    return value.toObject();
 }
 
 std::optional<QString> getOptionalString(const QJsonObject& json, std::string_view key) {
-    QString qkey = QString::fromUtf8(key.data(), key.size());
-    if (!json.contains(qkey) || json[qkey].isNull()) {
+    const QJsonValue value = json.value(latin1Key(key));
+    if (isAbsent(value)) {
         return std::nullopt;
     }
-    if (!json[qkey].isString()) {
-        throw std::invalid_argument(std::format("Invalid {} field", key));
+    if (!value.isString()) {
+        throwInvalidField(key, false);
     }
-    return json[qkey].toString();
+    return value.toString();
 }
 
 std::optional<qint64> getOptionalInt64(const QJsonObject& json, std::string_view key) {
-    QString qkey = QString::fromUtf8(key.data(), key.size());
-    if (!json.contains(qkey) || json[qkey].isNull()) {
+    const QJsonValue value = json.value(latin1Key(key));
+    if (isAbsent(value)) {
         return std::nullopt;
     }
-    if (!json[qkey].isDouble()) {
-        throw std::invalid_argument(std::format("Invalid {} field", key));
+    const std::optional<qint64> number = value.isDouble() ? integralValue(value) : std::nullopt;
+    if (!number) {
+        throwInvalidField(key, false);
     }
-    return json[qkey].toVariant().toLongLong();
+    return number;
 }
 
 std::optional<qint32> getOptionalInt32(const QJsonObject& json, std::string_view key) {
-    QString qkey = QString::fromUtf8(key.data(), key.size());
-    if (!json.contains(qkey) || json[qkey].isNull()) {
+    const QJsonValue value = json.value(latin1Key(key));
+    if (isAbsent(value)) {
         return std::nullopt;
     }
-    if (!json[qkey].isDouble()) {
-        throw std::invalid_argument(std::format("Invalid {} field", key));
+    const std::optional<qint32> number = value.isDouble() ? integralValue32(value) : std::nullopt;
+    if (!number) {
+        throwInvalidField(key, false);
     }
-    return json[qkey].toInt();
+    return number;
 }
 
 }  // namespace pawspective::utils::json
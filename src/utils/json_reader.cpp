@@ -0,0 +1,438 @@
+#include "utils/json_reader.hpp"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <charconv>
+
+namespace pawspective::utils::json {
+
+namespace {
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+void appendUtf8(QByteArray& out, char32_t codePoint) {
+    if (codePoint < 0x80) {
+        out.append(char(codePoint));
+    } else if (codePoint < 0x800) {
+        out.append(char(0xC0 | (codePoint >> 6)));
+        out.append(char(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        out.append(char(0xE0 | (codePoint >> 12)));
+        out.append(char(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.append(char(0x80 | (codePoint & 0x3F)));
+    } else {
+        out.append(char(0xF0 | (codePoint >> 18)));
+        out.append(char(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.append(char(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.append(char(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+}  // namespace
+
+JsonParseError::JsonParseError(qsizetype offset, const QString& message)
+    : std::runtime_error(QString("JSON parse error at %1: %2").arg(offset).arg(message).toStdString()),
+      m_offset(offset) {}
+
+JsonReader::JsonReader(QByteArrayView data) : m_data(data) {}
+
+void JsonReader::fail(const QString& message) const { throw JsonParseError(m_pos, message); }
+
+char JsonReader::skipWhitespace() {
+    while (m_pos < m_data.size()) {
+        const char c = m_data[m_pos];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+            return c;
+        }
+        ++m_pos;
+    }
+    return '\0';
+}
+
+void JsonReader::expect(char c) {
+    if (skipWhitespace() != c) {
+        fail(QString("expected '%1'").arg(QLatin1Char(c)));
+    }
+    ++m_pos;
+}
+
+void JsonReader::expectLiteral(QByteArrayView literal) {
+    if (m_data.sliced(m_pos).startsWith(literal)) {
+        m_pos += literal.size();
+        m_atContainerStart = false;
+        return;
+    }
+    fail("illegal value");
+}
+
+QJsonValue::Type JsonReader::peek() {
+    switch (skipWhitespace()) {
+        case '\0':
+            if (m_pos < m_data.size()) {
+                fail("illegal value");
+            }
+            if (m_depth > 0) {
+                fail("unterminated object or array");
+            }
+            return QJsonValue::Undefined;
+        case '{':
+            return QJsonValue::Object;
+        case '[':
+            return QJsonValue::Array;
+        case '"':
+            return QJsonValue::String;
+        case 't':
+        case 'f':
+            return QJsonValue::Bool;
+        case 'n':
+            return QJsonValue::Null;
+        default:
+            break;
+    }
+    const char c = m_data[m_pos];
+    if (c == '-' || isDigit(c)) {
+        return QJsonValue::Double;
+    }
+    fail("illegal value");
+}
+
+void JsonReader::enterContainer() {
+    if (++m_depth > maxDepth) {
+        fail("too deeply nested");
+    }
+    ++m_pos;
+    m_atContainerStart = true;
+}
+
+void JsonReader::beginObject() {
+    if (skipWhitespace() != '{') {
+        fail("expected object");
+    }
+    enterContainer();
+}
+
+std::optional<QByteArrayView> JsonReader::nextKey() {
+    char c = skipWhitespace();
+    if (c == '}') {
+        ++m_pos;
+        --m_depth;
+        m_atContainerStart = false;
+        return std::nullopt;
+    }
+    if (!m_atContainerStart) {
+        if (c != ',') {
+            fail("missing value separator");
+        }
+        ++m_pos;
+        c = skipWhitespace();
+    }
+    if (c != '"') {
+        fail("missing name");
+    }
+    const QByteArrayView key = readRawString(m_keyScratch);
+    expect(':');
+    m_atContainerStart = false;
+    return key;
+}
+
+void JsonReader::beginArray() {
+    if (skipWhitespace() != '[') {
+        fail("expected array");
+    }
+    enterContainer();
+}
+
+bool JsonReader::nextElement() {
+    const char c = skipWhitespace();
+    if (c == ']') {
+        ++m_pos;
+        --m_depth;
+        m_atContainerStart = false;
+        return false;
+    }
+    if (!m_atContainerStart) {
+        if (c != ',') {
+            fail("missing value separator");
+        }
+        ++m_pos;
+    }
+    m_atContainerStart = false;
+    return true;
+}
+
+QByteArrayView JsonReader::readRawString(QByteArray& scratch) {
+    ++m_pos;  // opening quote
+    const qsizetype start = m_pos;
+    // Fast path: no escapes, so the view points into the input.
+    while (m_pos < m_data.size()) {
+        const char c = m_data[m_pos];
+        if (c == '"') {
+            ++m_pos;
+            return m_data.sliced(start, m_pos - start - 1);
+        }
+        if (c == '\\') {
+            break;
+        }
+        if (static_cast<unsigned char>(c) < 0x20) {
+            fail("illegal character in string");
+        }
+        ++m_pos;
+    }
+
+    scratch.clear();
+    scratch.append(m_data.sliced(start, m_pos - start));
+    while (m_pos < m_data.size()) {
+        const char c = m_data[m_pos];
+        if (c == '"') {
+            ++m_pos;
+            return scratch;
+        }
+        if (c == '\\') {
+            readEscape(scratch);
+            continue;
+        }
+        if (static_cast<unsigned char>(c) < 0x20) {
+            fail("illegal character in string");
+        }
+        scratch.append(c);
+        ++m_pos;
+    }
+    fail("unterminated string");
+}
+
+void JsonReader::readEscape(QByteArray& out) {
+    ++m_pos;  // backslash
+    if (m_pos >= m_data.size()) {
+        fail("unterminated string");
+    }
+    const char c = m_data[m_pos++];
+    switch (c) {
+        case '"':
+        case '\\':
+        case '/':
+            out.append(c);
+            return;
+        case 'b':
+            out.append('\b');
+            return;
+        case 'f':
+            out.append('\f');
+            return;
+        case 'n':
+            out.append('\n');
+            return;
+        case 'r':
+            out.append('\r');
+            return;
+        case 't':
+            out.append('\t');
+            return;
+        case 'u':
+            break;
+        default:
+            fail("illegal escape sequence");
+    }
+
+    const auto readHex = [this]() {
+        if (m_pos + 4 > m_data.size()) {
+            fail("illegal unicode escape sequence");
+        }
+        char32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            const int digit = hexValue(m_data[m_pos++]);
+            if (digit < 0) {
+                fail("illegal unicode escape sequence");
+            }
+            value = (value << 4) | char32_t(digit);
+        }
+        return value;
+    };
+
+    char32_t codePoint = readHex();
+    if (codePoint >= 0xD800 && codePoint < 0xDC00) {
+        if (m_data.sliced(m_pos).startsWith("\\u")) {
+            m_pos += 2;
+            const char32_t low = readHex();
+            codePoint = low >= 0xDC00 && low < 0xE000 ? 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00)
+                                                      : char32_t(0xFFFD);
+        } else {
+            codePoint = 0xFFFD;
+        }
+    } else if (codePoint >= 0xDC00 && codePoint < 0xE000) {
+        codePoint = 0xFFFD;
+    }
+    appendUtf8(out, codePoint);
+}
+
+QString JsonReader::readString() {
+    if (skipWhitespace() != '"') {
+        fail("expected string");
+    }
+    const QByteArrayView raw = readRawString(m_stringScratch);
+    m_atContainerStart = false;
+    return QString::fromUtf8(raw);
+}
+
+QJsonValue JsonReader::readNumber() {
+    skipWhitespace();
+    const qsizetype start = m_pos;
+    bool integral = true;
+
+    if (m_pos < m_data.size() && m_data[m_pos] == '-') {
+        ++m_pos;
+    }
+    if (m_pos >= m_data.size() || !isDigit(m_data[m_pos])) {
+        fail("illegal number");
+    }
+    if (m_data[m_pos] == '0') {
+        ++m_pos;
+    } else {
+        while (m_pos < m_data.size() && isDigit(m_data[m_pos])) {
+            ++m_pos;
+        }
+    }
+    if (m_pos < m_data.size() && m_data[m_pos] == '.') {
+        integral = false;
+        ++m_pos;
+        if (m_pos >= m_data.size() || !isDigit(m_data[m_pos])) {
+            fail("illegal number");
+        }
+        while (m_pos < m_data.size() && isDigit(m_data[m_pos])) {
+            ++m_pos;
+        }
+    }
+    if (m_pos < m_data.size() && (m_data[m_pos] == 'e' || m_data[m_pos] == 'E')) {
+        integral = false;
+        ++m_pos;
+        if (m_pos < m_data.size() && (m_data[m_pos] == '+' || m_data[m_pos] == '-')) {
+            ++m_pos;
+        }
+        if (m_pos >= m_data.size() || !isDigit(m_data[m_pos])) {
+            fail("illegal number");
+        }
+        while (m_pos < m_data.size() && isDigit(m_data[m_pos])) {
+            ++m_pos;
+        }
+    }
+    m_atContainerStart = false;
+
+    const char* first = m_data.data() + start;
+    const char* last = m_data.data() + m_pos;
+    if (integral) {
+        qint64 value = 0;
+        if (std::from_chars(first, last, value).ec == std::errc()) {
+            return value;
+        }
+    }
+    double value = 0;
+    if (std::from_chars(first, last, value).ec != std::errc()) {
+        fail("illegal number");
+    }
+    return value;
+}
+
+bool JsonReader::readBool() {
+    const char c = skipWhitespace();
+    if (c == 't') {
+        expectLiteral("true");
+        return true;
+    }
+    if (c == 'f') {
+        expectLiteral("false");
+        return false;
+    }
+    fail("expected boolean");
+}
+
+void JsonReader::readNull() {
+    skipWhitespace();
+    expectLiteral("null");
+}
+
+QJsonValue JsonReader::readValue() {
+    switch (peek()) {
+        case QJsonValue::Object: {
+            QJsonObject object;
+            beginObject();
+            while (auto key = nextKey()) {
+                const QString name = QString::fromUtf8(*key);
+                object.insert(name, readValue());
+            }
+            return object;
+        }
+        case QJsonValue::Array: {
+            QJsonArray array;
+            beginArray();
+            while (nextElement()) {
+                array.append(readValue());
+            }
+            return array;
+        }
+        case QJsonValue::String:
+            return readString();
+        case QJsonValue::Double:
+            return readNumber();
+        case QJsonValue::Bool:
+            return readBool();
+        case QJsonValue::Null:
+            readNull();
+            return QJsonValue::Null;
+        default:
+            fail("unexpected end of input");
+    }
+}
+
+void JsonReader::skipValue() {
+    switch (peek()) {
+        case QJsonValue::Object:
+            beginObject();
+            while (nextKey()) {
+                skipValue();
+            }
+            return;
+        case QJsonValue::Array:
+            beginArray();
+            while (nextElement()) {
+                skipValue();
+            }
+            return;
+        case QJsonValue::String:
+            skipWhitespace();
+            readRawString(m_stringScratch);
+            m_atContainerStart = false;
+            return;
+        case QJsonValue::Double:
+            readNumber();
+            return;
+        case QJsonValue::Bool:
+            readBool();
+            return;
+        case QJsonValue::Null:
+            readNull();
+            return;
+        default:
+            fail("unexpected end of input");
+    }
+}
+
+void JsonReader::finish() {
+    skipWhitespace();
+    if (m_pos != m_data.size()) {
+        fail("garbage at the end of the document");
+    }
+}
+
+}  // namespace pawspective::utils::json
@@ -0,0 +1,78 @@
+#include "utils/string_pool.hpp"
+
+#include <QMutexLocker>
+#include <iterator>
+
+namespace pawspective::utils {
+
+StringPool::StringPool(qsizetype maxEntries, qsizetype maxLength) : m_maxEntries(maxEntries), m_maxLength(maxLength) {}
+
+StringPool& StringPool::global() {
+    static StringPool pool;
+    return pool;
+}
+
+QString StringPool::intern(const QString& value) {
+    QString interned;
+    return tryIntern(value, interned) ? interned : value;
+}
+
+QString StringPool::intern(QStringView value) {
+    QString interned;
+    return tryIntern(value, interned) ? interned : value.toString();
+}
+
+bool StringPool::tryIntern(QStringView value, QString& out) {
+    if (value.isEmpty() || value.size() > m_maxLength) {
+        return false;
+    }
+    // A non-owning key, so a hit does not allocate.
+    const QString key = QString::fromRawData(value.data(), value.size());
+    const QMutexLocker lock(&m_mutex);
+    if (const auto it = m_strings.constFind(key); it != m_strings.cend()) {
+        out = *it;
+        return true;
+    }
+    if (m_strings.size() >= m_maxEntries) {
+        if (m_lookupsUntilTrim > 0) {
+            --m_lookupsUntilTrim;
+            return false;
+        }
+        dropUnused();
+        if (m_strings.size() >= m_maxEntries) {
+            return false;
+        }
+    }
+    // A copy of its own, so the pool never pins a larger buffer the value happens to point into.
+    out = QString(value.data(), value.size());
+    m_strings.insert(out);
+    m_lookupsUntilTrim = qMax<qsizetype>(0, m_lookupsUntilTrim - 1);
+    return true;
+}
+
+void StringPool::dropUnused() {
+    for (auto it = m_strings.begin(); it != m_strings.end();) {
+        it = it->isDetached() ? m_strings.erase(it) : std::next(it);
+    }
+    m_lookupsUntilTrim = m_maxEntries / 4;
+}
+
+qsizetype StringPool::trim() {
+    const QMutexLocker lock(&m_mutex);
+    const qsizetype before = m_strings.size();
+    dropUnused();
+    return before - m_strings.size();
+}
+
+void StringPool::clear() {
+    const QMutexLocker lock(&m_mutex);
+    m_strings.clear();
+    m_lookupsUntilTrim = 0;
+}
+
+qsizetype StringPool::size() const {
+    const QMutexLocker lock(&m_mutex);
+    return m_strings.size();
+}
+
+}  // namespace pawspective::utils
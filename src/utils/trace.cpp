@@ -0,0 +1,221 @@
+#include "utils/trace.hpp"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QThread>
+#include <utility>
+#include <vector>
+
+namespace pawspective::utils::trace {
+
+namespace detail {
+std::atomic_bool enabled = false;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+}
+
+namespace {
+
+struct Event {
+    QByteArray name;
+    const char* category;
+    char phase;
+    qint64 timestampNs;
+    qint64 durationNs;
+    int threadId;
+    quint64 flow;
+};
+
+struct Recorder {
+    QMutex mutex;
+    QElapsedTimer clock;
+    QString path;
+    std::vector<Event> events;
+    QList<std::pair<int, QString>> threads;
+    QList<quint64> awaitingFrame;
+    std::atomic<quint64> nextFlow = 0;
+    std::atomic_int nextThreadId = 0;
+};
+
+Recorder& recorder() {
+    static Recorder instance;
+    return instance;
+}
+
+thread_local quint64 currentFlowId = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+int threadId() {
+    thread_local int id = -1;
+    if (id < 0) {
+        Recorder& r = recorder();
+        id = ++r.nextThreadId;
+        const bool isMain = QCoreApplication::instance() != nullptr &&
+                            QThread::currentThread() == QCoreApplication::instance()->thread();
+        const QString name = isMain ? QString("main") : QString("thread %1").arg(id);
+        const QMutexLocker lock(&r.mutex);
+        r.threads.append({id, name});
+    }
+    return id;
+}
+
+void record(Event event) {
+    Recorder& r = recorder();
+    const QMutexLocker lock(&r.mutex);
+    r.events.push_back(std::move(event));
+}
+
+qint64 now() { return recorder().clock.nsecsElapsed(); }
+
+}  // namespace
+
+void start(const QString& path) {
+    Recorder& r = recorder();
+    {
+        const QMutexLocker lock(&r.mutex);
+        r.path = path;
+        r.events.clear();
+        r.events.reserve(16384);
+        r.awaitingFrame.clear();
+        r.clock.start();
+    }
+    detail::enabled.store(true, std::memory_order_relaxed);
+}
+
+bool stop() {
+    if (!detail::enabled.exchange(false)) {
+        return false;
+    }
+    Recorder& r = recorder();
+    const QMutexLocker lock(&r.mutex);
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray events;
+    for (const auto& [id, name] : std::as_const(r.threads)) {
+        events.append(QJsonObject{
+            {"ph", "M"},
+            {"name", "thread_name"},
+            {"pid", pid},
+            {"tid", id},
+            {"args", QJsonObject{{"name", name}}}
+        });
+    }
+    for (const Event& event : r.events) {
+        QJsonObject object{
+            {"ph", QString(QChar::fromLatin1(event.phase))},
+            {"name", QString::fromUtf8(event.name)},
+            {"cat", QString::fromLatin1(event.category)},
+            {"ts", static_cast<double>(event.timestampNs) / 1000.0},
+            {"pid", pid},
+            {"tid", event.threadId}
+        };
+        if (event.phase == 'X') {
+            object["dur"] = static_cast<double>(event.durationNs) / 1000.0;
+        } else {
+            // Flow events bind to the slice that encloses them rather than to the next one.
+            object["id"] = QString::number(event.flow);
+            object["bp"] = "e";
+        }
+        events.append(object);
+    }
+    r.events.clear();
+
+    QSaveFile file(r.path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(QJsonDocument(QJsonObject{{"traceEvents", events}, {"displayTimeUnit", "ms"}}).toJson());
+    return file.commit();
+}
+
+quint64 currentFlow() { return currentFlowId; }
+
+Scope::Scope(const char* name, const char* category, bool beginsFlow)
+    : m_category(category), m_beginsFlow(beginsFlow) {
+    if (!isEnabled()) {
+        return;
+    }
+    m_name = QByteArray(name);
+    m_startNs = now();
+    if (m_beginsFlow) {
+        m_flow = ++recorder().nextFlow;
+        m_previousFlow = std::exchange(currentFlowId, m_flow);
+    } else {
+        m_flow = currentFlowId;
+    }
+}
+
+Scope::Scope(QByteArray name, const char* category) : m_name(std::move(name)), m_category(category) {
+    if (!isEnabled()) {
+        return;
+    }
+    m_startNs = now();
+    m_flow = currentFlowId;
+}
+
+Scope::~Scope() {
+    if (m_startNs < 0) {
+        return;
+    }
+    const int tid = threadId();
+    record({m_name, m_category, 'X', m_startNs, now() - m_startNs, tid, 0});
+    if (m_flow != 0) {
+        record({"flow", "flow", m_beginsFlow ? 's' : 't', m_startNs, 0, tid, m_flow});
+    }
+    if (m_beginsFlow) {
+        currentFlowId = m_previousFlow;
+    }
+}
+
+FlowScope::FlowScope(quint64 flow) : m_previous(std::exchange(currentFlowId, flow)) {}
+
+FlowScope::~FlowScope() { currentFlowId = m_previous; }
+
+void complete(const QByteArray& name, const char* category, qint64 durationNs) {
+    if (!isEnabled()) {
+        return;
+    }
+    const int tid = threadId();
+    const qint64 end = now();
+    const qint64 begin = qMax<qint64>(0, end - durationNs);
+    record({name, category, 'X', begin, end - begin, tid, 0});
+    if (currentFlowId != 0) {
+        record({"flow", "flow", 't', begin, 0, tid, currentFlowId});
+    }
+}
+
+void awaitFrame() {
+    if (!isEnabled() || currentFlowId == 0) {
+        return;
+    }
+    Recorder& r = recorder();
+    const QMutexLocker lock(&r.mutex);
+    r.awaitingFrame.append(currentFlowId);
+}
+
+void frameRendered() {
+    if (!isEnabled()) {
+        return;
+    }
+    Recorder& r = recorder();
+    QList<quint64> flows;
+    {
+        const QMutexLocker lock(&r.mutex);
+        flows = std::exchange(r.awaitingFrame, {});
+    }
+    if (flows.isEmpty()) {
+        return;
+    }
+    const int tid = threadId();
+    const qint64 timestamp = now();
+    record({"frame", "render", 'X', timestamp, 1000, tid, 0});
+    for (quint64 flow : flows) {
+        record({"flow", "flow", 'f', timestamp, 0, tid, flow});
+    }
+}
+
+}  // namespace pawspective::utils::trace
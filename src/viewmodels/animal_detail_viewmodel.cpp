@@ -15,10 +15,14 @@ AnimalDetailViewModel::AnimalDetailViewModel(
         &m_animalService,
         &services::AnimalService::getAnimalSuccess,
         this,
-        [this](const models::AnimalDTO& animal) {
-            setFromDTO(animal);
+        [this](const models::SharedAnimal& animal) {
+            // Batched lookups answer every caller, so an answer for an animal no longer on screen can arrive here.
+            if (animal->id != m_animalId) {
+                return;
+            }
+            setFromDTO(*animal);
             if (m_organizationId > 0) {
-                m_organizationService.getOrganization(m_organizationId);
+                m_organizationService.getOrganization(m_organizationId, requestOptions());
             } else {
                 setIsBusy(false);
             }
@@ -28,7 +32,10 @@ AnimalDetailViewModel::AnimalDetailViewModel(
         &m_animalService,
         &services::AnimalService::getAnimalFailed,
         this,
-        [this](QSharedPointer<services::BaseError> error) {
+        [this](QSharedPointer<services::BaseError> error, qint64 id) {
+            if (id != m_animalId) {
+                return;
+            }
             setIsBusy(false);
             if (const auto& validationError = error.dynamicCast<services::ValidationError>()) {
                 emitError(ValidationError, formatValidationError(validationError));
@@ -41,16 +48,22 @@ AnimalDetailViewModel::AnimalDetailViewModel(
         &m_organizationService,
         &services::OrganizationService::getOrganizationSuccess,
         this,
-        [this](const models::OrganizationDTO& org) {
+        [this](const models::SharedOrganization& org) {
+            if (org->id != m_organizationId) {
+                return;
+            }
             setIsBusy(false);
-            setFromOrgDTO(org);
+            setFromOrgDTO(*org);
         }
     );
     connect(
         &m_organizationService,
         &services::OrganizationService::getOrganizationFailed,
         this,
-        [this](QSharedPointer<services::BaseError> error) {
+        [this](QSharedPointer<services::BaseError> error, qint64 id) {
+            if (id != m_organizationId) {
+                return;
+            }
             setIsBusy(false);
             emitError(NetworkError, error->getMessage());
         }
@@ -59,7 +72,8 @@ AnimalDetailViewModel::AnimalDetailViewModel(
 
 void AnimalDetailViewModel::loadAnimal(qint64 id) {
     setIsBusy(true);
-    m_animalService.getAnimal(id);
+    m_animalId = id;
+    m_animalService.getAnimal(id, requestOptions(services::RequestPriority::Interactive, "animal"));
 }
 
 void AnimalDetailViewModel::setFromDTO(const models::AnimalDTO& dto) {
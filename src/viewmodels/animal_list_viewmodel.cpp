@@ -8,6 +8,9 @@
 #include <QVariantMap>
 
 #include "services/errors.hpp"
+#include "utils/enum_table.hpp"
+#include "utils/string_pool.hpp"
+#include "utils/trace.hpp"
 
 namespace pawspective::viewmodels::detail {
 
@@ -54,6 +57,8 @@ QHash<int, QByteArray> AnimalListInternalModel::roleNames() const {
 }
 
 void AnimalListInternalModel::update(const QList<models::AnimalDTO>& dtos) {
+    PAWS_TRACE_SCOPE("AnimalListInternalModel::update");
+    PAWS_TRACE_AWAIT_FRAME();
     clear();
 
     if (!dtos.isEmpty()) {
@@ -64,17 +69,7 @@ void AnimalListInternalModel::update(const QList<models::AnimalDTO>& dtos) {
             item.name = dto.name;
             item.description = dto.description.value_or("");
             item.age = dto.age;
-            // TODO: map animal type to human-readable string
-            switch (dto.breed.animalType) {
-                case models::AnimalType::Dog:
-                    item.animalType = "Dog";
-                    break;
-                case models::AnimalType::Cat:
-                    item.animalType = "Cat";
-                    break;
-                default:
-                    item.animalType = "Other";
-            }
+            item.animalType = utils::displayName(dto.breed.animalType);
             m_items.append(item);
         }
         endInsertRows();
@@ -93,145 +88,13 @@ void AnimalListInternalModel::clear() {
 
 namespace {
 
-QString normalizeFilterValue(const QString& value) {
-    QString normalized = value.trimmed().toLower();
-    normalized.replace('-', '_');
-    normalized.replace(' ', '_');
-    return normalized;
-}
-
-std::optional<pawspective::models::AnimalType> parseAnimalType(const QString& value) {
-    const QString normalized = normalizeFilterValue(value);
-    if (normalized == "dog") {
-        return pawspective::models::AnimalType::Dog;
-    }
-    if (normalized == "cat") {
-        return pawspective::models::AnimalType::Cat;
-    }
-    if (normalized == "other" || normalized == "rabbit" || normalized == "bird") {
-        return pawspective::models::AnimalType::Other;
-    }
-    return std::nullopt;
-}
-
-std::optional<pawspective::models::AnimalSize> parseAnimalSize(const QString& value) {
-    const QString normalized = normalizeFilterValue(value);
-    if (normalized == "small") {
-        return pawspective::models::AnimalSize::Small;
-    }
-    if (normalized == "medium") {
-        return pawspective::models::AnimalSize::Medium;
-    }
-    if (normalized == "large" || normalized == "xlarge" || normalized == "x_large" || normalized == "extra_large") {
-        return pawspective::models::AnimalSize::Large;
-    }
-    return std::nullopt;
-}
-
-std::optional<pawspective::models::AnimalGender> parseAnimalGender(const QString& value) {
-    const QString normalized = normalizeFilterValue(value);
-    if (normalized == "male") {
-        return pawspective::models::AnimalGender::Male;
-    }
-    if (normalized == "female") {
-        return pawspective::models::AnimalGender::Female;
-    }
-    if (normalized == "unknown") {
-        return pawspective::models::AnimalGender::Unknown;
-    }
-    return std::nullopt;
-}
-
-std::optional<pawspective::models::CareLevel> parseCareLevel(const QString& value) {
-    const QString normalized = normalizeFilterValue(value);
-    if (normalized == "easy" || normalized == "low") {
-        return pawspective::models::CareLevel::Easy;
-    }
-    if (normalized == "moderate" || normalized == "medium") {
-        return pawspective::models::CareLevel::Moderate;
-    }
-    if (normalized == "difficult" || normalized == "high") {
-        return pawspective::models::CareLevel::Difficult;
-    }
-    if (normalized == "special_needs") {
-        return pawspective::models::CareLevel::SpecialNeeds;
-    }
-    return std::nullopt;
-}
-
-std::optional<pawspective::models::AnimalColor> parseAnimalColor(const QString& value) {
-    const QString normalized = normalizeFilterValue(value);
-    if (normalized == "gray") {
-        return pawspective::models::AnimalColor::Grey;
-    }
-    if (normalized == "ginger") {
-        return pawspective::models::AnimalColor::Orange;
-    }
-
-    if (normalized == "black") {
-        return pawspective::models::AnimalColor::Black;
-    }
-    if (normalized == "white") {
-        return pawspective::models::AnimalColor::White;
-    }
-    if (normalized == "brown") {
-        return pawspective::models::AnimalColor::Brown;
-    }
-    if (normalized == "grey") {
-        return pawspective::models::AnimalColor::Grey;
-    }
-    if (normalized == "orange") {
-        return pawspective::models::AnimalColor::Orange;
-    }
-    if (normalized == "cream") {
-        return pawspective::models::AnimalColor::Cream;
-    }
-    if (normalized == "tan") {
-        return pawspective::models::AnimalColor::Tan;
-    }
-    if (normalized == "golden") {
-        return pawspective::models::AnimalColor::Golden;
-    }
-    if (normalized == "spotted") {
-        return pawspective::models::AnimalColor::Spotted;
-    }
-    if (normalized == "striped") {
-        return pawspective::models::AnimalColor::Striped;
-    }
-    if (normalized == "brindle") {
-        return pawspective::models::AnimalColor::Brindle;
-    }
-    if (normalized == "mixed") {
-        return pawspective::models::AnimalColor::Mixed;
-    }
-    return std::nullopt;
-}
-
-std::optional<pawspective::models::GoodWith> parseGoodWith(const QString& value) {
-    const QString normalized = normalizeFilterValue(value);
-    if (normalized == "dogs") {
-        return pawspective::models::GoodWith::Dogs;
-    }
-    if (normalized == "cats") {
-        return pawspective::models::GoodWith::Cats;
-    }
-    if (normalized == "children" || normalized == "kids") {
-        return pawspective::models::GoodWith::Children;
-    }
-    if (normalized == "elderly") {
-        return pawspective::models::GoodWith::Elderly;
-    }
-    return std::nullopt;
-}
-
+// Filter values arrive as API names in any case ("SPECIAL_NEEDS"), as display names ("Special Needs") or as an
+// alias from the enum table ("gray"); unknown values are dropped.
 template <typename T>
-std::optional<QVector<T>> parseEnumVector(
-    const QVariantList& rawValues,
-    const std::function<std::optional<T>(const QString&)>& parser
-) {
+std::optional<QVector<T>> parseEnumVector(const QVariantList& rawValues) {
     QVector<T> parsed;
     for (const auto& rawValue : rawValues) {
-        const auto parsedValue = parser(rawValue.toString());
+        const auto parsedValue = pawspective::utils::enumFromInput<T>(rawValue.toString());
         if (parsedValue.has_value()) {
             parsed.append(parsedValue.value());
         }
@@ -243,20 +106,6 @@ std::optional<QVector<T>> parseEnumVector(
     return parsed;
 }
 
-QString toDisplayLabel(const QString& rawValue) {
-    QString normalized = rawValue;
-    normalized.replace('_', ' ');
-    normalized = normalized.trimmed().toLower();
-
-    QStringList words = normalized.split(' ', Qt::SkipEmptyParts);
-    for (QString& word : words) {
-        if (!word.isEmpty()) {
-            word[0] = word[0].toUpper();
-        }
-    }
-    return words.join(' ');
-}
-
 QVariantMap toFilterOption(const QString& dtoField, const QString& dtoValue, const QString& displayName) {
     QVariantMap item;
     item.insert("dtoField", dtoField);
@@ -266,19 +115,15 @@ QVariantMap toFilterOption(const QString& dtoField, const QString& dtoValue, con
 }
 
 template <typename T>
-QVariantList toEnumFilterOptions(
-    const std::optional<QVector<T>>& values,
-    const QString& field,
-    QString (*converter)(T)
-) {
+QVariantList toEnumFilterOptions(const std::optional<QVector<T>>& values, const QString& field) {
     QVariantList result;
     if (!values.has_value()) {
         return result;
     }
 
     for (const auto& value : values.value()) {
-        const QString apiValue = converter(value).toUpper();
-        result.append(toFilterOption(field, apiValue, toDisplayLabel(apiValue)));
+        const QString apiValue = pawspective::utils::apiString(value).toUpper();
+        result.append(toFilterOption(field, apiValue, pawspective::utils::displayName(value)));
     }
     return result;
 }
@@ -378,10 +223,14 @@ QAbstractListModel* AnimalListViewModel::listModel() { return m_listModel; }
 void AnimalListViewModel::initialize() { loadAvailableFilters(); }
 
 void AnimalListViewModel::cleanup() {
+    BaseViewModel::cleanup();
+    updateProperty(m_isLoading, false, [this]() { emit isLoadingChanged(); });
+    setIsBusy(false);
     if (auto internalModel = qobject_cast<detail::AnimalListInternalModel*>(m_listModel)) {
         qDebug() << "Cleaning up AnimalListViewModel, clearing internal model";
         internalModel->clear();
     }
+    utils::StringPool::global().trim();
 }
 
 void AnimalListViewModel::replaceAllAnimals(const QList<models::AnimalDTO>& animals) {
@@ -406,10 +255,17 @@ void AnimalListViewModel::loadAnimalsForOrganization(qint64 organizationId) {
 
     updateProperty(m_isLoading, true, [this]() { emit isLoadingChanged(); });
     setIsBusy(true);
-    m_animalService.getAnimalsByOrganization(organizationId, m_currentPage, m_pageSize);
+    m_animalService.getAnimalsByOrganization(
+        organizationId,
+        m_currentPage,
+        m_pageSize,
+        requestOptions(services::RequestPriority::Visible, "animals")
+    );
 }
 
 void AnimalListViewModel::loadAnimalByFilters(const QVariantMap& filterData) {
+    // Called straight from the Apply action in SearchView.qml, so the flow starts with the user's click.
+    PAWS_TRACE_FLOW_BEGIN("AnimalListViewModel::loadAnimalByFilters");
     m_currentOrganizationId = 0;
 
     models::AnimalFilterDTO filter;
@@ -460,12 +316,12 @@ void AnimalListViewModel::loadAnimalByFilters(const QVariantMap& filterData) {
         }
     }
 
-    filter.animalTypes = parseEnumVector<models::AnimalType>(groupedFilters.value("animalTypes"), parseAnimalType);
-    filter.sizes = parseEnumVector<models::AnimalSize>(groupedFilters.value("sizes"), parseAnimalSize);
-    filter.genders = parseEnumVector<models::AnimalGender>(groupedFilters.value("genders"), parseAnimalGender);
-    filter.careLevels = parseEnumVector<models::CareLevel>(groupedFilters.value("careLevels"), parseCareLevel);
-    filter.colors = parseEnumVector<models::AnimalColor>(groupedFilters.value("colors"), parseAnimalColor);
-    filter.goodWiths = parseEnumVector<models::GoodWith>(groupedFilters.value("goodWiths"), parseGoodWith);
+    filter.animalTypes = parseEnumVector<models::AnimalType>(groupedFilters.value("animalTypes"));
+    filter.sizes = parseEnumVector<models::AnimalSize>(groupedFilters.value("sizes"));
+    filter.genders = parseEnumVector<models::AnimalGender>(groupedFilters.value("genders"));
+    filter.careLevels = parseEnumVector<models::CareLevel>(groupedFilters.value("careLevels"));
+    filter.colors = parseEnumVector<models::AnimalColor>(groupedFilters.value("colors"));
+    filter.goodWiths = parseEnumVector<models::GoodWith>(groupedFilters.value("goodWiths"));
 
     // Only add age filters if they were explicitly provided in filterData
     if (filterData.contains("ageMin") && ageMin >= 0) {
@@ -495,7 +351,7 @@ void AnimalListViewModel::loadAnimalByFilters(const QVariantMap& filterData) {
 
     updateProperty(m_isLoading, true, [this]() { emit isLoadingChanged(); });
     setIsBusy(true);
-    m_animalService.getAnimals(m_currentFilter);
+    m_animalService.getAnimals(m_currentFilter, requestOptions(services::RequestPriority::Visible, "animals"));
 }
 
 void AnimalListViewModel::goToPage(int page) {
@@ -507,7 +363,12 @@ void AnimalListViewModel::goToPage(int page) {
         m_currentPage = page;
         updateProperty(m_isLoading, true, [this]() { emit isLoadingChanged(); });
         setIsBusy(true);
-        m_animalService.getAnimalsByOrganization(m_currentOrganizationId, m_currentPage, m_pageSize);
+        m_animalService.getAnimalsByOrganization(
+            m_currentOrganizationId,
+            m_currentPage,
+            m_pageSize,
+            requestOptions(services::RequestPriority::Visible, "animals")
+        );
         return;
     }
 
@@ -515,7 +376,7 @@ void AnimalListViewModel::goToPage(int page) {
     m_currentFilter.page = page;
     updateProperty(m_isLoading, true, [this]() { emit isLoadingChanged(); });
     setIsBusy(true);
-    m_animalService.getAnimals(m_currentFilter);
+    m_animalService.getAnimals(m_currentFilter, requestOptions(services::RequestPriority::Visible, "animals"));
 }
 
 void AnimalListViewModel::nextPage() {
@@ -530,7 +391,9 @@ void AnimalListViewModel::prevPage() {
     }
 }
 
-void AnimalListViewModel::loadAvailableFilters() { m_cityService.getCities(); }
+void AnimalListViewModel::loadAvailableFilters() {
+    m_cityService.getCities(requestOptions(services::RequestPriority::Background));
+}
 
 void AnimalListViewModel::loadBreedsForAnimalTypes(const QVariantList& selectedTypes) {
     QSet<models::AnimalType> requestedTypes;
@@ -546,7 +409,7 @@ void AnimalListViewModel::loadBreedsForAnimalTypes(const QVariantList& selectedT
             typeValue = rawEntry.toString();
         }
 
-        const auto parsedType = parseAnimalType(typeValue);
+        const auto parsedType = utils::enumFromInput<models::AnimalType>(typeValue);
         if (parsedType.has_value()) {
             requestedTypes.insert(parsedType.value());
         }
@@ -568,21 +431,22 @@ void AnimalListViewModel::loadBreedsForAnimalTypes(const QVariantList& selectedT
     }
 
     for (const auto type : m_requestedBreedTypes) {
-        m_breedService.getBreedsByType(type);
+        m_breedService.getBreedsByType(type, requestOptions(services::RequestPriority::Background));
     }
 }
 
-void AnimalListViewModel::handleGetAnimalsSuccess(const models::AnimalListDTO& result) {
+void AnimalListViewModel::handleGetAnimalsSuccess(const models::SharedAnimalList& result) {
+    PAWS_TRACE_SCOPE("AnimalListViewModel::handleGetAnimalsSuccess");
     if (auto internalModel = qobject_cast<detail::AnimalListInternalModel*>(m_listModel)) {
         qDebug()
-            << "Received" << result.items.size() << "animals by filters (page" << result.page << "of"
-            << result.totalPages << ")";
-        internalModel->update(result.items);
-    }
-    m_currentPage = result.page;
-    m_totalPages = result.totalPages;
-    m_totalCount = result.totalCount;
-    m_pageSize = result.limit > 0 ? result.limit : m_pageSize;
+            << "Received" << result->items.size() << "animals by filters (page" << result->page << "of"
+            << result->totalPages << ")";
+        internalModel->update(result->items);
+    }
+    m_currentPage = result->page;
+    m_totalPages = result->totalPages;
+    m_totalCount = result->totalCount;
+    m_pageSize = result->limit > 0 ? result->limit : m_pageSize;
     emit paginationChanged();
     updateProperty(m_isLoading, false, [this]() { emit isLoadingChanged(); });
     setIsBusy(false);
@@ -597,17 +461,17 @@ void AnimalListViewModel::handleGetAnimalsFailed(QSharedPointer<services::BaseEr
     }
 }
 
-void AnimalListViewModel::handleGetAnimalsByOrganizationSuccess(const models::AnimalListDTO& result) {
+void AnimalListViewModel::handleGetAnimalsByOrganizationSuccess(const models::SharedAnimalList& result) {
     if (auto internalModel = qobject_cast<detail::AnimalListInternalModel*>(m_listModel)) {
         qDebug()
-            << "Received" << result.items.size() << "animals for organization" << m_currentOrganizationId << "(page"
-            << result.page << "of" << result.totalPages << ")";
-        internalModel->update(result.items);
-    }
-    m_currentPage = result.page;
-    m_totalPages = result.totalPages;
-    m_totalCount = result.totalCount;
-    m_pageSize = result.limit > 0 ? result.limit : m_pageSize;
+            << "Received" << result->items.size() << "animals for organization" << m_currentOrganizationId << "(page"
+            << result->page << "of" << result->totalPages << ")";
+        internalModel->update(result->items);
+    }
+    m_currentPage = result->page;
+    m_totalPages = result->totalPages;
+    m_totalCount = result->totalCount;
+    m_pageSize = result->limit > 0 ? result->limit : m_pageSize;
     emit paginationChanged();
     updateProperty(m_isLoading, false, [this]() { emit isLoadingChanged(); });
     setIsBusy(false);
@@ -625,16 +489,12 @@ void AnimalListViewModel::handleGetAnimalsByOrganizationFailed(QSharedPointer<se
 
 void AnimalListViewModel::handleGetAnimalFiltersSuccess(const models::AnimalFilterDTO& filters) {
     const QVariantList breeds = m_requestedBreedTypes.isEmpty() ? QVariantList() : m_availableBreeds;
-    const QVariantList
-        animalTypes = toEnumFilterOptions<models::AnimalType>(filters.animalTypes, "animalTypes", models::toApiString);
-    const QVariantList sizes = toEnumFilterOptions<models::AnimalSize>(filters.sizes, "sizes", models::toApiString);
-    const QVariantList
-        genders = toEnumFilterOptions<models::AnimalGender>(filters.genders, "genders", models::toApiString);
-    const QVariantList
-        careLevels = toEnumFilterOptions<models::CareLevel>(filters.careLevels, "careLevels", models::toApiString);
-    const QVariantList colors = toEnumFilterOptions<models::AnimalColor>(filters.colors, "colors", models::toApiString);
-    const QVariantList
-        goodWiths = toEnumFilterOptions<models::GoodWith>(filters.goodWiths, "goodWiths", models::toApiString);
+    const QVariantList animalTypes = toEnumFilterOptions(filters.animalTypes, "animalTypes");
+    const QVariantList sizes = toEnumFilterOptions(filters.sizes, "sizes");
+    const QVariantList genders = toEnumFilterOptions(filters.genders, "genders");
+    const QVariantList careLevels = toEnumFilterOptions(filters.careLevels, "careLevels");
+    const QVariantList colors = toEnumFilterOptions(filters.colors, "colors");
+    const QVariantList goodWiths = toEnumFilterOptions(filters.goodWiths, "goodWiths");
     const QVariantList cities = buildCityFilterOptions(filters.cities, m_cityNames);
 
     const bool changed =
@@ -715,7 +575,7 @@ void AnimalListViewModel::handleGetCitiesSuccess(const QList<models::CityDTO>& c
     for (const auto& city : cities) {
         m_cityNames[city.id] = city.name;
     }
-    m_animalService.getAnimalFilters();
+    m_animalService.getAnimalFilters(requestOptions(services::RequestPriority::Background));
 }
 
 void AnimalListViewModel::handleGetCitiesFailed(QSharedPointer<services::BaseError> error) {
@@ -723,7 +583,7 @@ void AnimalListViewModel::handleGetCitiesFailed(QSharedPointer<services::BaseErr
         qWarning() << "Failed to load cities:" << error->getMessage();
         emitError(ErrorType::NetworkError, error->getMessage());
     }
-    m_animalService.getAnimalFilters();
+    m_animalService.getAnimalFilters(requestOptions(services::RequestPriority::Background));
 }
 
 }  // namespace pawspective::viewmodels
@@ -1,14 +1,30 @@
 #include "viewmodels/base.hpp"
 
+#include "services/metrics_registry.hpp"
+
 namespace pawspective::viewmodels {
 BaseViewModel::BaseViewModel(QObject* parent) : QObject(parent) {}
 
 bool BaseViewModel::isBusy() const { return m_isBusy; }
 
 void BaseViewModel::setIsBusy(bool value) {
-    updateProperty(m_isBusy, value, [this]() { emit isBusyChanged(); });
+    if (!updateProperty(m_isBusy, value, [this]() { emit isBusyChanged(); })) {
+        return;
+    }
+    if (value) {
+        m_busyTimer.start();
+    } else if (m_busyTimer.isValid()) {
+        services::MetricsRegistry::global().observeMs(
+            "pawspective_viewmodel_busy_seconds",
+            {{"viewmodel", QString::fromLatin1(metaObject()->className())}},
+            static_cast<double>(m_busyTimer.nsecsElapsed()) / 1e6
+        );
+        m_busyTimer.invalidate();
+    }
 }
 
+void BaseViewModel::cleanup() { cancelPendingRequests(); }
+
 void BaseViewModel::emitError(ErrorType type, const QString& message) { emit errorOccurred(type, message); }
 
 QString BaseViewModel::formatValidationError(QSharedPointer<services::BaseError> error) {
@@ -30,4 +46,27 @@ QString BaseViewModel::formatValidationError(QSharedPointer<services::BaseError>
     return error->getMessage();
 }
 
+void BaseViewModel::emitQueuedChangeRejected(const QString& what, QSharedPointer<services::BaseError> error) {
+    // The form closed when the change was queued, so this goes to the app-wide notice instead of the form.
+    emit queuedChangeRejected(QString("%1: %2").arg(what, formatValidationError(error)));
+}
+
+services::RequestOptions BaseViewModel::requestOptions(
+    services::RequestPriority priority,
+    const QString& supersedeKey
+) const {
+    services::RequestOptions options;
+    options.priority = priority;
+    options.cancellationToken = m_requestToken;
+    if (!supersedeKey.isEmpty()) {
+        options.supersedeKey = QString::fromLatin1(metaObject()->className()) + "::" + supersedeKey;
+    }
+    return options;
+}
+
+void BaseViewModel::cancelPendingRequests() {
+    m_requestToken.cancel();
+    m_requestToken = services::CancellationToken::create();
+}
+
 }  // namespace pawspective::viewmodels
@@ -25,6 +25,20 @@ void CreateAnimalViewModel::setupConnections() {
 
     connect(&m_animalService, &services::AnimalService::createAnimalFailed, this, &CreateAnimalViewModel::onError);
 
+    // A create stored for later is as final for the form as a confirmed one.
+    connect(
+        &m_animalService,
+        &services::AnimalService::createAnimalQueued,
+        this,
+        &CreateAnimalViewModel::onAnimalCreated
+    );
+    connect(
+        &m_animalService,
+        &services::AnimalService::createAnimalRejected,
+        this,
+        &CreateAnimalViewModel::onQueuedCreateRejected
+    );
+
     connect(
         &m_animalService,
         &services::AnimalService::getAnimalFiltersSuccess,
@@ -78,7 +92,7 @@ void CreateAnimalViewModel::setAnimalType(const QString& value) {
 void CreateAnimalViewModel::loadBreedsForType(models::AnimalType type) {
     m_isLoadingBreeds = true;
     emit isBreedEnabledChanged();
-    m_breedService.getBreedsByType(type);
+    m_breedService.getBreedsByType(type, requestOptions(services::RequestPriority::Background));
 }
 
 void CreateAnimalViewModel::onBreedsLoaded(const QList<models::BreedDTO>& breeds) {
@@ -199,6 +213,10 @@ void CreateAnimalViewModel::onError(QSharedPointer<services::BaseError> error) {
     emit creationFinished(false);
 }
 
+void CreateAnimalViewModel::onQueuedCreateRejected(QSharedPointer<services::BaseError> error) {
+    emitQueuedChangeRejected("An animal created while offline was not saved", error);
+}
+
 void CreateAnimalViewModel::createAnimal() {
     if (!validateRequiredFields()) {
         emit creationFinished(false);
@@ -212,12 +230,14 @@ void CreateAnimalViewModel::createAnimal() {
 
 void CreateAnimalViewModel::loadFilters() {
     setIsBusy(true);
-    m_animalService.getAnimalFilters();
+    m_animalService.getAnimalFilters(requestOptions(services::RequestPriority::Background));
 }
 
 void CreateAnimalViewModel::initialize() { loadFilters(); }
 
 void CreateAnimalViewModel::cleanup() {
+    BaseViewModel::cleanup();
+    setIsBusy(false);
     m_registerDto = models::AnimalRegisterDTO{};
     m_registerDto.status = models::AnimalStatus::Available;
     m_registerDto.age = 0;
@@ -0,0 +1,76 @@
+#include "viewmodels/network_inspector_viewmodel.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace pawspective::viewmodels {
+
+NetworkInspectorViewModel::NetworkInspectorViewModel(services::NetworkClient& networkClient, QObject* parent)
+    : QObject(parent), m_networkClient(networkClient) {
+    connect(&m_networkClient, &services::NetworkClient::requestTimed, this, [this]() {
+        if (m_active) {
+            refresh();
+        }
+    });
+}
+
+void NetworkInspectorViewModel::setActive(bool active) {
+    if (m_active == active) {
+        return;
+    }
+    m_active = active;
+    emit activeChanged();
+    if (m_active) {
+        refresh();
+    }
+}
+
+int NetworkInspectorViewModel::slowThresholdMs() const { return m_networkClient.slowRequestThreshold(); }
+
+void NetworkInspectorViewModel::setSlowThresholdMs(int ms) {
+    if (m_networkClient.slowRequestThreshold() == ms) {
+        return;
+    }
+    m_networkClient.setSlowRequestThreshold(ms);
+    emit slowThresholdMsChanged();
+    refresh();
+}
+
+void NetworkInspectorViewModel::refresh() {
+    const QList<services::RequestTiming> timings = m_networkClient.timeline().entries();
+    const int threshold = slowThresholdMs();
+
+    QVariantList requests;
+    requests.reserve(timings.size());
+    for (auto it = timings.crbegin(); it != timings.crend(); ++it) {
+        QVariantMap entry = it->toJson().toVariantMap();
+        entry["slow"] = threshold > 0 && it->totalMs() >= threshold;
+        requests.append(entry);
+    }
+    m_requests = std::move(requests);
+    emit requestsChanged();
+}
+
+void NetworkInspectorViewModel::clear() {
+    m_networkClient.timeline().clear();
+    refresh();
+}
+
+QString NetworkInspectorViewModel::dumpJson() {
+    const QDir dir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+    dir.mkpath(".");
+    const QString path =
+        dir.filePath(QString("network-timings-%1.json").arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss")));
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return {};
+    }
+    file.write(QJsonDocument(m_networkClient.timeline().toJson(slowThresholdMs())).toJson());
+    return file.commit() ? path : QString();
+}
+
+}  // namespace pawspective::viewmodels
@@ -54,12 +54,12 @@ bool OrganizationViewModel::hasOrganization() const { return m_hasOrganization;
 
 bool OrganizationViewModel::canUpdateOrganization() const { return m_canUpdateOrganization; }
 
-const QString& OrganizationViewModel::organizationName() const { return m_organizationData.name; }
+const QString& OrganizationViewModel::organizationName() const { return m_organizationData->name; }
 
-const QString& OrganizationViewModel::organizationCity() const { return m_organizationData.city.name; }
+const QString& OrganizationViewModel::organizationCity() const { return m_organizationData->city.name; }
 
 QString OrganizationViewModel::organizationDescription() const {
-    return m_organizationData.description.has_value() ? m_organizationData.description.value() : QString();
+    return m_organizationData->description.has_value() ? m_organizationData->description.value() : QString();
 }
 
 bool OrganizationViewModel::showDescription() const { return m_showDescription; }
@@ -90,6 +90,7 @@ void OrganizationViewModel::initialize() {
 }
 
 void OrganizationViewModel::cleanup() {
+    BaseViewModel::cleanup();
     setIsBusy(false);
     setShowDescription(false);
     setCurrentTab(2);
@@ -150,15 +151,21 @@ void OrganizationViewModel::handleGetCurrentUserFailed(QSharedPointer<services::
     handleNetworkFailure(error, true);
 }
 
-void OrganizationViewModel::handleGetOrganizationSuccess(const models::OrganizationDTO& organization) {
+void OrganizationViewModel::handleGetOrganizationSuccess(const models::SharedOrganization& organization) {
+    if (organization->id != m_requestedOrganizationId) {
+        return;
+    }
     applyOrganizationLoaded(organization, true);
 }
 
-void OrganizationViewModel::handleGetOrganizationFailed(QSharedPointer<services::BaseError> error) {
+void OrganizationViewModel::handleGetOrganizationFailed(QSharedPointer<services::BaseError> error, qint64 id) {
+    if (id != m_requestedOrganizationId) {
+        return;
+    }
     handleNetworkFailure(error, true);
 }
 
-void OrganizationViewModel::handleCreateOrganizationSuccess(const models::OrganizationDTO& organization) {
+void OrganizationViewModel::handleCreateOrganizationSuccess(const models::SharedOrganization& organization) {
     applyOrganizationLoaded(organization, true, true);
 }
 
@@ -166,7 +173,7 @@ void OrganizationViewModel::handleCreateOrganizationFailed(QSharedPointer<servic
     handleNetworkFailure(error, false);
 }
 
-void OrganizationViewModel::handleUpdateOrganizationSuccess(const models::OrganizationDTO& organization) {
+void OrganizationViewModel::handleUpdateOrganizationSuccess(const models::SharedOrganization& organization) {
     applyOrganizationLoaded(organization, true);
 }
 
@@ -206,13 +213,13 @@ void OrganizationViewModel::resetOrganizationState() {
 }
 
 void OrganizationViewModel::applyOrganizationLoaded(
-    const models::OrganizationDTO& organization,
+    const models::SharedOrganization& organization,
     bool hasOrganizationValue,
     std::optional<bool> canUpdateOrganizationValue
 ) {
     setIsBusy(false);
     updateOrganizationData(organization);
-    updateProperty(m_currentOrganizationId, organization.id, [this] { emit currentOrganizationIdChanged(); });
+    updateProperty(m_currentOrganizationId, organization->id, [this] { emit currentOrganizationIdChanged(); });
     updateProperty(m_hasOrganization, hasOrganizationValue, [this] { emit hasOrganizationChanged(); });
     if (canUpdateOrganizationValue.has_value()) {
         updateProperty(m_canUpdateOrganization, canUpdateOrganizationValue.value(), [this] {
@@ -240,16 +247,17 @@ void OrganizationViewModel::loadOrganizationById(qint64 organizationId) {
     }
 
     setIsBusy(true);
-    m_organizationService.getOrganization(organizationId);
+    m_requestedOrganizationId = organizationId;
+    m_organizationService.getOrganization(organizationId, requestOptions());
 }
 
-void OrganizationViewModel::updateOrganizationData(const models::OrganizationDTO& organization) {
+void OrganizationViewModel::updateOrganizationData(const models::SharedOrganization& organization) {
     m_organizationData = organization;
     emit organizationDataChanged();
 }
 
 void OrganizationViewModel::clearOrganizationData() {
-    m_organizationData = models::OrganizationDTO{};
+    m_organizationData = {};
     emit organizationDataChanged();
 }
 
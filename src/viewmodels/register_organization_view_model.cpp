@@ -17,7 +17,7 @@ RegisterOrganizationViewModel::RegisterOrganizationViewModel(
         &m_organizationService,
         &services::OrganizationService::createOrganizationSuccess,
         this,
-        [this](const models::OrganizationDTO&) {
+        [this](const models::SharedOrganization&) {
             setIsBusy(false);
             emit registrationFinished(true);
         }
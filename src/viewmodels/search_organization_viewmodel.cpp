@@ -31,6 +31,7 @@ void SearchOrganizationViewModel::initialize() {
 }
 
 void SearchOrganizationViewModel::cleanup() {
+    BaseViewModel::cleanup();
     setIsBusy(false);
     clearResults();
     m_searchQuery.clear();
@@ -47,7 +48,7 @@ void SearchOrganizationViewModel::setSearchQuery(const QString& query) {
 }
 
 void SearchOrganizationViewModel::searchOrganizations() {
-    if (m_searchQuery.length() >= 1 && !isBusy()) {
+    if (m_searchQuery.length() >= 1) {
         performSearch(1);
     }
 }
@@ -62,7 +63,7 @@ void SearchOrganizationViewModel::clearResults() {
 }
 
 void SearchOrganizationViewModel::goToPage(int page) {
-    if (page < 1 || page > m_totalPages || isBusy()) {
+    if (page < 1 || page > m_totalPages) {
         return;
     }
     performSearch(page);
@@ -81,28 +82,29 @@ void SearchOrganizationViewModel::prevPage() {
 }
 
 void SearchOrganizationViewModel::performSearch(int page) {
-    if (isBusy()) {
-        return;
-    }
-
+    // A newer query supersedes the one still in flight, so its results can never overwrite these.
     setIsBusy(true);
     updateProperty(m_isSearching, true, [this]() { emit isSearchingChanged(); });
-    m_organizationService.findByNameContaining(m_searchQuery, page);
+    m_organizationService.findByNameContaining(
+        m_searchQuery,
+        page,
+        requestOptions(services::RequestPriority::Visible, "search")
+    );
 }
 
-void SearchOrganizationViewModel::handleSearchSuccess(const models::OrganizationListDTO& result) {
+void SearchOrganizationViewModel::handleSearchSuccess(const models::SharedOrganizationList& result) {
     setIsBusy(false);
     updateProperty(m_isSearching, false, [this]() { emit isSearchingChanged(); });
 
-    m_currentPage = result.page;
-    m_totalPages = result.totalPages;
-    m_totalCount = result.totalCount;
+    m_currentPage = result->page;
+    m_totalPages = result->totalPages;
+    m_totalCount = result->totalCount;
     emit paginationChanged();
 
-    if (result.items.isEmpty()) {
+    if (result->items.isEmpty()) {
         clearOrganizationsList();
     } else {
-        updateOrganizationsList(result.items);
+        updateOrganizationsList(result->items);
     }
 }
 
@@ -25,6 +25,18 @@ void UpdateAnimalViewModel::setupConnections() {
         this,
         &UpdateAnimalViewModel::handleUpdateSuccess
     );
+    connect(
+        &m_animalService,
+        &services::AnimalService::updateAnimalQueued,
+        this,
+        &UpdateAnimalViewModel::handleUpdateQueued
+    );
+    connect(
+        &m_animalService,
+        &services::AnimalService::updateAnimalRejected,
+        this,
+        &UpdateAnimalViewModel::handleQueuedUpdateRejected
+    );
     connect(
         &m_animalService,
         &services::AnimalService::updateAnimalFailed,
@@ -64,7 +76,7 @@ void UpdateAnimalViewModel::initialize() {
     setIsBusy(true);
     loadFilters();
     if (m_animalId > 0) {
-        m_animalService.getAnimal(m_animalId);
+        m_animalService.getAnimal(m_animalId, requestOptions(services::RequestPriority::Interactive));
     } else {
         setIsBusy(false);
         emit loadFailed("Invalid animal ID");
@@ -72,13 +84,14 @@ void UpdateAnimalViewModel::initialize() {
 }
 
 void UpdateAnimalViewModel::cleanup() {
+    BaseViewModel::cleanup();
     setIsBusy(false);
     discardChanges();
     m_breedsList.clear();
     m_isLoadingBreeds = false;
     m_animalId = 0;
     m_currentAnimalType = std::nullopt;
-    m_originalData = models::AnimalDTO{};
+    m_originalData = {};
     m_filterDto = models::AnimalFilterDTO{};
 }
 
@@ -86,56 +99,56 @@ QString UpdateAnimalViewModel::animalType() const {
     if (m_currentAnimalType.has_value()) {
         return models::toApiString(m_currentAnimalType.value());
     }
-    if (m_originalData.breed.id > 0) {
-        return models::toApiString(m_originalData.breed.animalType);
+    if (m_originalData->breed.id > 0) {
+        return models::toApiString(m_originalData->breed.animalType);
     }
     return "";
 }
 
-qint64 UpdateAnimalViewModel::breedId() const { return m_changes.breedId.value_or(m_originalData.breed.id); }
+qint64 UpdateAnimalViewModel::breedId() const { return m_changes.breedId.value_or(m_originalData->breed.id); }
 
 QString UpdateAnimalViewModel::size() const {
     if (m_changes.size.has_value()) {
         return models::toApiString(m_changes.size.value());
     }
-    return models::toApiString(m_originalData.size);
+    return models::toApiString(m_originalData->size);
 }
 
 QString UpdateAnimalViewModel::gender() const {
     if (m_changes.gender.has_value()) {
         return models::toApiString(m_changes.gender.value());
     }
-    return models::toApiString(m_originalData.gender);
+    return models::toApiString(m_originalData->gender);
 }
 
-int UpdateAnimalViewModel::age() const { return m_changes.age.value_or(m_originalData.age); }
+int UpdateAnimalViewModel::age() const { return m_changes.age.value_or(m_originalData->age); }
 
 QString UpdateAnimalViewModel::careLevel() const {
     if (m_changes.careLevel.has_value()) {
         return models::toApiString(m_changes.careLevel.value());
     }
-    return models::toApiString(m_originalData.careLevel);
+    return models::toApiString(m_originalData->careLevel);
 }
 
 QString UpdateAnimalViewModel::color() const {
     if (m_changes.color.has_value()) {
         return models::toApiString(m_changes.color.value());
     }
-    return models::toApiString(m_originalData.color);
+    return models::toApiString(m_originalData->color);
 }
 
 QString UpdateAnimalViewModel::goodWith() const {
     if (m_changes.goodWith.has_value()) {
         return models::toApiString(m_changes.goodWith.value());
     }
-    return models::toApiString(m_originalData.goodWith);
+    return models::toApiString(m_originalData->goodWith);
 }
 
 QString UpdateAnimalViewModel::status() const {
     if (m_changes.status.has_value()) {
         return models::toApiString(m_changes.status.value());
     }
-    return models::toApiString(m_originalData.status);
+    return models::toApiString(m_originalData->status);
 }
 
 bool UpdateAnimalViewModel::isBreedEnabled() const { return !m_isLoadingBreeds; }
@@ -163,7 +176,7 @@ QVariantList UpdateAnimalViewModel::statuses() const {
 
 void UpdateAnimalViewModel::setName(const QString& value) {
     if (name() != value) {
-        auto original = m_originalData.name;
+        auto original = m_originalData->name;
         m_changes.name = (value == original) ? std::nullopt : std::make_optional(value);
         emit nameChanged();
         updateDirtyStatus();
@@ -172,7 +185,7 @@ void UpdateAnimalViewModel::setName(const QString& value) {
 
 void UpdateAnimalViewModel::setDescription(const QString& value) {
     if (description() != value) {
-        QString original = m_originalData.description.value_or("");
+        QString original = m_originalData->description.value_or("");
         m_changes.description = (value == original) ? std::nullopt : std::make_optional(value);
         emit descriptionChanged();
         updateDirtyStatus();
@@ -185,7 +198,7 @@ void UpdateAnimalViewModel::setAnimalType(const QString& value) {
     }
 
     auto newType = models::animalTypeFromApi(value.toLower());
-    auto currentType = m_currentAnimalType.has_value() ? m_currentAnimalType.value() : m_originalData.breed.animalType;
+    auto currentType = m_currentAnimalType.has_value() ? m_currentAnimalType.value() : m_originalData->breed.animalType;
 
     if (currentType != newType) {
         m_currentAnimalType = newType;
@@ -207,7 +220,7 @@ void UpdateAnimalViewModel::setAnimalType(const QString& value) {
 
 void UpdateAnimalViewModel::setBreedId(qint64 value) {
     if (breedId() != value) {
-        m_changes.breedId = (value == m_originalData.breed.id) ? std::nullopt : std::make_optional(value);
+        m_changes.breedId = (value == m_originalData->breed.id) ? std::nullopt : std::make_optional(value);
         emit breedIdChanged();
         updateDirtyStatus();
     }
@@ -219,7 +232,7 @@ void UpdateAnimalViewModel::setSize(const QString& value) {
         newSize = models::animalSizeFromApi(value.toLower());
     }
 
-    auto currentSize = m_changes.size.has_value() ? m_changes.size.value() : m_originalData.size;
+    auto currentSize = m_changes.size.has_value() ? m_changes.size.value() : m_originalData->size;
 
     if (currentSize != newSize) {
         m_changes.size = newSize;
@@ -234,7 +247,7 @@ void UpdateAnimalViewModel::setGender(const QString& value) {
         newGender = models::animalGenderFromApi(value.toLower());
     }
 
-    auto currentGender = m_changes.gender.has_value() ? m_changes.gender.value() : m_originalData.gender;
+    auto currentGender = m_changes.gender.has_value() ? m_changes.gender.value() : m_originalData->gender;
 
     if (currentGender != newGender) {
         m_changes.gender = newGender;
@@ -245,7 +258,7 @@ void UpdateAnimalViewModel::setGender(const QString& value) {
 
 void UpdateAnimalViewModel::setAge(int value) {
     if (age() != value) {
-        m_changes.age = (value == m_originalData.age) ? std::nullopt : std::make_optional(value);
+        m_changes.age = (value == m_originalData->age) ? std::nullopt : std::make_optional(value);
         emit ageChanged();
         updateDirtyStatus();
     }
@@ -257,7 +270,7 @@ void UpdateAnimalViewModel::setCareLevel(const QString& value) {
         newCareLevel = models::careLevelFromApi(value.toLower());
     }
 
-    auto currentCareLevel = m_changes.careLevel.has_value() ? m_changes.careLevel.value() : m_originalData.careLevel;
+    auto currentCareLevel = m_changes.careLevel.has_value() ? m_changes.careLevel.value() : m_originalData->careLevel;
 
     if (currentCareLevel != newCareLevel) {
         m_changes.careLevel = newCareLevel;
@@ -272,7 +285,7 @@ void UpdateAnimalViewModel::setColor(const QString& value) {
         newColor = models::animalColorFromApi(value.toLower());
     }
 
-    auto currentColor = m_changes.color.has_value() ? m_changes.color.value() : m_originalData.color;
+    auto currentColor = m_changes.color.has_value() ? m_changes.color.value() : m_originalData->color;
 
     if (currentColor != newColor) {
         m_changes.color = newColor;
@@ -287,7 +300,7 @@ void UpdateAnimalViewModel::setGoodWith(const QString& value) {
         newGoodWith = models::goodWithFromApi(value.toLower());
     }
 
-    auto currentGoodWith = m_changes.goodWith.has_value() ? m_changes.goodWith.value() : m_originalData.goodWith;
+    auto currentGoodWith = m_changes.goodWith.has_value() ? m_changes.goodWith.value() : m_originalData->goodWith;
 
     if (currentGoodWith != newGoodWith) {
         m_changes.goodWith = newGoodWith;
@@ -302,21 +315,23 @@ void UpdateAnimalViewModel::setStatus(const QString& value) {
     }
 
     auto newStatus = models::animalStatusFromApi(value.toLower());
-    auto currentStatus = m_changes.status.has_value() ? m_changes.status.value() : m_originalData.status;
+    auto currentStatus = m_changes.status.has_value() ? m_changes.status.value() : m_originalData->status;
 
     if (currentStatus != newStatus) {
-        m_changes.status = (newStatus == m_originalData.status) ? std::nullopt : std::make_optional(newStatus);
+        m_changes.status = (newStatus == m_originalData->status) ? std::nullopt : std::make_optional(newStatus);
         emit statusChanged();
         updateDirtyStatus();
     }
 }
 
-void UpdateAnimalViewModel::loadFilters() { m_animalService.getAnimalFilters(); }
+void UpdateAnimalViewModel::loadFilters() {
+    m_animalService.getAnimalFilters(requestOptions(services::RequestPriority::Background));
+}
 
 void UpdateAnimalViewModel::loadBreedsForType(models::AnimalType type) {
     m_isLoadingBreeds = true;
     emit isBreedEnabledChanged();
-    m_breedService.getBreedsByType(type);
+    m_breedService.getBreedsByType(type, requestOptions(services::RequestPriority::Background));
 }
 
 void UpdateAnimalViewModel::updateBreedsList(const QList<models::BreedDTO>& breeds) {
@@ -343,11 +358,15 @@ bool UpdateAnimalViewModel::validateRequiredFields() {
     return true;
 }
 
-void UpdateAnimalViewModel::handleGetSuccess(const models::AnimalDTO& animal) {
+void UpdateAnimalViewModel::handleGetSuccess(const models::SharedAnimal& animal) {
+    // Other screens load animals through the same service; only the one being edited belongs here.
+    if (animal->id != m_animalId) {
+        return;
+    }
     m_originalData = animal;
 
-    if (animal.breed.id > 0) {
-        m_currentAnimalType = animal.breed.animalType;
+    if (animal->breed.id > 0) {
+        m_currentAnimalType = animal->breed.animalType;
         loadBreedsForType(m_currentAnimalType.value());
     } else {
         m_currentAnimalType = models::AnimalType::Other;
@@ -359,14 +378,17 @@ void UpdateAnimalViewModel::handleGetSuccess(const models::AnimalDTO& animal) {
     emit loadCompleted();
 }
 
-void UpdateAnimalViewModel::handleGetFailed(QSharedPointer<services::BaseError> error) {
+void UpdateAnimalViewModel::handleGetFailed(QSharedPointer<services::BaseError> error, qint64 id) {
+    if (id != m_animalId) {
+        return;
+    }
     setIsBusy(false);
     QString msg = error ? error->getMessage() : "Failed to load animal data";
     emit loadFailed(msg);
     emitError(ErrorType::NetworkError, msg);
 }
 
-void UpdateAnimalViewModel::handleUpdateSuccess(const models::AnimalDTO& animal) {
+void UpdateAnimalViewModel::handleUpdateSuccess(const models::SharedAnimal& animal) {
     setIsBusy(false);
     m_originalData = animal;
     m_changes = models::AnimalUpdateDTO();
@@ -375,6 +397,12 @@ void UpdateAnimalViewModel::handleUpdateSuccess(const models::AnimalDTO& animal)
     emit saveCompleted();
 }
 
+void UpdateAnimalViewModel::handleUpdateQueued() {
+    // Stored for sending once online; the edits stay pending until the server confirms them.
+    setIsBusy(false);
+    emit saveCompleted();
+}
+
 void UpdateAnimalViewModel::handleUpdateFailed(QSharedPointer<services::BaseError> error) {
     setIsBusy(false);
     if (!error) {
@@ -395,6 +423,10 @@ void UpdateAnimalViewModel::handleUpdateFailed(QSharedPointer<services::BaseErro
     emit saveFailed(message);
 }
 
+void UpdateAnimalViewModel::handleQueuedUpdateRejected(QSharedPointer<services::BaseError> error) {
+    emitQueuedChangeRejected("Animal changes made while offline were not saved", error);
+}
+
 void UpdateAnimalViewModel::handleFiltersLoaded(const models::AnimalFilterDTO& filters) {
     m_filterDto = filters;
     emit animalTypesChanged();
@@ -438,7 +470,7 @@ void UpdateAnimalViewModel::saveChanges() {
 
 void UpdateAnimalViewModel::discardChanges() {
     m_changes = models::AnimalUpdateDTO();
-    m_currentAnimalType = m_originalData.breed.animalType;
+    m_currentAnimalType = m_originalData->breed.animalType;
     setDirty(false);
     notifyAllChanged();
 }
@@ -27,6 +27,18 @@ UpdateOrganizationViewModel::UpdateOrganizationViewModel(
         this,
         &UpdateOrganizationViewModel::handleUpdateSuccess
     );
+    connect(
+        &m_organizationService,
+        &services::OrganizationService::updateOrganizationQueued,
+        this,
+        &UpdateOrganizationViewModel::handleUpdateQueued
+    );
+    connect(
+        &m_organizationService,
+        &services::OrganizationService::updateOrganizationRejected,
+        this,
+        &UpdateOrganizationViewModel::handleQueuedUpdateRejected
+    );
     connect(
         &m_organizationService,
         &services::OrganizationService::getOrganizationFailed,
@@ -84,13 +96,13 @@ void UpdateOrganizationViewModel::cleanup() {
     discardChanges();
 }
 
-QString UpdateOrganizationViewModel::name() const { return m_changes.name.value_or(m_originalData.name); }
+QString UpdateOrganizationViewModel::name() const { return m_changes.name.value_or(m_originalData->name); }
 
 QString UpdateOrganizationViewModel::description() const {
-    return m_changes.description.value_or(m_originalData.description.value_or(""));
+    return m_changes.description.value_or(m_originalData->description.value_or(""));
 }
 
-qint64 UpdateOrganizationViewModel::cityId() const { return m_changes.cityId.value_or(m_originalData.city.id); }
+qint64 UpdateOrganizationViewModel::cityId() const { return m_changes.cityId.value_or(m_originalData->city.id); }
 
 int UpdateOrganizationViewModel::currentCityIndex() const {
     qint64 currentId = cityId();
@@ -104,7 +116,7 @@ int UpdateOrganizationViewModel::currentCityIndex() const {
 
 void UpdateOrganizationViewModel::setName(const QString& value) {
     if (name() != value) {
-        m_changes.name = (value == m_originalData.name) ? std::nullopt : std::make_optional(value);
+        m_changes.name = (value == m_originalData->name) ? std::nullopt : std::make_optional(value);
         emit nameChanged();
         updateDirtyStatus();
     }
@@ -112,7 +124,7 @@ void UpdateOrganizationViewModel::setName(const QString& value) {
 
 void UpdateOrganizationViewModel::setDescription(const QString& value) {
     if (description() != value) {
-        QString original = m_originalData.description.value_or("");
+        QString original = m_originalData->description.value_or("");
         m_changes.description = (value == original) ? std::nullopt : std::make_optional(value);
         emit descriptionChanged();
         updateDirtyStatus();
@@ -121,7 +133,7 @@ void UpdateOrganizationViewModel::setDescription(const QString& value) {
 
 void UpdateOrganizationViewModel::setCityId(qint64 value) {
     if (cityId() != value) {
-        m_changes.cityId = (value == m_originalData.city.id) ? std::nullopt : std::make_optional(value);
+        m_changes.cityId = (value == m_originalData->city.id) ? std::nullopt : std::make_optional(value);
         emit cityIdChanged();
         emit currentCityIndexChanged();
         updateDirtyStatus();
@@ -133,7 +145,7 @@ void UpdateOrganizationViewModel::saveChanges() {
         return;
     }
     setIsBusy(true);
-    m_organizationService.updateOrganization(m_originalData.id, m_changes);
+    m_organizationService.updateOrganization(m_originalData->id, m_changes);
 }
 
 void UpdateOrganizationViewModel::discardChanges() {
@@ -144,21 +156,25 @@ void UpdateOrganizationViewModel::discardChanges() {
 
 void UpdateOrganizationViewModel::handleGetCurrentUserSuccess(const models::UserDTO& user) {
     if (user.organizationId.has_value()) {
-        m_organizationService.getOrganization(user.organizationId.value());
+        m_organizationId = user.organizationId.value();
+        m_organizationService.getOrganization(m_organizationId);
     } else {
         setIsBusy(false);
         emit loadFailed("User is not associated with any organization");
     }
 }
 
-void UpdateOrganizationViewModel::handleGetSuccess(const models::OrganizationDTO& organization) {
+void UpdateOrganizationViewModel::handleGetSuccess(const models::SharedOrganization& organization) {
+    if (organization->id != m_organizationId) {
+        return;
+    }
     setIsBusy(false);
     m_originalData = organization;
     discardChanges();
     emit loadCompleted();
 }
 
-void UpdateOrganizationViewModel::handleUpdateSuccess(const models::OrganizationDTO& organization) {
+void UpdateOrganizationViewModel::handleUpdateSuccess(const models::SharedOrganization& organization) {
     setIsBusy(false);
     m_originalData = organization;
     m_changes = models::OrganizationUpdateDTO();
@@ -167,6 +183,16 @@ void UpdateOrganizationViewModel::handleUpdateSuccess(const models::Organization
     emit saveCompleted();
 }
 
+void UpdateOrganizationViewModel::handleUpdateQueued() {
+    // Stored for sending once online; the edits stay pending until the server confirms them.
+    setIsBusy(false);
+    emit saveCompleted();
+}
+
+void UpdateOrganizationViewModel::handleQueuedUpdateRejected(QSharedPointer<services::BaseError> error) {
+    emitQueuedChangeRejected("Organization changes made while offline were not saved", error);
+}
+
 void UpdateOrganizationViewModel::handleCitiesSuccess(const QList<models::CityDTO>& cities) {
     QVariantList list;
     for (const auto& city : cities) {
@@ -179,7 +205,10 @@ void UpdateOrganizationViewModel::handleCitiesSuccess(const QList<models::CityDT
     emit currentCityIndexChanged();
 }
 
-void UpdateOrganizationViewModel::handleGetFailed(QSharedPointer<services::BaseError> error) {
+void UpdateOrganizationViewModel::handleGetFailed(QSharedPointer<services::BaseError> error, qint64 id) {
+    if (id != m_organizationId) {
+        return;
+    }
     setIsBusy(false);
     QString msg = error ? error->getMessage() : "Failed to load organization data";
     emit loadFailed(msg);
@@ -0,0 +1,58 @@
+#include <QtTest>
+
+#include "models/animal_enums.hpp"
+#include "utils/enum_table.hpp"
+
+using namespace pawspective::models;  // NOLINT google-build-using-namespace
+using pawspective::utils::displayName;
+using pawspective::utils::enumFromApi;
+using pawspective::utils::enumFromInput;
+
+class TestAnimalEnums : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testApiNamesRoundTrip();
+    void testApiParsingIsExact();
+    void testInputParsingAcceptsAliasesAndDisplayNames();
+    void testDisplayNames();
+};
+
+void TestAnimalEnums::testApiNamesRoundTrip() {
+    for (int i = 0; i <= static_cast<int>(AnimalColor::Mixed); ++i) {
+        const auto color = static_cast<AnimalColor>(i);
+        QCOMPARE(animalColorFromApi(toApiString(color)), color);
+    }
+    QCOMPARE(toApiString(CareLevel::SpecialNeeds), QString("special_needs"));
+    QCOMPARE(toApiString(AnimalStatus::Unavailable), QString("unavailable"));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, toApiString(static_cast<AnimalSize>(7)));
+}
+
+void TestAnimalEnums::testApiParsingIsExact() {
+    QCOMPARE(enumFromApi<GoodWith>(u"children"), std::optional(GoodWith::Children));
+    QVERIFY(!enumFromApi<GoodWith>(u"Children").has_value());
+    QVERIFY(!enumFromApi<GoodWith>(u"kids").has_value());
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, animalSizeFromApi("huge"));
+}
+
+void TestAnimalEnums::testInputParsingAcceptsAliasesAndDisplayNames() {
+    QCOMPARE(enumFromInput<AnimalColor>(u"gray"), std::optional(AnimalColor::Grey));
+    QCOMPARE(enumFromInput<AnimalColor>(u"Ginger"), std::optional(AnimalColor::Orange));
+    QCOMPARE(enumFromInput<CareLevel>(u" Special Needs "), std::optional(CareLevel::SpecialNeeds));
+    QCOMPARE(enumFromInput<CareLevel>(u"SPECIAL_NEEDS"), std::optional(CareLevel::SpecialNeeds));
+    QCOMPARE(enumFromInput<CareLevel>(u"medium"), std::optional(CareLevel::Moderate));
+    QCOMPARE(enumFromInput<AnimalSize>(u"extra-large"), std::optional(AnimalSize::Large));
+    QCOMPARE(enumFromInput<AnimalType>(u"rabbit"), std::optional(AnimalType::Other));
+    QVERIFY(!enumFromInput<AnimalType>(u"hamster").has_value());
+    QVERIFY(!enumFromInput<AnimalType>(u"ǆog").has_value());
+}
+
+void TestAnimalEnums::testDisplayNames() {
+    QCOMPARE(displayName(CareLevel::SpecialNeeds), QString("Special Needs"));
+    QCOMPARE(displayName(AnimalType::Dog), QString("Dog"));
+    QCOMPARE(displayName(GoodWith::Elderly), QString("Elderly"));
+}
+
+QTEST_MAIN(TestAnimalEnums)
+
+#include "animal_enums_test.moc"
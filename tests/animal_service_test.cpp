@@ -1,8 +1,8 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
-#include <QNetworkReply>
 #include <QSharedPointer>
+#include <QUrlQuery>
 #include <QtTest>
 
 #include "models/animal_dto.hpp"
@@ -16,33 +16,6 @@
 using namespace pawspective::models;   // NOLINT google-build-using-namespace
 using namespace pawspective::services; // NOLINT google-build-using-namespace
 
-// ---------------------------------------------------------------------------
-// Fake QNetworkReply that serves pre-baked data
-
-class FakeNetworkReply : public QNetworkReply {
-    Q_OBJECT
-public:
-    explicit FakeNetworkReply(const QByteArray& data, QObject* parent = nullptr)
-        : QNetworkReply(parent), m_data(data) {
-        open(QIODevice::ReadOnly);
-    }
-    void abort() override {}
-    qint64 bytesAvailable() const override { return m_data.size() - m_pos; }
-    bool isSequential() const override { return true; }
-
-protected:
-    qint64 readData(char* data, qint64 maxSize) override {
-        qint64 n = qMin(maxSize, static_cast<qint64>(m_data.size() - m_pos));
-        memcpy(data, m_data.constData() + m_pos, static_cast<size_t>(n));
-        m_pos += n;
-        return n;
-    }
-
-private:
-    QByteArray m_data;
-    qint64 m_pos = 0;
-};
-
 // ---------------------------------------------------------------------------
 // MockNetworkClient — captures callbacks; lets tests trigger them manually
 
@@ -55,31 +28,46 @@ public:
         QByteArray body;
         CallbackHandler onSuccess;
         CallbackHandler onError;
+        RequestOptions options;
     };
 
     QList<Call> getCalls;
     QList<Call> postCalls;
     QList<Call> putCalls;
 
-    void get(const QUrl& url, CallbackHandler ok, CallbackHandler err) override {
-        getCalls.append({url, {}, ok, err});
+    void get(const QUrl& url, CallbackHandler ok, CallbackHandler err, const RequestOptions& options) override {
+        getCalls.append({url, {}, ok, err, options});
     }
-    void post(const QUrl& url, const QByteArray& data, CallbackHandler ok, CallbackHandler err) override {
-        postCalls.append({url, data, ok, err});
+    void post(
+        const QUrl& url,
+        const QByteArray& data,
+        CallbackHandler ok,
+        CallbackHandler err,
+        const RequestOptions& options
+    ) override {
+        postCalls.append({url, data, ok, err, options});
     }
-    void put(const QUrl& url, const QByteArray& data, CallbackHandler ok, CallbackHandler err) override {
-        putCalls.append({url, data, ok, err});
+    void put(
+        const QUrl& url,
+        const QByteArray& data,
+        CallbackHandler ok,
+        CallbackHandler err,
+        const RequestOptions& options
+    ) override {
+        putCalls.append({url, data, ok, err, options});
     }
-    void patch(const QUrl&, const QByteArray&, CallbackHandler, CallbackHandler) override {}
-    void deleteResource(const QUrl&, CallbackHandler, CallbackHandler) override {}
+    void patch(const QUrl&, const QByteArray&, CallbackHandler, CallbackHandler, const RequestOptions&) override {}
+    void deleteResource(const QUrl&, CallbackHandler, CallbackHandler, const RequestOptions&) override {}
 
     void triggerSuccess(QList<Call>& calls, const QByteArray& data, int idx = 0) {
-        FakeNetworkReply reply(data);
-        calls[idx].onSuccess(reply);
+        NetworkResponse response;
+        response.body = data;
+        calls[idx].onSuccess(response);
     }
     void triggerError(QList<Call>& calls, const QByteArray& data, int idx = 0) {
-        FakeNetworkReply reply(data);
-        calls[idx].onError(reply);
+        NetworkResponse response;
+        response.body = data;
+        calls[idx].onError(response);
     }
 };
 
@@ -236,6 +224,11 @@ private slots:
     void testGetAnimal_NetworkError_EmitsGetAnimalFailed();
     void testGetAnimal_InvalidJson_EmitsGetAnimalFailed();
     void testGetAnimal_ServerError_DoesNotEmitOtherSignals();
+    void testGetAnimal_Batching_CoalescesIntoOneRequest();
+    void testGetAnimal_Batching_FallsBackToSingleGets();
+    void testGetAnimal_Batching_SupersededCallerIsDropped();
+    void testGetAnimal_Batching_CancelledSingleFreesItsSlot();
+    void testGetAnimal_Batching_MalformedItemFailsOnce();
 
     // createAnimal signal tests
     void testCreateAnimal_Success_EmitsCreateAnimalSuccess();
@@ -258,6 +251,8 @@ private slots:
     void testGetAnimalFilters_NetworkError_EmitsGetAnimalFiltersFailed();
     void testGetAnimalFilters_InvalidJson_EmitsGetAnimalFiltersFailed();
     void testGetAnimalFilters_ServerError_DoesNotEmitOtherSignals();
+    void testGetAnimalFilters_UsesBackgroundPriority();
+    void testGetAnimal_UsesInteractivePriority();
 
     // getAnimalsByOrganization signal tests
     void testGetAnimalsByOrganization_Success_EmitsGetAnimalsByOrganizationSuccess();
@@ -561,7 +556,7 @@ void TestAnimalService::testGetAnimal_Success_EmitsGetAnimalSuccess() {
     QCOMPARE(successSpy.count(), 1);
     QCOMPARE(failedSpy.count(), 0);
 
-    auto animal = qvariant_cast<AnimalDTO>(successSpy.at(0).at(0));
+    auto animal = *qvariant_cast<SharedAnimal>(successSpy.at(0).at(0));
     QCOMPARE(animal.id, static_cast<qint64>(1));
     QCOMPARE(animal.name, QString("Buddy"));
 }
@@ -610,6 +605,142 @@ void TestAnimalService::testGetAnimal_ServerError_DoesNotEmitOtherSignals() {
     QCOMPARE(createFailed.count(), 0);
 }
 
+void TestAnimalService::testGetAnimal_Batching_CoalescesIntoOneRequest() {
+    MockNetworkClient mock;
+    AnimalService service(mock);
+    service.setBatchingEnabled(true);
+
+    QSignalSpy successSpy(&service, &AnimalService::getAnimalSuccess);
+    QSignalSpy failedSpy(&service, &AnimalService::getAnimalFailed);
+
+    service.getAnimal(1);
+    service.getAnimal(2);
+    service.getAnimal(1);
+    service.getAnimal(3);
+    QCOMPARE(mock.getCalls.size(), 0);
+
+    QCoreApplication::processEvents();
+    QCOMPARE(mock.getCalls.size(), 1);
+    QCOMPARE(mock.getCalls[0].endpoint.path(), QString("/animals"));
+    QCOMPARE(QUrlQuery(mock.getCalls[0].endpoint).queryItemValue("ids"), QString("1,2,3"));
+    QCOMPARE(mock.getCalls[0].options.priority, RequestPriority::Interactive);
+
+    mock.triggerSuccess(mock.getCalls, validAnimalArrayJson());
+
+    QCOMPARE(successSpy.count(), 2);
+    QCOMPARE(qvariant_cast<SharedAnimal>(successSpy.at(1).at(0))->name, QString("Whiskers"));
+    // Animal 3 was not in the answer.
+    QCOMPARE(failedSpy.count(), 1);
+    QCOMPARE(failedSpy.at(0).at(1).toLongLong(), 3);
+}
+
+void TestAnimalService::testGetAnimal_Batching_FallsBackToSingleGets() {
+    MockNetworkClient mock;
+    AnimalService service(mock);
+    service.setBatchingEnabled(true);
+
+    QSignalSpy successSpy(&service, &AnimalService::getAnimalSuccess);
+
+    for (qint64 id = 1; id <= 5; ++id) {
+        service.getAnimal(id);
+    }
+    QCoreApplication::processEvents();
+    QCOMPARE(mock.getCalls.size(), 1);
+
+    NetworkResponse notFound;
+    notFound.statusCode = 404;
+    mock.getCalls[0].onError(notFound);
+
+    // At most four single lookups are in flight; each answer lets the next one start.
+    QCOMPARE(mock.getCalls.size(), 5);
+    QCOMPARE(mock.getCalls[1].endpoint, QUrl("/animals/1"));
+    mock.triggerSuccess(mock.getCalls, validAnimalJson(1), 1);
+    QCOMPARE(mock.getCalls.size(), 6);
+    QCOMPARE(mock.getCalls[5].endpoint, QUrl("/animals/5"));
+    QCOMPARE(successSpy.count(), 1);
+
+    // The next turn goes straight to a single lookup.
+    service.getAnimal(6);
+    service.getAnimal(7);
+    QCoreApplication::processEvents();
+    for (int i = 2; i <= 5; ++i) {
+        mock.triggerSuccess(mock.getCalls, validAnimalJson(i), i);
+    }
+    QCOMPARE(mock.getCalls.last().endpoint, QUrl("/animals/7"));
+}
+
+void TestAnimalService::testGetAnimal_Batching_SupersededCallerIsDropped() {
+    MockNetworkClient mock;
+    AnimalService service(mock);
+    service.setBatchingEnabled(true);
+
+    RequestOptions options{RequestPriority::Interactive};
+    options.supersedeKey = "animal";
+    service.getAnimal(1, options);
+    service.getAnimal(2, options);
+    QCoreApplication::processEvents();
+
+    // Only the latest lookup for the key goes out, and it can still be cancelled on its own.
+    QCOMPARE(mock.getCalls.size(), 1);
+    QCOMPARE(mock.getCalls[0].endpoint, QUrl("/animals/2"));
+    QVERIFY(mock.getCalls[0].options.cancellationToken.isValid());
+}
+
+void TestAnimalService::testGetAnimal_Batching_CancelledSingleFreesItsSlot() {
+    MockNetworkClient mock;
+    AnimalService service(mock);
+    service.setBatchingEnabled(true);
+
+    QList<CancellationToken> tokens;
+    for (qint64 id = 1; id <= 5; ++id) {
+        RequestOptions options;
+        options.cancellationToken = CancellationToken::create();
+        tokens.append(options.cancellationToken);
+        service.getAnimal(id, options);
+    }
+    QCoreApplication::processEvents();
+    NetworkResponse notFound;
+    notFound.statusCode = 404;
+    mock.getCalls[0].onError(notFound);
+    QCOMPARE(mock.getCalls.size(), 5);
+
+    // A cancelled request never reports back; cancelling it must still let the waiting lookup start.
+    tokens[0].cancel();
+    QVERIFY(mock.getCalls[1].options.cancellationToken.isCancelled());
+    QCOMPARE(mock.getCalls.size(), 6);
+    QCOMPARE(mock.getCalls[5].endpoint, QUrl("/animals/5"));
+}
+
+void TestAnimalService::testGetAnimal_Batching_MalformedItemFailsOnce() {
+    MockNetworkClient mock;
+    AnimalService service(mock);
+    service.setBatchingEnabled(true);
+
+    QSignalSpy successSpy(&service, &AnimalService::getAnimalSuccess);
+    QSignalSpy failedSpy(&service, &AnimalService::getAnimalFailed);
+
+    service.getAnimal(1);
+    service.getAnimal(2);
+    QCoreApplication::processEvents();
+    QCOMPARE(mock.getCalls.size(), 1);
+
+    QJsonObject malformed = QJsonDocument::fromJson(validAnimalJson(1)).object();
+    malformed["age"] = "three";
+    QJsonArray answer;
+    answer.append(malformed);
+    answer.append(QJsonDocument::fromJson(validAnimalJson(2, "Whiskers")).object());
+    mock.triggerSuccess(mock.getCalls, QJsonDocument(answer).toJson(QJsonDocument::Compact));
+
+    QCOMPARE(successSpy.count(), 1);
+    QCOMPARE(qvariant_cast<SharedAnimal>(successSpy.at(0).at(0))->id, 2);
+    // The broken item is a parse failure for animal 1, not also a "not found".
+    QCOMPARE(failedSpy.count(), 1);
+    QCOMPARE(failedSpy.at(0).at(1).toLongLong(), 1);
+    auto error = qvariant_cast<QSharedPointer<BaseError>>(failedSpy.at(0).at(0));
+    QVERIFY(error.dynamicCast<ClientJsonParseError>());
+    QVERIFY(error->getMessage().contains("[0].age"));
+}
+
 // ---------------------------------------------------------------------------
 // createAnimal signal tests
 
@@ -640,7 +771,7 @@ void TestAnimalService::testCreateAnimal_Success_EmitsCreateAnimalSuccess() {
     QCOMPARE(successSpy.count(), 1);
     QCOMPARE(failedSpy.count(), 0);
 
-    auto animal = qvariant_cast<AnimalDTO>(successSpy.at(0).at(0));
+    auto animal = *qvariant_cast<SharedAnimal>(successSpy.at(0).at(0));
     QCOMPARE(animal.id, static_cast<qint64>(99));
     QCOMPARE(animal.name, QString("Buddy"));
 }
@@ -746,7 +877,7 @@ void TestAnimalService::testUpdateAnimal_Success_EmitsUpdateAnimalSuccess() {
     QCOMPARE(successSpy.count(), 1);
     QCOMPARE(failedSpy.count(), 0);
 
-    auto animal = qvariant_cast<AnimalDTO>(successSpy.at(0).at(0));
+    auto animal = *qvariant_cast<SharedAnimal>(successSpy.at(0).at(0));
     QCOMPARE(animal.id, static_cast<qint64>(1));
     QCOMPARE(animal.name, QString("Updated Buddy"));
 }
@@ -875,6 +1006,28 @@ void TestAnimalService::testGetAnimalFilters_ServerError_DoesNotEmitOtherSignals
     QCOMPARE(createFailed.count(), 0);
 }
 
+void TestAnimalService::testGetAnimalFilters_UsesBackgroundPriority() {
+    MockNetworkClient mock;
+    AnimalService service(mock);
+
+    service.getAnimalFilters();
+
+    QCOMPARE(mock.getCalls.size(), 1);
+    QCOMPARE(mock.getCalls[0].options.priority, RequestPriority::Background);
+}
+
+void TestAnimalService::testGetAnimal_UsesInteractivePriority() {
+    MockNetworkClient mock;
+    AnimalService service(mock);
+
+    service.getAnimal(7);
+    service.getAnimal(8, RequestOptions{RequestPriority::Prefetch});
+
+    QCOMPARE(mock.getCalls.size(), 2);
+    QCOMPARE(mock.getCalls[0].options.priority, RequestPriority::Interactive);
+    QCOMPARE(mock.getCalls[1].options.priority, RequestPriority::Prefetch);
+}
+
 // ---------------------------------------------------------------------------
 // getAnimalsByOrganization signal tests
 
@@ -893,7 +1046,7 @@ void TestAnimalService::testGetAnimalsByOrganization_Success_EmitsGetAnimalsByOr
     QCOMPARE(successSpy.count(), 1);
     QCOMPARE(failedSpy.count(), 0);
 
-    auto result = qvariant_cast<AnimalListDTO>(successSpy.at(0).at(0));
+    auto result = *qvariant_cast<SharedAnimalList>(successSpy.at(0).at(0));
     QCOMPARE(result.items.size(), 2);
     QCOMPARE(result.items[0].name, QString("Buddy"));
     QCOMPARE(result.items[1].name, QString("Whiskers"));
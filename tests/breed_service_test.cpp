@@ -1,7 +1,6 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
-#include <QNetworkReply>
 #include <QSharedPointer>
 #include <QtTest>
 
@@ -14,33 +13,6 @@
 using namespace pawspective::models;   // NOLINT google-build-using-namespace
 using namespace pawspective::services; // NOLINT google-build-using-namespace
 
-// ---------------------------------------------------------------------------
-// Fake QNetworkReply
-
-class FakeNetworkReply : public QNetworkReply {
-    Q_OBJECT
-public:
-    explicit FakeNetworkReply(const QByteArray& data, QObject* parent = nullptr)
-        : QNetworkReply(parent), m_data(data) {
-        open(QIODevice::ReadOnly);
-    }
-    void abort() override {}
-    qint64 bytesAvailable() const override { return m_data.size() - m_pos; }
-    bool isSequential() const override { return true; }
-
-protected:
-    qint64 readData(char* data, qint64 maxSize) override {
-        qint64 n = qMin(maxSize, static_cast<qint64>(m_data.size() - m_pos));
-        memcpy(data, m_data.constData() + m_pos, static_cast<size_t>(n));
-        m_pos += n;
-        return n;
-    }
-
-private:
-    QByteArray m_data;
-    qint64 m_pos = 0;
-};
-
 // ---------------------------------------------------------------------------
 // MockNetworkClient
 
@@ -56,21 +28,23 @@ public:
 
     QList<Call> getCalls;
 
-    void get(const QUrl& url, CallbackHandler ok, CallbackHandler err) override {
+    void get(const QUrl& url, CallbackHandler ok, CallbackHandler err, const RequestOptions&) override {
         getCalls.append({url, ok, err});
     }
-    void post(const QUrl&, const QByteArray&, CallbackHandler, CallbackHandler) override {}
-    void put(const QUrl&, const QByteArray&, CallbackHandler, CallbackHandler) override {}
-    void patch(const QUrl&, const QByteArray&, CallbackHandler, CallbackHandler) override {}
-    void deleteResource(const QUrl&, CallbackHandler, CallbackHandler) override {}
+    void post(const QUrl&, const QByteArray&, CallbackHandler, CallbackHandler, const RequestOptions&) override {}
+    void put(const QUrl&, const QByteArray&, CallbackHandler, CallbackHandler, const RequestOptions&) override {}
+    void patch(const QUrl&, const QByteArray&, CallbackHandler, CallbackHandler, const RequestOptions&) override {}
+    void deleteResource(const QUrl&, CallbackHandler, CallbackHandler, const RequestOptions&) override {}
 
     void triggerSuccess(const QByteArray& data, int idx = 0) {
-        FakeNetworkReply reply(data);
-        getCalls[idx].onSuccess(reply);
+        NetworkResponse response;
+        response.body = data;
+        getCalls[idx].onSuccess(response);
     }
     void triggerError(const QByteArray& data, int idx = 0) {
-        FakeNetworkReply reply(data);
-        getCalls[idx].onError(reply);
+        NetworkResponse response;
+        response.body = data;
+        getCalls[idx].onError(response);
     }
 };
 
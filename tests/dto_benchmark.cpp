@@ -0,0 +1,279 @@
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QtTest>
+
+#include "models/animal_dto.hpp"
+#include "models/animal_filter_dto.hpp"
+#include "models/organization_dto.hpp"
+#include "services/errors.hpp"
+
+using namespace pawspective; // NOLINT google-build-using-namespace
+
+// ---------------------------------------------------------------------------
+// Fixtures — shaped like real API responses: every third animal has no description, every tenth a long one, and
+// every other organization has a null description.
+
+namespace {
+
+QString longText(int index) {
+    return QString("Calm, house-trained and good on a lead; needs a quiet home without small children (%1). ")
+        .arg(index)
+        .repeated(20);
+}
+
+QJsonObject animalJson(int index) {
+    static const QStringList colors = {"black", "white", "brown", "grey", "spotted", "mixed"};
+    QJsonObject json{
+        {"id", index},
+        {"organization_id", 1 + index % 50},
+        {"name", QString("Animal %1").arg(index)},
+        {"breed", QJsonObject{{"id", 1 + index % 40}, {"animal_type", index % 2 ? "cat" : "dog"}, {"name", "Mixed"}}},
+        {"size", "medium"},
+        {"gender", index % 2 ? "female" : "male"},
+        {"care_level", "easy"},
+        {"color", colors.at(index % colors.size())},
+        {"good_with", "children"},
+        {"age", index % 15},
+        {"status", "available"}
+    };
+    if (index % 10 == 0) {
+        json.insert("description", longText(index));
+    } else if (index % 3 != 0) {
+        json.insert("description", QString("Friendly animal number %1.").arg(index));
+    } else {
+        json.insert("description", QJsonValue::Null);
+    }
+    return json;
+}
+
+QJsonObject organizationJson(int index) {
+    return {
+        {"id", index},
+        {"name", QString("Shelter %1").arg(index)},
+        {"description", index % 2 ? QJsonValue(longText(index)) : QJsonValue(QJsonValue::Null)},
+        {"city", QJsonObject{{"id", 1 + index % 20}, {"name", QString("City %1").arg(1 + index % 20)}}}
+    };
+}
+
+template <typename ItemFactory>
+QByteArray listJson(int count, ItemFactory item) {
+    QJsonArray items;
+    for (int i = 1; i <= count; ++i) {
+        items.append(item(i));
+    }
+    const QJsonObject page{
+        {"items", items},
+        {"page", 1},
+        {"limit", count},
+        {"total_count", count},
+        {"total_pages", 1}
+    };
+    return QJsonDocument(page).toJson(QJsonDocument::Compact);
+}
+
+models::AnimalFilterDTO filterWith(int count) {
+    models::AnimalFilterDTO filter;
+    filter.breeds = QVector<int64_t>();
+    filter.cities = QVector<int64_t>();
+    filter.colors = QVector<models::AnimalColor>();
+    for (int i = 0; i < count; ++i) {
+        filter.breeds->append(i + 1);
+        filter.cities->append(i + 1);
+        filter.colors->append(static_cast<models::AnimalColor>(i % 12));
+    }
+    filter.sizes = QVector<models::AnimalSize>{models::AnimalSize::Small, models::AnimalSize::Large};
+    filter.ageLte = 10;
+    filter.page = 1;
+    filter.limit = 20;
+    return filter;
+}
+
+QByteArray validationErrorJson(int count) {
+    QJsonArray details;
+    for (int i = 0; i < count; ++i) {
+        details.append(QJsonObject{{"field", QString("field_%1").arg(i)}, {"message", "must not be blank"}});
+    }
+    const QJsonObject error{
+        {"error", QJsonObject{{"code", "VALIDATION_ERROR"}, {"message", "Validation failed"}, {"details", details}}}
+    };
+    return QJsonDocument(error).toJson(QJsonDocument::Compact);
+}
+
+// QBENCHMARK reports the time per iteration; this adds time per item and throughput for the same runs.
+class ThroughputReport {
+public:
+    ThroughputReport(qsizetype items, qsizetype bytes) : m_items(items), m_bytes(bytes) { m_timer.start(); }
+
+    ThroughputReport(const ThroughputReport&) = delete;
+    ThroughputReport& operator=(const ThroughputReport&) = delete;
+
+    ~ThroughputReport() {
+        if (m_iterations == 0) {
+            return;
+        }
+        const double nsPerIteration = static_cast<double>(m_timer.nsecsElapsed()) / static_cast<double>(m_iterations);
+        const double usPerItem = nsPerIteration / 1000.0 / static_cast<double>(qMax<qsizetype>(1, m_items));
+        qInfo().noquote() << QString("%1 items, %2 bytes: %3 us/item, %4 MB/s")
+                                 .arg(m_items)
+                                 .arg(m_bytes)
+                                 .arg(usPerItem, 0, 'f', 3)
+                                 .arg(static_cast<double>(m_bytes) / nsPerIteration * 1000.0, 0, 'f', 1);
+    }
+
+    void iteration() { ++m_iterations; }
+
+private:
+    qsizetype m_items;
+    qsizetype m_bytes;
+    qint64 m_iterations = 0;
+    QElapsedTimer m_timer;
+};
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+
+class DtoBenchmark : public QObject {
+    Q_OBJECT
+
+private slots:
+    void animalListFromJson_data();
+    void animalListFromJson();
+    void organizationListFromJson_data();
+    void organizationListFromJson();
+    void animalListStreaming_data();
+    void animalListStreaming();
+    void organizationListStreaming_data();
+    void organizationListStreaming();
+    void animalFilterToJson_data();
+    void animalFilterToJson();
+    void errorFactoryCreateError_data();
+    void errorFactoryCreateError();
+
+private:
+    static void addSizes();
+};
+
+void DtoBenchmark::addSizes() {
+    QTest::addColumn<int>("items");
+    for (const int items : {10, 100, 1000, 10000}) {
+        QTest::newRow(QByteArray::number(items).constData()) << items;
+    }
+}
+
+void DtoBenchmark::animalListFromJson_data() { addSizes(); }
+
+// Bytes off the wire to DTOs, as the service does it.
+void DtoBenchmark::animalListFromJson() {
+    QFETCH(int, items);
+    const QByteArray body = listJson(items, animalJson);
+    QVERIFY(models::AnimalListDTO::fromJson(QJsonDocument::fromJson(body).object()).items.size() == items);
+
+    qsizetype decoded = 0;
+    ThroughputReport report(items, body.size());
+    QBENCHMARK {
+        report.iteration();
+        decoded += models::AnimalListDTO::fromJson(QJsonDocument::fromJson(body).object()).items.size();
+    }
+    QVERIFY(decoded > 0);
+}
+
+void DtoBenchmark::organizationListFromJson_data() { addSizes(); }
+
+void DtoBenchmark::organizationListFromJson() {
+    QFETCH(int, items);
+    const QByteArray body = listJson(items, organizationJson);
+    QVERIFY(models::OrganizationListDTO::fromJson(QJsonDocument::fromJson(body).object()).items.size() == items);
+
+    qsizetype decoded = 0;
+    ThroughputReport report(items, body.size());
+    QBENCHMARK {
+        report.iteration();
+        decoded += models::OrganizationListDTO::fromJson(QJsonDocument::fromJson(body).object()).items.size();
+    }
+    QVERIFY(decoded > 0);
+}
+
+void DtoBenchmark::animalListStreaming_data() { addSizes(); }
+
+// The same bytes through JsonReader, as the list endpoints decode them; no QJsonDocument is built.
+void DtoBenchmark::animalListStreaming() {
+    QFETCH(int, items);
+    const QByteArray body = listJson(items, animalJson);
+    utils::json::JsonReader check(body);
+    QCOMPARE(
+        models::AnimalListDTO::fromJson(check).toJson(),
+        models::AnimalListDTO::fromJson(QJsonDocument::fromJson(body).object()).toJson()
+    );
+
+    qsizetype decoded = 0;
+    ThroughputReport report(items, body.size());
+    QBENCHMARK {
+        report.iteration();
+        utils::json::JsonReader reader(body);
+        decoded += models::AnimalListDTO::fromJson(reader).items.size();
+    }
+    QVERIFY(decoded > 0);
+}
+
+void DtoBenchmark::organizationListStreaming_data() { addSizes(); }
+
+void DtoBenchmark::organizationListStreaming() {
+    QFETCH(int, items);
+    const QByteArray body = listJson(items, organizationJson);
+    utils::json::JsonReader check(body);
+    QCOMPARE(
+        models::OrganizationListDTO::fromJson(check).toJson(),
+        models::OrganizationListDTO::fromJson(QJsonDocument::fromJson(body).object()).toJson()
+    );
+
+    qsizetype decoded = 0;
+    ThroughputReport report(items, body.size());
+    QBENCHMARK {
+        report.iteration();
+        utils::json::JsonReader reader(body);
+        decoded += models::OrganizationListDTO::fromJson(reader).items.size();
+    }
+    QVERIFY(decoded > 0);
+}
+
+void DtoBenchmark::animalFilterToJson_data() { addSizes(); }
+
+// DTO to request bytes; items is the number of breed, city and color ids in the filter.
+void DtoBenchmark::animalFilterToJson() {
+    QFETCH(int, items);
+    const models::AnimalFilterDTO filter = filterWith(items);
+    const qsizetype size = QJsonDocument(filter.toJson()).toJson(QJsonDocument::Compact).size();
+
+    qsizetype encoded = 0;
+    ThroughputReport report(items, size);
+    QBENCHMARK {
+        report.iteration();
+        encoded += QJsonDocument(filter.toJson()).toJson(QJsonDocument::Compact).size();
+    }
+    QVERIFY(encoded > 0);
+}
+
+void DtoBenchmark::errorFactoryCreateError_data() { addSizes(); }
+
+// A validation error with items field errors.
+void DtoBenchmark::errorFactoryCreateError() {
+    QFETCH(int, items);
+    const QByteArray body = validationErrorJson(items);
+    const auto error = services::ErrorFactory::createError(body).dynamicCast<services::ValidationError>();
+    QVERIFY(error);
+    QCOMPARE(error->getErrors().size(), static_cast<std::size_t>(items));
+
+    qsizetype created = 0;
+    ThroughputReport report(items, body.size());
+    QBENCHMARK {
+        report.iteration();
+        created += services::ErrorFactory::createError(body) ? 1 : 0;
+    }
+    QVERIFY(created > 0);
+}
+
+QTEST_MAIN(DtoBenchmark)
+
+#include "dto_benchmark.moc"
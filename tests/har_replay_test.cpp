@@ -0,0 +1,185 @@
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include "services/har_recording.hpp"
+#include "services/har_replay_client.hpp"
+
+using namespace pawspective::services; // NOLINT google-build-using-namespace
+
+namespace {
+
+HarEntry entry(const QByteArray& method, const QString& url, int status, const QByteArray& body, double latencyMs) {
+    HarEntry result;
+    result.startedAt = QDateTime::currentDateTime();
+    result.method = method;
+    result.url = QUrl(url);
+    result.status = status;
+    result.responseHeaders = {{"Content-Type", "application/json"}};
+    result.responseBody = body;
+    result.waitMs = latencyMs;
+    return result;
+}
+
+}  // namespace
+
+class TestHarReplay : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRecordingRoundTripsThroughFile();
+    void testRecordingRedactsCredentialsInBodies();
+    void testFlushAppendsOnlyNewEntries();
+    void testReplayServesRecordedAnswersInOrder();
+    void testReplayReportsUnmatchedRequests();
+    void testReplayHonoursLatencyScaleAndCancellation();
+};
+
+void TestHarReplay::testRecordingRoundTripsThroughFile() {
+    QTemporaryDir dir;
+    HarRecording recording;
+    HarEntry first = entry("POST", "http://localhost:8080/animals", 201, "{\"id\":1}", 12.5);
+    first.requestHeaders = {{"Authorization", "Bearer secret"}, {"Content-Type", "application/json"}};
+    first.requestBody = "{\"name\":\"Rex\"}";
+    recording.append(first);
+    recording.append(entry("GET", "http://localhost:8080/animals/1/photo", 200, QByteArray("\x89PNG\0\xff", 6), 3));
+    QVERIFY(recording.save(dir.filePath("session.har")));
+
+    const auto loaded = HarRecording::load(dir.filePath("session.har"));
+    QVERIFY(loaded.has_value());
+    QCOMPARE(loaded->entries().size(), 2);
+    const HarEntry& post = loaded->entries().at(0);
+    QCOMPARE(post.method, QByteArray("POST"));
+    QCOMPARE(post.url, QUrl("http://localhost:8080/animals"));
+    QCOMPARE(post.requestBody, QByteArray("{\"name\":\"Rex\"}"));
+    QCOMPARE(post.requestHeaders.at(0).second, QByteArray("<redacted>"));
+    QCOMPARE(post.status, 201);
+    QCOMPARE(post.latencyMs(), 12.5);
+    QCOMPARE(loaded->entries().at(1).responseBody, QByteArray("\x89PNG\0\xff", 6));
+}
+
+void TestHarReplay::testRecordingRedactsCredentialsInBodies() {
+    QTemporaryDir dir;
+    HarRecording recording;
+    HarEntry login = entry(
+        "POST",
+        "http://localhost:8080/auth/login",
+        200,
+        "{\"access_token\":\"access-123\",\"refresh_token\":\"refresh-456\",\"token_type\":\"Bearer\"}",
+        0
+    );
+    login.requestBody = "{\"email\":\"a@b.c\",\"password\":\"hunter2\"}";
+    recording.append(login);
+    HarEntry refresh = entry("POST", "http://localhost:8080/auth/refresh", 200, "not json", 0);
+    refresh.requestBody = "{\"user\":{\"new_password\":\"pw-789\"}}";
+    recording.append(refresh);
+    QVERIFY(recording.save(dir.filePath("session.har")));
+
+    QFile file(dir.filePath("session.har"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray har = file.readAll();
+    for (const char* secret : {"hunter2", "access-123", "refresh-456", "pw-789", "not json"}) {
+        QVERIFY2(!har.contains(secret), secret);
+    }
+
+    const auto loaded = HarRecording::load(dir.filePath("session.har"));
+    QVERIFY(loaded.has_value());
+    const QJsonObject body = QJsonDocument::fromJson(loaded->entries().at(0).responseBody).object();
+    QCOMPARE(body["access_token"].toString(), QString("<redacted>"));
+    QCOMPARE(body["token_type"].toString(), QString("Bearer"));
+    QCOMPARE(QJsonDocument::fromJson(loaded->entries().at(0).requestBody)["email"].toString(), QString("a@b.c"));
+}
+
+void TestHarReplay::testFlushAppendsOnlyNewEntries() {
+    QTemporaryDir dir;
+    const QString path = dir.filePath("session.har");
+    HarRecording recording;
+    recording.append(entry("GET", "http://localhost:8080/animals/1", 200, "{\"id\":1}", 1));
+    recording.append(entry("GET", "http://localhost:8080/animals/2", 200, "{\"id\":2}", 1));
+    QVERIFY(recording.flush(path));
+    QCOMPARE(HarRecording::load(path)->entries().size(), 2);
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray firstFlush = file.readAll();
+    file.close();
+
+    recording.append(entry("GET", "http://localhost:8080/animals/3", 200, "{\"id\":3}", 1));
+    QVERIFY(recording.flush(path));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray secondFlush = file.readAll();
+    file.close();
+    // The earlier entries were left in place; only the closing part of the document was rewritten.
+    const qsizetype tailStart = firstFlush.lastIndexOf(']');
+    QVERIFY(secondFlush.startsWith(firstFlush.left(tailStart)));
+
+    const auto loaded = HarRecording::load(path);
+    QVERIFY(loaded.has_value());
+    QCOMPARE(loaded->entries().size(), 3);
+    QCOMPARE(loaded->entries().at(2).url, QUrl("http://localhost:8080/animals/3"));
+
+    // A file replaced in between is rewritten in full.
+    QVERIFY(recording.save(path));
+    recording.append(entry("GET", "http://localhost:8080/animals/4", 200, "{\"id\":4}", 1));
+    QVERIFY(recording.flush(path));
+    QCOMPARE(HarRecording::load(path)->entries().size(), 4);
+}
+
+void TestHarReplay::testReplayServesRecordedAnswersInOrder() {
+    HarRecording recording;
+    recording.append(entry("GET", "http://localhost:8080/animals?page=1", 200, "[1]", 0));
+    recording.append(entry("GET", "http://localhost:8080/animals?page=1", 503, "{}", 0));
+    HarReplayClient client(recording);
+    client.setLatencyScale(0);
+
+    QList<int> statuses;
+    const auto record = [&](const NetworkResponse& response) { statuses.append(response.statusCode); };
+    client.get(QUrl("/animals?page=1"), record, record);
+    client.get(QUrl("/animals?page=1"), record, record);
+    client.get(QUrl("/animals?page=1"), record, record);
+
+    QTRY_COMPARE(statuses.size(), 3);
+    QCOMPARE(statuses, QList<int>({200, 503, 503}));
+}
+
+void TestHarReplay::testReplayReportsUnmatchedRequests() {
+    HarReplayClient client(HarRecording{});
+    client.setLatencyScale(0);
+
+    bool failed = false;
+    client.deleteResource(QUrl("/animals/7"), {}, [&](const NetworkResponse& response) {
+        failed = response.error == QNetworkReply::ContentNotFoundError;
+    });
+
+    QTRY_VERIFY(failed);
+    QCOMPARE(client.unmatched(), QStringList({"DELETE http://localhost:8080/animals/7"}));
+}
+
+void TestHarReplay::testReplayHonoursLatencyScaleAndCancellation() {
+    HarRecording recording;
+    recording.append(entry("GET", "http://localhost:8080/breeds", 200, "[]", 200));
+    HarReplayClient client(recording);
+    client.setLatencyScale(0.25);
+    QSignalSpy replayed(&client, &HarReplayClient::requestReplayed);
+
+    RequestOptions cancelled;
+    cancelled.cancellationToken = CancellationToken::create();
+    bool cancelledCalled = false;
+    client.get(QUrl("/breeds"), [&](auto&) { cancelledCalled = true; }, {}, cancelled);
+    cancelled.cancellationToken.cancel();
+
+    bool succeeded = false;
+    client.get(QUrl("/breeds"), [&](auto&) { succeeded = true; }, {});
+
+    QTRY_VERIFY(succeeded);
+    QCOMPARE(replayed.count(), 1);
+    QCOMPARE(replayed.at(0).at(2).toInt(), 50);
+    QVERIFY(!cancelledCalled);
+}
+
+QTEST_MAIN(TestHarReplay)
+
+#include "har_replay_test.moc"
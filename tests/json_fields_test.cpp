@@ -0,0 +1,333 @@
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtTest>
+
+#include "models/animal_dto.hpp"
+#include "models/animal_update_dto.hpp"
+#include "models/organization_dto.hpp"
+#include "models/user_dto.hpp"
+#include "utils/json_reader.hpp"
+#include "utils/string_pool.hpp"
+
+using namespace pawspective::models;  // NOLINT google-build-using-namespace
+using pawspective::utils::json::JsonParseError;
+using pawspective::utils::StringPool;
+using pawspective::utils::json::JsonReader;
+
+namespace {
+
+QJsonObject animalJson() {
+    return QJsonObject{
+        {"id", 42},
+        {"organization_id", 7},
+        {"name", "Rex"},
+        {"breed", QJsonObject{{"id", 3}, {"animal_type", "dog"}, {"name", "Collie"}}},
+        {"size", "medium"},
+        {"gender", "male"},
+        {"care_level", "special_needs"},
+        {"color", "black"},
+        {"good_with", "children"},
+        {"age", 4},
+        {"description", QJsonValue::Null},
+        {"status", "available"},
+    };
+}
+
+QString decodeError(const QJsonObject& json) {
+    try {
+        AnimalDTO::fromJson(json);
+    } catch (const std::invalid_argument& e) {
+        return QString::fromUtf8(e.what());
+    }
+    return {};
+}
+
+}  // namespace
+
+class TestJsonFields : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testAnimalRoundTrip();
+    void testMissingRequiredFieldThrows();
+    void testWrongTypeThrows();
+    void testFractionalNumberIsNotAnId();
+    void testListWithoutItemsIsEmpty();
+    void testUnsetOptionalsAreOmitted();
+    void testUserOrganizationIsOptional();
+    void testStreamingMatchesDocumentDecode();
+    void testStreamingSkipsUnknownValues();
+    void testStreamingRejectsMalformedJson();
+    void testTryFromJsonReportsFieldPath();
+    void testInvalidItemsAreSkipped();
+    void testDecodedNamesShareOneBuffer();
+    void testStringPoolIsBounded();
+    void testFullStringPoolDoesNotTrimOnEveryMiss();
+    void testSharedHandleCopiesShareOneValue();
+};
+
+void TestJsonFields::testAnimalRoundTrip() {
+    const AnimalDTO dto = AnimalDTO::fromJson(animalJson());
+
+    QCOMPARE(dto.organizationId, qint64(7));
+    QCOMPARE(dto.name, QString("Rex"));
+    QCOMPARE(dto.breed.animalType, AnimalType::Dog);
+    QCOMPARE(dto.careLevel, CareLevel::SpecialNeeds);
+    QVERIFY(!dto.description.has_value());
+
+    const QJsonObject encoded = dto.toJson();
+    QVERIFY(!encoded.contains("description"));
+    QCOMPARE(encoded.value("care_level").toString(), QString("special_needs"));
+    QCOMPARE(AnimalDTO::fromJson(encoded).toJson(), encoded);
+}
+
+void TestJsonFields::testMissingRequiredFieldThrows() {
+    QJsonObject json = animalJson();
+    json.remove("age");
+    QCOMPARE(decodeError(json), QString("Invalid or missing age field"));
+
+    json = animalJson();
+    json.insert("name", QJsonValue::Null);
+    QCOMPARE(decodeError(json), QString("Invalid or missing name field"));
+}
+
+void TestJsonFields::testWrongTypeThrows() {
+    QJsonObject json = animalJson();
+    json.insert("id", "9");
+    QCOMPARE(decodeError(json), QString("Invalid or missing id field"));
+
+    json = animalJson();
+    json.insert("description", 5);
+    QCOMPARE(decodeError(json), QString("Invalid description field"));
+}
+
+void TestJsonFields::testFractionalNumberIsNotAnId() {
+    QJsonObject json = animalJson();
+    json.insert("id", 12.5);
+    QCOMPARE(decodeError(json), QString("Invalid or missing id field"));
+
+    json = animalJson();
+    json.insert("age", 1e12);
+    QCOMPARE(decodeError(json), QString("Invalid or missing age field"));
+
+    // The streaming decoder agrees: the item with a fractional id is dropped, the good one is kept.
+    const QByteArray body = R"({"page": 1, "limit": 5, "total_count": 2, "total_pages": 1, "items": [
+        {"id": 4.5, "name": "Half", "city": {"id": 2, "name": "Brno"}},
+        {"id": 5.0, "name": "Whole", "city": {"id": 2, "name": "Brno"}}]})";
+    JsonReader reader(body);
+    const auto list = OrganizationListDTO::tryFromJson(reader);
+    reader.finish();
+    QVERIFY(list.has_value());
+    QCOMPARE(list->items.size(), 1);
+    QCOMPARE(list->items[0].id, qint64(5));
+    QCOMPARE(list->rejectedItems[0].toString(), QString("items[0].id: Invalid or missing id field"));
+
+    json = animalJson();
+    json.insert("id", 12.0);
+    QCOMPARE(AnimalDTO::fromJson(json).id, qint64(12));
+}
+
+void TestJsonFields::testListWithoutItemsIsEmpty() {
+    const QJsonObject json{{"page", 1}, {"limit", 20}, {"total_count", 0}, {"total_pages", 0}};
+
+    const OrganizationListDTO list = OrganizationListDTO::fromJson(json);
+    QCOMPARE(list.limit, 20);
+    QVERIFY(list.items.isEmpty());
+    QCOMPARE(list.toJson().value("items").toArray().size(), 0);
+}
+
+void TestJsonFields::testUnsetOptionalsAreOmitted() {
+    AnimalUpdateDTO update;
+    update.size = AnimalSize::Large;
+    update.age = 2;
+
+    const QJsonObject json = update.toJson();
+    QCOMPARE(json, (QJsonObject{{"size", "large"}, {"age", 2}}));
+
+    const AnimalUpdateDTO decoded = AnimalUpdateDTO::fromJson(json);
+    QCOMPARE(decoded.size, std::optional(AnimalSize::Large));
+    QVERIFY(!decoded.name.has_value());
+}
+
+void TestJsonFields::testUserOrganizationIsOptional() {
+    const QJsonObject json{{"id", 1}, {"email", "a@b.c"}, {"first_name", "A"}, {"last_name", "B"}};
+
+    QVERIFY(!UserDTO::fromJson(json).organizationId.has_value());
+
+    QJsonObject withOrganization = json;
+    withOrganization.insert("organization_id", 12);
+    QCOMPARE(UserDTO::fromJson(withOrganization).organizationId, std::optional<qint64>(12));
+    QCOMPARE(UserDTO::fromJson(withOrganization).toJson(), withOrganization);
+}
+
+void TestJsonFields::testStreamingMatchesDocumentDecode() {
+    QJsonObject second = animalJson();
+    second.insert("id", 43);
+    second.insert("name", "Ren\u00e9 \"the\" \U0001F436");
+    second.insert("description", "line\nbreak");
+    const QJsonObject page{
+        {"page", 2},
+        {"limit", 20},
+        {"total_count", 41},
+        {"total_pages", 3},
+        {"items", QJsonArray{animalJson(), second}},
+    };
+    const QByteArray body = QJsonDocument(page).toJson();
+
+    JsonReader reader(body);
+    const AnimalListDTO streamed = AnimalListDTO::fromJson(reader);
+    reader.finish();
+
+    QCOMPARE(streamed.items.size(), 2);
+    QCOMPARE(streamed.items[1].name, QString("Ren\u00e9 \"the\" \U0001F436"));
+    QCOMPARE(streamed.toJson(), AnimalListDTO::fromJson(page).toJson());
+}
+
+void TestJsonFields::testStreamingSkipsUnknownValues() {
+    const QByteArray body = R"({"meta": {"a": [1, -2.5e3, true, null, {"b": "}"}]}, "page": 1, "limit": 5,
+        "total_count": 1, "total_pages": 1, "items": [{"id": 4, "name": "Shelter", "description": null,
+        "city": {"id": 2, "name": "Brno", "region": "x"}}]})";
+
+    JsonReader reader(body);
+    const OrganizationListDTO list = OrganizationListDTO::fromJson(reader);
+    reader.finish();
+
+    QCOMPARE(list.items.size(), 1);
+    QCOMPARE(list.items[0].city.name, QString("Brno"));
+    QVERIFY(!list.items[0].description.has_value());
+}
+
+void TestJsonFields::testStreamingRejectsMalformedJson() {
+    const auto decode = [](const QByteArray& body) {
+        JsonReader reader(body);
+        OrganizationListDTO::fromJson(reader);
+        reader.finish();
+    };
+
+    QVERIFY_THROWS_EXCEPTION(JsonParseError, decode("not valid json {{{}"));
+    QVERIFY_THROWS_EXCEPTION(JsonParseError, decode(R"({"page": 1 "limit": 2})"));
+    QVERIFY_THROWS_EXCEPTION(JsonParseError, decode(R"({"page": 1, "limit": 2, "items": [)"));
+    QVERIFY_THROWS_EXCEPTION(JsonParseError, decode(R"({"page":1,"limit":1,"total_count":0,"total_pages":0} x)"));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, decode(R"({"page": 1, "limit": 2})"));
+}
+
+void TestJsonFields::testTryFromJsonReportsFieldPath() {
+    QJsonObject json = animalJson();
+    json.insert("breed", QJsonObject{{"id", 3}, {"animal_type", "dragon"}});
+
+    const auto decoded = AnimalDTO::tryFromJson(json);
+    QVERIFY(!decoded.has_value());
+    QCOMPARE(decoded.error().path, QString("breed.animal_type"));
+    QCOMPARE(decoded.error().message, QString("Invalid AnimalType: dragon"));
+
+    QVERIFY(AnimalDTO::tryFromJson(animalJson()).has_value());
+}
+
+void TestJsonFields::testInvalidItemsAreSkipped() {
+    QJsonObject missingAge = animalJson();
+    missingAge.remove("age");
+    QJsonObject second = animalJson();
+    second.insert("id", 43);
+    const QJsonObject page{
+        {"page", 1},
+        {"limit", 20},
+        {"total_count", 4},
+        {"total_pages", 1},
+        {"items", QJsonArray{animalJson(), missingAge, "not an animal", second}},
+    };
+    const QByteArray body = QJsonDocument(page).toJson();
+
+    JsonReader reader(body);
+    const auto streamed = AnimalListDTO::tryFromJson(reader);
+    reader.finish();
+    const auto fromDocument = AnimalListDTO::tryFromJson(page);
+
+    for (const auto& list : {streamed, fromDocument}) {
+        QVERIFY(list.has_value());
+        QCOMPARE(list->items.size(), 2);
+        QCOMPARE(list->items[1].id, qint64(43));
+        QCOMPARE(list->rejectedItems.size(), 2);
+        QCOMPARE(list->rejectedItems[0].toString(), QString("items[1].age: Invalid or missing age field"));
+        QCOMPARE(list->rejectedItems[1].toString(), QString("items[2]: Invalid items field"));
+    }
+}
+
+void TestJsonFields::testDecodedNamesShareOneBuffer() {
+    const QByteArray body = QJsonDocument(QJsonArray{animalJson()}).toJson();
+    JsonReader reader(body);
+    reader.beginArray();
+    reader.nextElement();
+    const AnimalDTO streamed = AnimalDTO::fromJson(reader);
+
+    const AnimalDTO first = AnimalDTO::fromJson(animalJson());
+    const AnimalDTO second = AnimalDTO::fromJson(animalJson());
+
+    QCOMPARE(first.breed.name, QString("Collie"));
+    QCOMPARE(first.breed.name.constData(), second.breed.name.constData());
+    QCOMPARE(streamed.breed.name.constData(), first.breed.name.constData());
+}
+
+void TestJsonFields::testStringPoolIsBounded() {
+    StringPool pool(2, 8);
+
+    const QString longName("Much longer than eight");
+    QCOMPARE(pool.intern(longName).constData(), longName.constData());
+    QCOMPARE(pool.size(), 0);
+
+    QString brno = pool.intern(QStringView(u"Brno"));
+    const QString praha = pool.intern(QString("Praha"));
+    QCOMPARE(pool.intern(QString("Brno")).constData(), brno.constData());
+
+    // Full, and both entries are still referenced: the value comes back as is.
+    const QString ostrava("Ostrava");
+    QCOMPARE(pool.intern(ostrava).constData(), ostrava.constData());
+    QCOMPARE(pool.size(), 2);
+
+    brno.clear();
+    QCOMPARE(pool.trim(), 1);
+    QCOMPARE(pool.size(), 1);
+    QCOMPARE(pool.intern(QString("Praha")).constData(), praha.constData());
+}
+
+void TestJsonFields::testFullStringPoolDoesNotTrimOnEveryMiss() {
+    StringPool pool(8, 16);
+    QStringList held;
+    for (int i = 0; i < 8; ++i) {
+        held.append(pool.intern(QString("name %1").arg(i)));
+    }
+
+    // The first miss on a full pool trims, but every entry is still in use.
+    const QString first("miss 1");
+    QCOMPARE(pool.intern(first).constData(), first.constData());
+
+    // An entry becomes unused; the next two misses (a quarter of eight) still skip the scan.
+    held.removeFirst();
+    for (const QString& miss : {QString("miss 2"), QString("miss 3")}) {
+        QCOMPARE(pool.intern(miss).constData(), miss.constData());
+        QCOMPARE(pool.size(), 8);
+    }
+
+    // The third one scans, drops the unused entry and takes its place.
+    const QString interned = pool.intern(QString("miss 4"));
+    QCOMPARE(pool.intern(QString("miss 4")).constData(), interned.constData());
+    QCOMPARE(pool.size(), 8);
+}
+
+void TestJsonFields::testSharedHandleCopiesShareOneValue() {
+    const SharedAnimal empty;
+    QVERIFY(empty.isNull());
+    QCOMPARE(empty->id, AnimalDTO{}.id);
+
+    const SharedAnimal animal(AnimalDTO::fromJson(animalJson()));
+    const SharedAnimal copy = animal;
+    const SharedAnimal viaVariant = QVariant::fromValue(animal).value<SharedAnimal>();
+
+    QCOMPARE(&*copy, &*animal);
+    QCOMPARE(&*viaVariant, &*animal);
+    QCOMPARE(copy->breed.name, QString("Collie"));
+}
+
+QTEST_MAIN(TestJsonFields)
+
+#include "json_fields_test.moc"
@@ -0,0 +1,96 @@
+#include <QSignalSpy>
+#include <QTcpSocket>
+#include <QtTest>
+
+#include "services/metrics_registry.hpp"
+#include "services/metrics_server.hpp"
+
+using namespace pawspective::services; // NOLINT google-build-using-namespace
+
+class TestMetrics : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testHistogramPercentilesStayWithinBucketError();
+    void testDisabledRegistryRecordsNothing();
+    void testPrometheusOutputHasCumulativeBuckets();
+    void testServerAnswersMetricsOnly();
+};
+
+void TestMetrics::testHistogramPercentilesStayWithinBucketError() {
+    HdrHistogram histogram;
+    for (qint64 value = 1; value <= 100000; ++value) {
+        histogram.record(value);
+    }
+
+    QCOMPARE(histogram.count(), quint64(100000));
+    QCOMPARE(histogram.max(), qint64(100000));
+    for (const double fraction : {0.5, 0.9, 0.99}) {
+        const auto exact = static_cast<double>(fraction * 100000);
+        const auto reported = static_cast<double>(histogram.percentile(fraction));
+        QVERIFY2(reported >= exact && reported <= exact * 1.125, qPrintable(QString::number(reported)));
+    }
+    QCOMPARE(histogram.countAtOrBelow(15), quint64(15));
+    QCOMPARE(histogram.countAtOrBelow(qint64(1) << 20), quint64(100000));
+}
+
+void TestMetrics::testDisabledRegistryRecordsNothing() {
+    MetricsRegistry registry;
+    registry.increment("requests_total");
+    registry.observeMs("duration_seconds", {}, 12);
+    QCOMPARE(registry.counter("requests_total"), 0.0);
+    QCOMPARE(registry.histogram("duration_seconds").count(), quint64(0));
+
+    registry.setEnabled(true);
+    registry.increment("requests_total", {{"status", "200"}});
+    registry.increment("requests_total", {{"status", "200"}});
+    QCOMPARE(registry.counter("requests_total", {{"status", "200"}}), 2.0);
+}
+
+void TestMetrics::testPrometheusOutputHasCumulativeBuckets() {
+    MetricsRegistry registry;
+    registry.setEnabled(true);
+    registry.describe("paws_duration_seconds", "How long it took.");
+    registry.observeMs("paws_duration_seconds", {{"endpoint", "/animals"}}, 3);
+    registry.observeMs("paws_duration_seconds", {{"endpoint", "/animals"}}, 300);
+
+    const QByteArray text = registry.toPrometheus();
+    QVERIFY(text.contains("# HELP paws_duration_seconds How long it took.\n"));
+    QVERIFY(text.contains("# TYPE paws_duration_seconds histogram\n"));
+    QVERIFY(text.contains("paws_duration_seconds_bucket{endpoint=\"/animals\",le=\"0.005\"} 1\n"));
+    QVERIFY(text.contains("paws_duration_seconds_bucket{endpoint=\"/animals\",le=\"+Inf\"} 2\n"));
+    QVERIFY(text.contains("paws_duration_seconds_count{endpoint=\"/animals\"} 2\n"));
+}
+
+void TestMetrics::testServerAnswersMetricsOnly() {
+    MetricsRegistry registry;
+    registry.setEnabled(true);
+    registry.increment("paws_requests_total");
+    MetricsServer server(registry);
+    QVERIFY(server.listen(0));
+
+    const auto fetch = [&](const QByteArray& path) {
+        QTcpSocket socket;
+        socket.connectToHost(QHostAddress::LocalHost, server.port());
+        if (!socket.waitForConnected(1000)) {
+            return QByteArray();
+        }
+        socket.write("GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n");
+        QByteArray response;
+        QSignalSpy disconnected(&socket, &QTcpSocket::disconnected);
+        while (disconnected.isEmpty() && disconnected.wait(1000)) {
+        }
+        response += socket.readAll();
+        return response;
+    };
+
+    const QByteArray metrics = fetch("/metrics");
+    QVERIFY(metrics.startsWith("HTTP/1.1 200 OK\r\n"));
+    QVERIFY(metrics.contains("text/plain; version=0.0.4"));
+    QVERIFY(metrics.contains("paws_requests_total 1\n"));
+    QVERIFY(fetch("/").startsWith("HTTP/1.1 404"));
+}
+
+QTEST_MAIN(TestMetrics)
+
+#include "metrics_test.moc"
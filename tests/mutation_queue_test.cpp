@@ -0,0 +1,283 @@
+#include <QDir>
+#include <QFile>
+#include <QScopeGuard>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include "services/i_network_client.hpp"
+#include "services/mutation_queue.hpp"
+
+using namespace pawspective::services; // NOLINT google-build-using-namespace
+
+// ---------------------------------------------------------------------------
+// MockNetworkClient — captures mutations; lets tests answer them manually
+
+class MockNetworkClient : public INetworkClient {
+public:
+    using CallbackHandler = INetworkClient::CallbackHandler;
+
+    struct Call {
+        QByteArray method;
+        QUrl endpoint;
+        QByteArray body;
+        CallbackHandler onSuccess;
+        CallbackHandler onError;
+        RequestOptions options;
+    };
+
+    QList<Call> calls;
+
+    void get(const QUrl&, CallbackHandler, CallbackHandler, const RequestOptions&) override {}
+    void post(
+        const QUrl& url,
+        const QByteArray& data,
+        CallbackHandler ok,
+        CallbackHandler err,
+        const RequestOptions& options
+    ) override {
+        calls.append({"POST", url, data, ok, err, options});
+    }
+    void put(
+        const QUrl& url,
+        const QByteArray& data,
+        CallbackHandler ok,
+        CallbackHandler err,
+        const RequestOptions& options
+    ) override {
+        calls.append({"PUT", url, data, ok, err, options});
+    }
+    void patch(
+        const QUrl& url,
+        const QByteArray& data,
+        CallbackHandler ok,
+        CallbackHandler err,
+        const RequestOptions& options
+    ) override {
+        calls.append({"PATCH", url, data, ok, err, options});
+    }
+    void deleteResource(const QUrl&, CallbackHandler, CallbackHandler, const RequestOptions&) override {}
+
+    void respond(int idx, int statusCode) {
+        NetworkResponse response;
+        response.statusCode = statusCode;
+        if (statusCode >= 200 && statusCode < 300) {
+            calls[idx].onSuccess(response);
+        } else {
+            calls[idx].onError(response);
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+
+class TestMutationQueue : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void testMutationsAreSentInOrderWithIdempotencyKey();
+    void testTransientFailureReportsQueuedAndKeepsEntry();
+    void testRejectedMutationIsDroppedAndNextIsSent();
+    void testPendingMutationsSurviveRestart();
+    void testSwitchingUserAbandonsSendAndKeepsLogsApart();
+    void testSwitchingStorageFileAbandonsSend();
+};
+
+void TestMutationQueue::initTestCase() { QStandardPaths::setTestModeEnabled(true); }
+
+void TestMutationQueue::testMutationsAreSentInOrderWithIdempotencyKey() {
+    QTemporaryDir dir;
+    MockNetworkClient mock;
+    MutationQueue queue(mock);
+    queue.setStorageFile(dir.filePath("mutations.log"));
+
+    int succeeded = 0;
+    const QString firstKey =
+        queue.enqueue("createAnimal", "POST", QUrl("/animals"), "{}", [&](auto&) { ++succeeded; }, {}, {});
+    queue.enqueue("updateAnimal", "PUT", QUrl("/animals/1"), "{}", [&](auto&) { ++succeeded; }, {}, {});
+
+    // Only the head is in flight.
+    QCOMPARE(mock.calls.size(), 1);
+    QCOMPARE(mock.calls[0].method, QByteArray("POST"));
+    QCOMPARE(mock.calls[0].options.idempotencyKey, firstKey.toLatin1());
+
+    mock.respond(0, 201);
+    QCOMPARE(mock.calls.size(), 2);
+    QCOMPARE(mock.calls[1].method, QByteArray("PUT"));
+    QVERIFY(mock.calls[1].options.idempotencyKey != mock.calls[0].options.idempotencyKey);
+
+    mock.respond(1, 200);
+    QCOMPARE(succeeded, 2);
+    QCOMPARE(queue.pendingCount(), 0);
+}
+
+void TestMutationQueue::testTransientFailureReportsQueuedAndKeepsEntry() {
+    QTemporaryDir dir;
+    MockNetworkClient mock;
+    MutationQueue queue(mock);
+    queue.setStorageFile(dir.filePath("mutations.log"));
+    QSignalSpy completedSpy(&queue, &MutationQueue::mutationCompleted);
+
+    int queued = 0;
+    int succeeded = 0;
+    queue.enqueue(
+        "createAnimal",
+        "POST",
+        QUrl("/animals"),
+        "{}",
+        [&](auto&) { ++succeeded; },
+        {},
+        [&]() { ++queued; }
+    );
+    mock.respond(0, 0);
+
+    QCOMPARE(queued, 1);
+    QCOMPARE(queue.pendingCount(), 1);
+
+    // The replay reuses the key, and the caller that moved on hears about it through the signal.
+    queue.resume();
+    QCOMPARE(mock.calls.size(), 2);
+    QCOMPARE(mock.calls[1].options.idempotencyKey, mock.calls[0].options.idempotencyKey);
+    mock.respond(1, 201);
+
+    QCOMPARE(succeeded, 0);
+    QCOMPARE(completedSpy.count(), 1);
+    QCOMPARE(queue.pendingCount(), 0);
+}
+
+void TestMutationQueue::testRejectedMutationIsDroppedAndNextIsSent() {
+    QTemporaryDir dir;
+    MockNetworkClient mock;
+    MutationQueue queue(mock);
+    queue.setStorageFile(dir.filePath("mutations.log"));
+
+    int failed = 0;
+    queue.enqueue("updateAnimal", "PUT", QUrl("/animals/1"), "{}", {}, [&](auto&) { ++failed; }, {});
+    queue.enqueue("updateAnimal", "PUT", QUrl("/animals/2"), "{}", {}, {}, {});
+    mock.respond(0, 422);
+
+    QCOMPARE(failed, 1);
+    QCOMPARE(queue.pendingCount(), 1);
+    QCOMPARE(mock.calls.size(), 2);
+    QCOMPARE(mock.calls[1].endpoint, QUrl("/animals/2"));
+}
+
+void TestMutationQueue::testPendingMutationsSurviveRestart() {
+    QTemporaryDir dir;
+    const QString path = dir.filePath("mutations.log");
+    QString key;
+    {
+        MockNetworkClient mock;
+        MutationQueue queue(mock);
+        queue.setStorageFile(path);
+        queue.enqueue("createAnimal", "POST", QUrl("/animals"), "{\"a\":1}", {}, {}, {});
+        key = queue.enqueue(
+            "updateOrganization",
+            "PUT",
+            QUrl("/orgs/7"),
+            "{\"b\":2}",
+            {},
+            {},
+            {},
+            RequestPriority::Background
+        );
+        mock.respond(0, 201);
+    }
+
+    MockNetworkClient mock;
+    MutationQueue queue(mock);
+    queue.setStorageFile(path);
+
+    QCOMPARE(queue.pendingCount(), 1);
+    QCOMPARE(mock.calls.size(), 0);
+
+    queue.resume();
+    QCOMPARE(mock.calls.size(), 1);
+    QCOMPARE(mock.calls[0].method, QByteArray("PUT"));
+    QCOMPARE(mock.calls[0].endpoint, QUrl("/orgs/7"));
+    QCOMPARE(mock.calls[0].body, QByteArray("{\"b\":2}"));
+    QCOMPARE(mock.calls[0].options.idempotencyKey, key.toLatin1());
+    QCOMPARE(mock.calls[0].options.priority, RequestPriority::Background);
+}
+
+void TestMutationQueue::testSwitchingUserAbandonsSendAndKeepsLogsApart() {
+    const QString path =
+        QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).filePath("mutations-1.log");
+    QFile::remove(path);
+    auto cleanup = qScopeGuard([&path]() { QFile::remove(path); });
+
+    MockNetworkClient mock;
+    MutationQueue queue(mock);
+    queue.setUserId(1);
+
+    int queued = 0;
+    int succeeded = 0;
+    const QString key = queue.enqueue(
+        "updateAnimal",
+        "PUT",
+        QUrl("/animals/1"),
+        "{}",
+        [&](auto&) { ++succeeded; },
+        {},
+        [&]() { ++queued; }
+    );
+    QCOMPARE(mock.calls.size(), 1);
+
+    // The session ends before the send is answered: the caller is told it is queued, and the queue is not wedged.
+    queue.setUserId(std::nullopt);
+    QCOMPARE(queued, 1);
+    QCOMPARE(queue.pendingCount(), 0);
+
+    queue.setUserId(2);
+    queue.resume();
+    QCOMPARE(queue.pendingCount(), 0);
+    QCOMPARE(mock.calls.size(), 1);
+
+    // The late answer for the abandoned send changes nothing.
+    mock.respond(0, 200);
+    QCOMPARE(succeeded, 0);
+
+    // Back as the first user, the mutation is replayed with its original key.
+    queue.setUserId(1);
+    QCOMPARE(queue.pendingCount(), 1);
+    queue.resume();
+    QCOMPARE(mock.calls.size(), 2);
+    QCOMPARE(mock.calls[1].options.idempotencyKey, key.toLatin1());
+}
+
+void TestMutationQueue::testSwitchingStorageFileAbandonsSend() {
+    QTemporaryDir dir;
+    {
+        MockNetworkClient mock;
+        MutationQueue queue(mock);
+        queue.setStorageFile(dir.filePath("second.log"));
+        queue.enqueue("updateOrganization", "PUT", QUrl("/orgs/7"), "{}", {}, {}, {});
+    }
+
+    MockNetworkClient mock;
+    MutationQueue queue(mock);
+    queue.setStorageFile(dir.filePath("first.log"));
+    int succeeded = 0;
+    queue.enqueue("updateAnimal", "PUT", QUrl("/animals/1"), "{}", [&](auto&) { ++succeeded; }, {}, {});
+    QCOMPARE(mock.calls.size(), 1);
+
+    queue.setStorageFile(dir.filePath("second.log"));
+    QCOMPARE(queue.pendingCount(), 1);
+
+    // The late answer belongs to the first log and must not complete the entry loaded from the second.
+    mock.respond(0, 200);
+    QCOMPARE(succeeded, 0);
+    QCOMPARE(queue.pendingCount(), 1);
+
+    // The abandoned send no longer holds the queue.
+    queue.resume();
+    QCOMPARE(mock.calls.size(), 2);
+    QCOMPARE(mock.calls[1].endpoint, QUrl("/orgs/7"));
+}
+
+QTEST_MAIN(TestMutationQueue)
+
+#include "mutation_queue_test.moc"
@@ -1,15 +1,100 @@
 #include "services/network_client.hpp"
+#include "services/latency_tracker.hpp"
+#include "services/request_scheduler.hpp"
+#include "services/request_timing.hpp"
+#include "services/retry_limiter.hpp"
 #include <QtTest/qsignalspy.h>
 #include <QtTest/qtest.h>
+#include <QJsonArray>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <functional>
+#include <memory>
 
 using namespace pawspective::services;  //  NOLINT google-build-using-namespace
 
+namespace {
+
+// Minimal HTTP/1.1 responder on localhost. Every request is recorded with its body; the handler picks the response.
+class TestServer : public QObject {
+public:
+    using Handler = std::function<QByteArray(const QByteArray& request)>;
+
+    explicit TestServer(Handler handler) : m_handler(std::move(handler)) {
+        connect(&m_server, &QTcpServer::newConnection, this, [this]() {
+            while (QTcpSocket* socket = m_server.nextPendingConnection()) {
+                serve(socket);
+            }
+        });
+    }
+
+    bool listen() { return m_server.listen(QHostAddress::LocalHost); }
+    QUrl url() const { return QUrl(QString("http://127.0.0.1:%1/").arg(m_server.serverPort())); }
+    const QList<QByteArray>& requests() const { return m_requests; }
+
+    // headers: zero or more "Name: value\r\n" lines.
+    static QByteArray reply(const QByteArray& status, const QByteArray& headers, const QByteArray& body) {
+        return "HTTP/1.1 " + status + "\r\n" + headers + "Content-Length: " + QByteArray::number(body.size()) +
+               "\r\n\r\n" + body;
+    }
+
+private:
+    void serve(QTcpSocket* socket) {
+        auto buffer = QSharedPointer<QByteArray>::create();
+        connect(socket, &QTcpSocket::readyRead, socket, [this, socket, buffer]() {
+            buffer->append(socket->readAll());
+            while (true) {
+                const qsizetype headerEnd = buffer->indexOf("\r\n\r\n");
+                if (headerEnd < 0) {
+                    return;
+                }
+                qsizetype length = 0;
+                for (const QByteArray& line : buffer->left(headerEnd).split('\n')) {
+                    if (line.toLower().startsWith("content-length:")) {
+                        length = line.mid(15).trimmed().toLongLong();
+                    }
+                }
+                if (buffer->size() < headerEnd + 4 + length) {
+                    return;
+                }
+                const QByteArray request = buffer->left(headerEnd + 4 + length);
+                buffer->remove(0, headerEnd + 4 + length);
+                m_requests.append(request);
+                socket->write(m_handler(request));
+            }
+        });
+    }
+
+    QTcpServer m_server;
+    Handler m_handler;
+    QList<QByteArray> m_requests;
+};
+
+QByteArray okReply(const QByteArray&) { return TestServer::reply("200 OK", {}, "{}"); }
+
+QByteArray tokenExpiredReply() {
+    return TestServer::reply("401 Unauthorized", {}, R"({"error":{"code":"ACCESS_TOKEN_EXPIRED"}})");
+}
+
+// A localhost port nothing listens on: connecting fails at once, without DNS or a real network.
+QUrl closedPortUrl() {
+    QTcpServer probe;
+    probe.listen(QHostAddress::LocalHost);
+    const quint16 port = probe.serverPort();
+    probe.close();
+    return QUrl(QString("http://127.0.0.1:%1/").arg(port));
+}
+
+}  // namespace
+
 class TestNetworkClient : public QObject {
     Q_OBJECT
 
     NetworkClient* m_client = nullptr;
+    std::unique_ptr<QTemporaryDir> m_cacheDir;
 
 private slots:
     void init();
@@ -27,98 +112,142 @@ private slots:
 
     void testUnauthorizedAccessSignal();
     void testPendingRequestsRetry();
+    void testDuplicateGetsShareReply();
+    void testSchedulerPrefersInteractive();
+    void testSupersededRequestIsDropped();
+    void testRetryBackoffIsCappedAndJittered();
+    void testRetryLimiterThrottlesEndpoint();
+    void testPrewarmOpensConnection();
+    void testLargeBodyIsDeflatedWhenServerAccepts();
+    void testTimeoutFollowsLatencyPercentile();
+    void testHeldQueueIsBoundedAndDeduplicated();
+    void testTimelineKeepsMostRecentTimings();
+    void testCacheRevalidatesAndIsClearedForNewUser();
+    void testCachedResponseIsNotALatencySample();
 };
 
 void TestNetworkClient::init() {
-    m_client = new NetworkClient();
+    // Each test gets an empty cache of its own instead of the user's CacheLocation.
+    m_cacheDir = std::make_unique<QTemporaryDir>();
+    QVERIFY(m_cacheDir->isValid());
+    m_client = new NetworkClient(nullptr, m_cacheDir->path());
     QVERIFY(m_client != nullptr);
 }
 
 void TestNetworkClient::cleanup() {
     delete m_client;
     m_client = nullptr;
+    m_cacheDir.reset();
 }
 
 void TestNetworkClient::testGetRequest() {
     QVERIFY(m_client != nullptr);
 
-    bool callbackExecuted = false;
-    auto onSuccess = [&callbackExecuted](const QNetworkReply&) { callbackExecuted = true; };
-    auto onError = [](const QNetworkReply&) {};
+    TestServer server([](const QByteArray&) { return TestServer::reply("200 OK", {}, R"({"id":1})"); });
+    QVERIFY(server.listen());
 
-    QUrl endpoint("http://example.com/api/test");
-    m_client->get(endpoint, onSuccess, onError);
+    QList<NetworkResponse> responses;
+    auto onSuccess = [&responses](const NetworkResponse& response) { responses << response; };
+    auto onError = [](const NetworkResponse& response) { QFAIL(qPrintable(response.errorString)); };
 
-    QTest::qWait(100);
+    m_client->get(server.url().resolved(QUrl("/api/test")), onSuccess, onError);
+
+    QTRY_COMPARE_WITH_TIMEOUT(responses.size(), 1, 2000);
+    QCOMPARE(responses.first().statusCode, 200);
+    QCOMPARE(responses.first().body, QByteArray(R"({"id":1})"));
+    QVERIFY(server.requests().first().startsWith("GET /api/test "));
 }
 
 void TestNetworkClient::testPostRequest() {
     QVERIFY(m_client != nullptr);
 
-    bool callbackExecuted = false;
-    auto onSuccess = [&callbackExecuted](const QNetworkReply&) { callbackExecuted = true; };
-    auto onError = [](const QNetworkReply&) {};
+    TestServer server([](const QByteArray&) { return TestServer::reply("201 Created", {}, R"({"id":7})"); });
+    QVERIFY(server.listen());
+
+    QList<int> statusCodes;
+    auto onSuccess = [&statusCodes](const NetworkResponse& response) { statusCodes << response.statusCode; };
+    auto onError = [](const NetworkResponse& response) { QFAIL(qPrintable(response.errorString)); };
 
-    QUrl endpoint("http://example.com/api/users");
+    QUrl endpoint = server.url().resolved(QUrl("/api/users"));
     QByteArray data = R"({"name": "test", "email": "test@example.com"})";
 
     m_client->post(endpoint, data, onSuccess, onError);
 
-    QTest::qWait(100);
+    QTRY_COMPARE_WITH_TIMEOUT(statusCodes, QList<int>({201}), 2000);
+    QVERIFY(server.requests().first().startsWith("POST /api/users "));
+    QVERIFY(server.requests().first().endsWith(data));
 }
 
 void TestNetworkClient::testPutRequest() {
     QVERIFY(m_client != nullptr);
 
-    auto onSuccess = [](const QNetworkReply&) {};
-    auto onError = [](const QNetworkReply&) {};
+    TestServer server(okReply);
+    QVERIFY(server.listen());
 
-    QUrl endpoint("http://example.com/api/users/1");
+    int successCount = 0;
+    auto onSuccess = [&successCount](const NetworkResponse&) { successCount++; };
+    auto onError = [](const NetworkResponse& response) { QFAIL(qPrintable(response.errorString)); };
+
+    QUrl endpoint = server.url().resolved(QUrl("/api/users/1"));
     QByteArray data = R"({"name": "updated"})";
 
     m_client->put(endpoint, data, onSuccess, onError);
 
-    QTest::qWait(100);
+    QTRY_COMPARE_WITH_TIMEOUT(successCount, 1, 2000);
+    QVERIFY(server.requests().first().startsWith("PUT /api/users/1 "));
+    QVERIFY(server.requests().first().endsWith(data));
 }
 
 void TestNetworkClient::testPatchRequest() {
     QVERIFY(m_client != nullptr);
 
-    auto onSuccess = [](const QNetworkReply&) {};
-    auto onError = [](const QNetworkReply&) { QFAIL("Error callback should not be called for patch request"); };
+    TestServer server(okReply);
+    QVERIFY(server.listen());
 
-    QUrl endpoint("http://example.com/api/users/1");
+    int successCount = 0;
+    auto onSuccess = [&successCount](const NetworkResponse&) { successCount++; };
+    auto onError = [](const NetworkResponse&) { QFAIL("Error callback should not be called for patch request"); };
+
+    QUrl endpoint = server.url().resolved(QUrl("/api/users/1"));
     QByteArray data = R"({"status": "active"})";
 
     m_client->patch(endpoint, data, onSuccess, onError);
 
-    QTest::qWait(100);
+    QTRY_COMPARE_WITH_TIMEOUT(successCount, 1, 2000);
+    QVERIFY(server.requests().first().startsWith("PATCH /api/users/1 "));
 }
 
 void TestNetworkClient::testDeleteRequest() {
     QVERIFY(m_client != nullptr);
 
-    auto onSuccess = [](const QNetworkReply&) {};
-    auto onError = [](const QNetworkReply&) {};
+    TestServer server([](const QByteArray&) { return TestServer::reply("204 No Content", {}, {}); });
+    QVERIFY(server.listen());
 
-    QUrl endpoint("http://example.com/api/users/1");
+    QList<int> statusCodes;
+    auto onSuccess = [&statusCodes](const NetworkResponse& response) { statusCodes << response.statusCode; };
+    auto onError = [](const NetworkResponse& response) { QFAIL(qPrintable(response.errorString)); };
 
-    m_client->deleteResource(endpoint, onSuccess, onError);
+    m_client->deleteResource(server.url().resolved(QUrl("/api/users/1")), onSuccess, onError);
 
-    QTest::qWait(100);
+    QTRY_COMPARE_WITH_TIMEOUT(statusCodes, QList<int>({204}), 2000);
+    QVERIFY(server.requests().first().startsWith("DELETE /api/users/1 "));
 }
 
 void TestNetworkClient::testNetworkError() {
     QVERIFY(m_client != nullptr);
 
-    bool errorCallbackExecuted = false;
-    auto onSuccess = [](const QNetworkReply&) { QFAIL("Success callback should not be called on error"); };
-    auto onError = [&errorCallbackExecuted](const QNetworkReply&) { errorCallbackExecuted = true; };
+    QList<NetworkResponse> errors;
+    auto onSuccess = [](const NetworkResponse&) { QFAIL("Success callback should not be called on error"); };
+    auto onError = [&errors](const NetworkResponse& response) { errors << response; };
 
-    QUrl invalidEndpoint("http://invalid.endpoint.local.test/api/test");
-    m_client->get(invalidEndpoint, onSuccess, onError);
+    RequestOptions options;
+    options.retry.maxAttempts = 1;
+    m_client->get(closedPortUrl().resolved(QUrl("/api/test")), onSuccess, onError, options);
 
-    QTest::qWait(200);
+    QTRY_COMPARE_WITH_TIMEOUT(errors.size(), 1, 2000);
+    QCOMPARE(errors.first().statusCode, 0);
+    QCOMPARE(errors.first().error, QNetworkReply::ConnectionRefusedError);
+    QVERIFY(errors.first().body.startsWith("Network error: "));
 }
 
 void TestNetworkClient::testSuccessCallback() {
@@ -127,68 +256,351 @@ void TestNetworkClient::testSuccessCallback() {
     bool callbackExecuted = false;
     int callCount = 0;
 
-    auto onSuccess = [&callbackExecuted, &callCount](const QNetworkReply&) {
+    auto onSuccess = [&callbackExecuted, &callCount](const NetworkResponse&) {
         callbackExecuted = true;
         callCount++;
     };
-    auto onError = [](const QNetworkReply&) {};
+    auto onError = [](const NetworkResponse&) {};
+
+    TestServer server(okReply);
+    QVERIFY(server.listen());
 
-    QUrl endpoint("http://httpbin.org/get");
+    QUrl endpoint = server.url().resolved(QUrl("/get"));
     m_client->get(endpoint, onSuccess, onError);
-    QTest::qWait(3000);
+    QTRY_COMPARE_WITH_TIMEOUT(callCount, 1, 3000);
+    QTest::qWait(100);
     QCOMPARE(callCount, 1);
+    QVERIFY(callbackExecuted);
 }
 
 void TestNetworkClient::testErrorCallback() {
     QVERIFY(m_client != nullptr);
 
-    bool errorCallbackExecuted = false;
-    int errorCallCount = 0;
+    const QByteArray body = R"({"error":{"code":"ANIMAL_NOT_FOUND","message":"Animal not found"}})";
+    TestServer server([&body](const QByteArray&) { return TestServer::reply("404 Not Found", {}, body); });
+    QVERIFY(server.listen());
 
-    auto onSuccess = [](const QNetworkReply&) { QFAIL("Success callback should not be called on error"); };
-    auto onError = [&errorCallbackExecuted, &errorCallCount](const QNetworkReply&) {
-        errorCallbackExecuted = true;
-        errorCallCount++;
-    };
-
-    QUrl endpoint("http://this-domain-definitely-does-not-exist-12345.test/api/test");
-    m_client->get(endpoint, onSuccess, onError);
+    QList<NetworkResponse> errors;
+    auto onSuccess = [](const NetworkResponse&) { QFAIL("Success callback should not be called on error"); };
+    auto onError = [&errors](const NetworkResponse& response) { errors << response; };
 
-    QTest::qWait(6000);
+    m_client->get(server.url().resolved(QUrl("/api/test")), onSuccess, onError);
 
-    QVERIFY(errorCallbackExecuted || errorCallCount > 0);
+    QTRY_COMPARE_WITH_TIMEOUT(errors.size(), 1, 2000);
+    QCOMPARE(errors.first().statusCode, 404);
+    QCOMPARE(errors.first().body, body);
+    // Not retryable: the server saw the request once.
+    QCOMPARE(server.requests().size(), 1);
 }
 
 void TestNetworkClient::testUnauthorizedAccessSignal() {
     QVERIFY(m_client != nullptr);
 
-    QSignalSpy unauthorizedSpy(m_client, &NetworkClient::unauthorizedAccess);
+    TestServer server([](const QByteArray&) { return tokenExpiredReply(); });
+    QVERIFY(server.listen());
+    m_client->setBaseUrl(server.url());
 
-    auto onSuccess = [](const QNetworkReply&) {};
-    auto onError = [](const QNetworkReply&) {};
-    QUrl endpoint("http://example.com/api/protected");
-    m_client->get(endpoint, onSuccess, onError);
+    QSignalSpy unauthorizedSpy(m_client, &NetworkClient::unauthorizedAccess);
 
-    QTest::qWait(100);
+    int callbackCount = 0;
+    auto onCallback = [&callbackCount](const NetworkResponse&) { callbackCount++; };
+    m_client->get(QUrl("/api/protected"), onCallback, onCallback);
+    m_client->get(QUrl("/api/other"), onCallback, onCallback);
 
-    QVERIFY(unauthorizedSpy.isValid());
+    QTRY_COMPARE_WITH_TIMEOUT(server.requests().size(), 2, 2000);
+    QTRY_COMPARE_WITH_TIMEOUT(unauthorizedSpy.count(), 1, 2000);
+    // Both requests wait for the refresh instead of failing, and the refresh is asked for once.
+    QCOMPARE(callbackCount, 0);
 }
 
 void TestNetworkClient::testPendingRequestsRetry() {
     QVERIFY(m_client != nullptr);
 
-    int successCount = 0;
-    auto onSuccess = [&successCount](const QNetworkReply&) { successCount++; };
-    auto onError = [](const QNetworkReply&) {};
+    // The first answer reports an expired token; the replay after the refresh succeeds.
+    int served = 0;
+    TestServer server([&served](const QByteArray&) {
+        return served++ == 0 ? tokenExpiredReply() : TestServer::reply("200 OK", {}, "{}");
+    });
+    QVERIFY(server.listen());
+    m_client->setBaseUrl(server.url());
 
-    QUrl endpoint("http://example.com/api/test");
-    m_client->get(endpoint, onSuccess, onError);
+    QSignalSpy unauthorizedSpy(m_client, &NetworkClient::unauthorizedAccess);
 
-    QTest::qWait(100);
+    int successCount = 0;
+    auto onSuccess = [&successCount](const NetworkResponse&) { successCount++; };
+    auto onError = [](const NetworkResponse& response) { QFAIL(qPrintable(response.errorString)); };
+
+    m_client->get(QUrl("/api/test"), onSuccess, onError);
+    QTRY_COMPARE_WITH_TIMEOUT(unauthorizedSpy.count(), 1, 2000);
+    QCOMPARE(successCount, 0);
 
     m_client->retryPendingRequests();
 
-    QTest::qWait(100);
+    QTRY_COMPARE_WITH_TIMEOUT(successCount, 1, 2000);
+    QCOMPARE(server.requests().size(), 2);
+}
+
+void TestNetworkClient::testDuplicateGetsShareReply() {
+    QVERIFY(m_client != nullptr);
+
+    TestServer server([](const QByteArray&) { return TestServer::reply("200 OK", {}, R"([{"id":1}])"); });
+    QVERIFY(server.listen());
+    m_client->setBaseUrl(server.url());
+
+    QList<QByteArray> bodies;
+    auto onSuccess = [&bodies](const NetworkResponse& response) { bodies << response.body; };
+    auto onError = [](const NetworkResponse& response) { QFAIL(qPrintable(response.errorString)); };
+
+    m_client->get(QUrl("/breeds?type=dog"), onSuccess, onError);
+    m_client->get(QUrl("/breeds?type=dog"), onSuccess, onError);
+
+    QTRY_COMPARE_WITH_TIMEOUT(bodies.size(), 2, 2000);
+    QCOMPARE(bodies.at(0), bodies.at(1));
+    QCOMPARE(server.requests().size(), 1);
+
+    // Once the shared reply has been delivered, the same GET goes out again.
+    m_client->get(QUrl("/breeds?type=dog"), onSuccess, onError);
+    QTRY_COMPARE_WITH_TIMEOUT(bodies.size(), 3, 2000);
+    QCOMPARE(server.requests().size(), 2);
+}
+
+void TestNetworkClient::testSchedulerPrefersInteractive() {
+    RequestScheduler scheduler;
+    scheduler.setSharedLimit(1);
+
+    QStringList started;
+    scheduler.enqueue(RequestPriority::Background, [&started]() { started << "background-1"; });
+    scheduler.enqueue(RequestPriority::Background, [&started]() { started << "background-2"; });
+    scheduler.enqueue(RequestPriority::Visible, [&started]() { started << "visible"; });
+    scheduler.enqueue(RequestPriority::Interactive, [&started]() { started << "interactive"; });
+
+    QCOMPARE(started, QStringList({"background-1", "interactive"}));
+
+    scheduler.release(RequestPriority::Background);
+    QCOMPARE(started, QStringList({"background-1", "interactive", "visible"}));
+    QCOMPARE(scheduler.queued(RequestPriority::Background), 1);
+}
+
+void TestNetworkClient::testSupersededRequestIsDropped() {
+    QVERIFY(m_client != nullptr);
+
+    TestServer server(okReply);
+    QVERIFY(server.listen());
+    m_client->setBaseUrl(server.url());
+
+    QStringList answered;
+    auto onError = [](const NetworkResponse& response) { QFAIL(qPrintable(response.errorString)); };
+    RequestOptions options;
+    options.supersedeKey = "search";
+
+    m_client->get(QUrl("/orgs?name=a"), [&answered](const NetworkResponse&) { answered << "a"; }, onError, options);
+    m_client->get(QUrl("/orgs?name=ab"), [&answered](const NetworkResponse&) { answered << "ab"; }, onError, options);
+
+    // The first request is abandoned before the event loop runs, so its reply can never reach the callback.
+    QTRY_COMPARE_WITH_TIMEOUT(answered, QStringList({"ab"}), 2000);
+}
+
+void TestNetworkClient::testRetryBackoffIsCappedAndJittered() {
+    RetryPolicy policy;
+    policy.baseDelayMs = 100;
+    policy.maxDelayMs = 1000;
+
+    for (int i = 0; i < 50; ++i) {
+        const int first = RetryLimiter::backoffDelay(policy, 1);
+        QVERIFY(first >= 50 && first <= 100);
+        const int capped = RetryLimiter::backoffDelay(policy, 10);
+        QVERIFY(capped >= 500 && capped <= 1000);
+    }
+}
+
+void TestNetworkClient::testRetryLimiterThrottlesEndpoint() {
+    RetryLimiter limiter;
+    limiter.setEndpointBucket(2, 0);
+
+    QVERIFY(limiter.tryAcquire("http://localhost:8080/animals"));
+    QVERIFY(limiter.tryAcquire("http://localhost:8080/animals"));
+    QVERIFY(!limiter.tryAcquire("http://localhost:8080/animals"));
+    QVERIFY(limiter.tryAcquire("http://localhost:8080/breeds"));
+
+    limiter.setBudget(0, 1);
+    QVERIFY(!limiter.tryAcquire("http://localhost:8080/cities"));
+}
+
+void TestNetworkClient::testPrewarmOpensConnection() {
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    m_client->setBaseUrl(QUrl(QString("http://127.0.0.1:%1/").arg(server.serverPort())));
+    m_client->prewarm();
+
+    QTRY_VERIFY_WITH_TIMEOUT(server.hasPendingConnections(), 2000);
+}
+
+void TestNetworkClient::testLargeBodyIsDeflatedWhenServerAccepts() {
+    // Advertises deflate request bodies on every response.
+    TestServer server([](const QByteArray&) {
+        return TestServer::reply("200 OK", "Accept-Encoding: deflate\r\n", "{}");
+    });
+    QVERIFY(server.listen());
+
+    m_client->setBaseUrl(server.url());
+    int successCount = 0;
+    auto onSuccess = [&successCount](const NetworkResponse&) { successCount++; };
+    auto onError = [](const NetworkResponse& response) { QFAIL(qPrintable(response.errorString)); };
+
+    m_client->get(QUrl("/cities"), onSuccess, onError);
+    QTRY_COMPARE_WITH_TIMEOUT(successCount, 1, 2000);
+
+    const QByteArray description(8192, 'a');
+    m_client->post(QUrl("/animals"), R"({"description":")" + description + R"("})", onSuccess, onError);
+    QTRY_COMPARE_WITH_TIMEOUT(successCount, 2, 2000);
+
+    QCOMPARE(server.requests().size(), 2);
+    QVERIFY(server.requests().at(1).toLower().contains("content-encoding: deflate"));
+    const auto stats = m_client->transferStats().value("/animals");
+    QVERIFY(stats.bytesSent < stats.bytesSentRaw);
+    QCOMPARE(stats.bytesReceived, 2U);
+}
+
+void TestNetworkClient::testTimeoutFollowsLatencyPercentile() {
+    LatencyTracker tracker;
+    TimeoutPolicy policy;
+    policy.floorMs = 100;
+
+    QCOMPARE(tracker.timeoutFor("/cities", policy), policy.defaultMs);
+
+    for (int i = 0; i < 100; ++i) {
+        tracker.record("/cities", 40);
+    }
+    QCOMPARE(tracker.histogram("/cities").samples, 100);
+    QCOMPARE(tracker.percentile("/cities", 0.99), 50);
+    QCOMPARE(tracker.timeoutFor("/cities", policy), 150);
+
+    policy.floorMs = 1000;
+    QCOMPARE(tracker.timeoutFor("/cities", policy), 1000);
+
+    for (int i = 0; i < LatencyTracker::windowSize; ++i) {
+        tracker.record("/cities", 20000);
+    }
+    QCOMPARE(tracker.histogram("/cities").samples, LatencyTracker::windowSize);
+    QCOMPARE(tracker.timeoutFor("/cities", policy), policy.ceilingMs);
+}
+
+void TestNetworkClient::testHeldQueueIsBoundedAndDeduplicated() {
+    QStringList failures;
+    auto onSuccess = [](const NetworkResponse&) {};
+    auto onError = [&failures](const NetworkResponse& response) { failures << response.errorString; };
+
+    m_client->holdRequests();
+    for (int i = 0; i < 10; ++i) {
+        m_client->get(QUrl("/animals/filters"), onSuccess, onError);
+    }
+    for (int i = 0; i < 70; ++i) {
+        m_client->get(QUrl(QString("/animals/%1").arg(i)), onSuccess, onError);
+    }
+
+    // 71 distinct entries against a bound of 64: the seven oldest fail, starting with the shared filters GET.
+    QCOMPARE(failures.size(), 10 + 6);
+    QVERIFY(failures.first().contains("Too many requests"));
+
+    // Ending the session fails what is still held instead of dropping it silently.
+    m_client->clearPendingRequests();
+    QCOMPARE(failures.size(), 10 + 70);
+    QCOMPARE(failures.last(), QString("Session ended"));
+}
+
+void TestNetworkClient::testTimelineKeepsMostRecentTimings() {
+    RequestTimeline timeline(3);
+    for (quint64 id = 1; id <= 5; ++id) {
+        RequestTiming timing;
+        timing.id = id;
+        timing.queueMs = static_cast<double>(id) * 100;
+        timeline.append(timing);
+    }
+
+    const QList<RequestTiming> entries = timeline.entries();
+    QCOMPARE(entries.size(), 3);
+    QCOMPARE(entries.first().id, 3U);
+    QCOMPARE(entries.last().id, 5U);
+    QCOMPARE(timeline.slowerThan(400).size(), 2);
+
+    const QJsonObject dump = timeline.toJson(450);
+    QCOMPARE(dump["requests"].toArray().size(), 3);
+    QCOMPARE(dump["slow"].toArray().size(), 1);
+
+    // Parsing through the response books its time to the shared timing.
+    NetworkResponse response;
+    response.body = R"({"id":1})";
+    response.timing = QSharedPointer<RequestTiming>::create();
+    QVERIFY(response.parseJson().isObject());
+    QVERIFY(response.timing->parseMs >= 0);
+}
+
+void TestNetworkClient::testCacheRevalidatesAndIsClearedForNewUser() {
+    TestServer server([](const QByteArray& request) {
+        const QByteArray headers = "ETag: \"v1\"\r\nCache-Control: max-age=0\r\nContent-Type: application/json\r\n";
+        if (request.toLower().contains("if-none-match: \"v1\"")) {
+            return TestServer::reply("304 Not Modified", headers, {});
+        }
+        return TestServer::reply("200 OK", headers, "{\"name\":\"Rex\"}");
+    });
+    QVERIFY(server.listen());
+    m_client->setBaseUrl(server.url());
+    m_client->setUserId(1);
+
+    QList<NetworkResponse> responses;
+    const auto fetch = [&]() {
+        const qsizetype before = responses.size();
+        m_client->get(
+            QUrl("/animals/1"),
+            [&](const NetworkResponse& response) { responses.append(response); },
+            [](const NetworkResponse&) { QFAIL("request failed"); }
+        );
+        QTRY_COMPARE(responses.size(), before + 1);
+    };
+
+    fetch();
+    QCOMPARE(server.requests().size(), 1);
+    QVERIFY(!server.requests().last().toLower().contains("if-none-match"));
+
+    // The stale entry is revalidated; the 304 reaches the caller as the stored body.
+    fetch();
+    QCOMPARE(server.requests().size(), 2);
+    QVERIFY(server.requests().last().toLower().contains("if-none-match: \"v1\""));
+    QCOMPARE(responses.last().statusCode, 200);
+    QCOMPARE(responses.last().body, QByteArray("{\"name\":\"Rex\"}"));
+
+    // Another identity starts from an empty cache, so nothing of the previous user is revalidated or replayed.
+    m_client->setUserId(2);
+    fetch();
+    QCOMPARE(server.requests().size(), 3);
+    QVERIFY(!server.requests().last().toLower().contains("if-none-match"));
+}
+
+void TestNetworkClient::testCachedResponseIsNotALatencySample() {
+    TestServer server([](const QByteArray&) {
+        return TestServer::reply("200 OK", "Cache-Control: max-age=60\r\nContent-Type: application/json\r\n", "{}");
+    });
+    QVERIFY(server.listen());
+    m_client->setBaseUrl(server.url());
+
+    QList<NetworkResponse> responses;
+    const auto fetch = [&]() {
+        const qsizetype before = responses.size();
+        m_client->get(
+            QUrl("/cities"),
+            [&](const NetworkResponse& response) { responses.append(response); },
+            [](const NetworkResponse&) { QFAIL("request failed"); }
+        );
+        QTRY_COMPARE(responses.size(), before + 1);
+    };
+
+    fetch();
+    fetch();
+    // The second answer came from the disk cache and is left out of the histogram the timeout is derived from.
+    QCOMPARE(server.requests().size(), 1);
+    QCOMPARE(m_client->latency().endpoints().size(), 1);
+    QCOMPARE(m_client->latency().histogram(m_client->latency().endpoints().first()).samples, 1);
 }
 
 QTEST_MAIN(TestNetworkClient)
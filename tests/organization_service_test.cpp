@@ -1,7 +1,8 @@
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
-#include <QNetworkReply>
 #include <QSharedPointer>
+#include <QUrlQuery>
 #include <QtTest>
 
 #include "models/organization_dto.hpp"
@@ -14,33 +15,6 @@
 using namespace pawspective::models;   // NOLINT google-build-using-namespace
 using namespace pawspective::services; // NOLINT google-build-using-namespace
 
-// ---------------------------------------------------------------------------
-// Fake QNetworkReply that serves pre-baked data
-
-class FakeNetworkReply : public QNetworkReply {
-    Q_OBJECT
-public:
-    explicit FakeNetworkReply(const QByteArray& data, QObject* parent = nullptr)
-        : QNetworkReply(parent), m_data(data) {
-        open(QIODevice::ReadOnly);
-    }
-    void abort() override {}
-    qint64 bytesAvailable() const override { return m_data.size() - m_pos; }
-    bool isSequential() const override { return true; }
-
-protected:
-    qint64 readData(char* data, qint64 maxSize) override {
-        qint64 n = qMin(maxSize, static_cast<qint64>(m_data.size() - m_pos));
-        memcpy(data, m_data.constData() + m_pos, static_cast<size_t>(n));
-        m_pos += n;
-        return n;
-    }
-
-private:
-    QByteArray m_data;
-    qint64 m_pos = 0;
-};
-
 // ---------------------------------------------------------------------------
 // MockNetworkClient — captures callbacks; lets tests trigger them manually
 
@@ -53,31 +27,46 @@ public:
         QByteArray body;
         CallbackHandler onSuccess;
         CallbackHandler onError;
+        RequestOptions options;
     };
 
     QList<Call> getCalls;
     QList<Call> postCalls;
     QList<Call> putCalls;
 
-    void get(const QUrl& url, CallbackHandler ok, CallbackHandler err) override {
-        getCalls.append({url, {}, ok, err});
+    void get(const QUrl& url, CallbackHandler ok, CallbackHandler err, const RequestOptions& options) override {
+        getCalls.append({url, {}, ok, err, options});
     }
-    void post(const QUrl& url, const QByteArray& data, CallbackHandler ok, CallbackHandler err) override {
-        postCalls.append({url, data, ok, err});
+    void post(
+        const QUrl& url,
+        const QByteArray& data,
+        CallbackHandler ok,
+        CallbackHandler err,
+        const RequestOptions& options
+    ) override {
+        postCalls.append({url, data, ok, err, options});
     }
-    void put(const QUrl& url, const QByteArray& data, CallbackHandler ok, CallbackHandler err) override {
-        putCalls.append({url, data, ok, err});
+    void put(
+        const QUrl& url,
+        const QByteArray& data,
+        CallbackHandler ok,
+        CallbackHandler err,
+        const RequestOptions& options
+    ) override {
+        putCalls.append({url, data, ok, err, options});
     }
-    void patch(const QUrl&, const QByteArray&, CallbackHandler, CallbackHandler) override {}
-    void deleteResource(const QUrl&, CallbackHandler, CallbackHandler) override {}
+    void patch(const QUrl&, const QByteArray&, CallbackHandler, CallbackHandler, const RequestOptions&) override {}
+    void deleteResource(const QUrl&, CallbackHandler, CallbackHandler, const RequestOptions&) override {}
 
     void triggerSuccess(QList<Call>& calls, const QByteArray& data, int idx = 0) {
-        FakeNetworkReply reply(data);
-        calls[idx].onSuccess(reply);
+        NetworkResponse response;
+        response.body = data;
+        calls[idx].onSuccess(response);
     }
     void triggerError(QList<Call>& calls, const QByteArray& data, int idx = 0) {
-        FakeNetworkReply reply(data);
-        calls[idx].onError(reply);
+        NetworkResponse response;
+        response.body = data;
+        calls[idx].onError(response);
     }
 };
 
@@ -146,6 +135,8 @@ private slots:
     void testGetOrganization_NetworkError_EmitsGetOrganizationFailed();
     void testGetOrganization_InvalidJson_EmitsGetOrganizationFailed();
     void testGetOrganization_ServerError_DoesNotEmitOtherFailedSignals();
+    void testGetOrganization_Batching_CoalescesIntoOneRequest();
+    void testGetOrganization_Batching_FallsBackToBoundedSingleGets();
 
     void testCreateOrganization_Success_EmitsCreateOrganizationSuccess();
     void testCreateOrganization_NetworkError_EmitsCreateOrganizationFailed();
@@ -288,7 +279,7 @@ void TestOrganizationService::testGetOrganization_Success_EmitsGetOrganizationSu
     QCOMPARE(successSpy.count(), 1);
     QCOMPARE(failedSpy.count(), 0);
 
-    auto org = qvariant_cast<OrganizationDTO>(successSpy.at(0).at(0));
+    auto org = *qvariant_cast<SharedOrganization>(successSpy.at(0).at(0));
     QCOMPARE(org.id, static_cast<qint64>(1));
     QCOMPARE(org.name, QString("Test Org"));
 }
@@ -337,6 +328,71 @@ void TestOrganizationService::testGetOrganization_ServerError_DoesNotEmitOtherFa
     QCOMPARE(updateFailed.count(), 0);
 }
 
+void TestOrganizationService::testGetOrganization_Batching_CoalescesIntoOneRequest() {
+    MockNetworkClient mock;
+    OrganizationService service(mock);
+    service.setBatchingEnabled(true);
+
+    QSignalSpy successSpy(&service, &OrganizationService::getOrganizationSuccess);
+    QSignalSpy failedSpy(&service, &OrganizationService::getOrganizationFailed);
+
+    service.getOrganization(1);
+    service.getOrganization(2);
+    service.getOrganization(1);
+    service.getOrganization(3);
+    QCOMPARE(mock.getCalls.size(), 0);
+
+    QCoreApplication::processEvents();
+    QCOMPARE(mock.getCalls.size(), 1);
+    QCOMPARE(mock.getCalls[0].endpoint.path(), QString("/orgs"));
+    QCOMPARE(QUrlQuery(mock.getCalls[0].endpoint).queryItemValue("ids"), QString("1,2,3"));
+
+    QJsonArray orgs;
+    orgs.append(QJsonDocument::fromJson(validOrgJson(1, "First")).object());
+    orgs.append(QJsonDocument::fromJson(validOrgJson(2, "Second")).object());
+    mock.triggerSuccess(mock.getCalls, QJsonDocument(orgs).toJson(QJsonDocument::Compact));
+
+    QCOMPARE(successSpy.count(), 2);
+    QCOMPARE(qvariant_cast<SharedOrganization>(successSpy.at(1).at(0))->name, QString("Second"));
+    // Organization 3 was not in the answer.
+    QCOMPARE(failedSpy.count(), 1);
+}
+
+void TestOrganizationService::testGetOrganization_Batching_FallsBackToBoundedSingleGets() {
+    MockNetworkClient mock;
+    OrganizationService service(mock);
+    service.setBatchingEnabled(true);
+
+    QSignalSpy successSpy(&service, &OrganizationService::getOrganizationSuccess);
+
+    for (qint64 id = 1; id <= 6; ++id) {
+        service.getOrganization(id);
+    }
+    QCoreApplication::processEvents();
+    QCOMPARE(mock.getCalls.size(), 1);
+
+    NetworkResponse notFound;
+    notFound.statusCode = 404;
+    mock.getCalls[0].onError(notFound);
+
+    // At most four single lookups are in flight; each answer lets the next one start.
+    QCOMPARE(mock.getCalls.size(), 5);
+    QCOMPARE(mock.getCalls[1].endpoint, QUrl("/orgs/1"));
+    mock.triggerSuccess(mock.getCalls, validOrgJson(1), 1);
+    QCOMPARE(mock.getCalls.size(), 6);
+    QCOMPARE(mock.getCalls[5].endpoint, QUrl("/orgs/5"));
+    QCOMPARE(successSpy.count(), 1);
+
+    // The next turn goes straight to single lookups.
+    service.getOrganization(7);
+    service.getOrganization(8);
+    QCoreApplication::processEvents();
+    for (int i = 2; i <= 5; ++i) {
+        mock.triggerSuccess(mock.getCalls, validOrgJson(i), i);
+    }
+    QCOMPARE(mock.getCalls.last().endpoint, QUrl("/orgs/8"));
+}
+
 // ---------------------------------------------------------------------------
 // createOrganization signal tests
 
@@ -359,7 +415,7 @@ void TestOrganizationService::testCreateOrganization_Success_EmitsCreateOrganiza
     QCOMPARE(successSpy.count(), 1);
     QCOMPARE(failedSpy.count(), 0);
 
-    auto org = qvariant_cast<OrganizationDTO>(successSpy.at(0).at(0));
+    auto org = *qvariant_cast<SharedOrganization>(successSpy.at(0).at(0));
     QCOMPARE(org.id, static_cast<qint64>(42));
     QCOMPARE(org.name, QString("New Org"));
 }
@@ -441,7 +497,7 @@ void TestOrganizationService::testUpdateOrganization_Success_EmitsUpdateOrganiza
     QCOMPARE(successSpy.count(), 1);
     QCOMPARE(failedSpy.count(), 0);
 
-    auto org = qvariant_cast<OrganizationDTO>(successSpy.at(0).at(0));
+    auto org = *qvariant_cast<SharedOrganization>(successSpy.at(0).at(0));
     QCOMPARE(org.id, static_cast<qint64>(7));
     QCOMPARE(org.name, QString("Updated Name"));
 }
@@ -562,7 +618,7 @@ void TestOrganizationService::testFindByNameContaining_Success_PaginationFieldsA
     mock.triggerSuccess(mock.getCalls, validOrgListJson(2, 20, 35, 2));
 
     QCOMPARE(successSpy.count(), 1);
-    auto result = qvariant_cast<OrganizationListDTO>(successSpy.at(0).at(0));
+    auto result = *qvariant_cast<SharedOrganizationList>(successSpy.at(0).at(0));
     QCOMPARE(result.page, 2);
     QCOMPARE(result.limit, 20);
     QCOMPARE(result.totalCount, static_cast<qint64>(35));